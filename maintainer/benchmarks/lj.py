@@ -33,6 +33,11 @@ parser.add_argument("--volume_fraction", metavar="FRAC", action="store",
                     "particles (range: [0.01-0.74], default: 0.50)")
 parser.add_argument("--bonds", action="store_true",
                     help="Add bonds between particle pairs, default: false")
+parser.add_argument("--space_filling_curve", action="store", type=str,
+                    choices=["none", "morton", "hilbert"], default="none",
+                    required=False,
+                    help="Order cells and particles along a space-filling "
+                    "curve (default: none)")
 group = parser.add_mutually_exclusive_group()
 group.add_argument("--output", metavar="FILEPATH", action="store",
                    type=str, required=False, default="benchmarks.csv",
@@ -94,6 +99,8 @@ system.random_number_generator_state = list(range(
 #############################################################
 system.time_step = 0.01
 system.cell_system.skin = 0.5
+system.cell_system.set_domain_decomposition(
+    space_filling_curve=args.space_filling_curve)
 system.thermostat.turn_off()
 
 
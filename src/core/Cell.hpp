@@ -19,6 +19,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef CORE_CELL_HPP
 #define CORE_CELL_HPP
 
+#include "ParticleSoA.hpp"
+#include "algorithm/cluster_pair_ia.hpp"
 #include "particle_data.hpp"
 
 #include <utils/Span.hpp>
@@ -102,6 +104,17 @@ public:
   /** Interaction pairs */
   std::vector<std::pair<Particle *, Particle *>> m_verlet_list;
 
+  /** Interacting cluster pairs, alternative to @ref m_verlet_list */
+  std::vector<Algorithm::ClusterPair> m_cluster_pairs;
+
+  /** The pair list of this cell is outdated and has to be rebuilt
+   *  in the next pair loop, even if the other lists are still valid.
+   */
+  bool m_rebuild_verlet_list = false;
+
+  /** Packed copy of the particles for the vectorized pair kernels */
+  ParticleSoA m_soa;
+
   /**
    * @brief All neighbors of the cell.
    */
@@ -0,0 +1,91 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CORE_PARTICLE_SOA_HPP
+#define CORE_PARTICLE_SOA_HPP
+
+#include "particle_data.hpp"
+
+#include <vector>
+
+/**
+ * @brief Structure-of-arrays copy of the particles of a cell.
+ *
+ * Holds the data needed by the vectorized pair kernels in contiguous
+ * arrays, and accumulates the pair forces, which are added to the
+ * particles afterwards by @ref add_forces.
+ */
+struct ParticleSoA {
+  std::vector<double> x, y, z;
+  std::vector<int> type;
+#ifdef ELECTROSTATICS
+  std::vector<double> q;
+#endif
+  std::vector<double> fx, fy, fz;
+
+  int size() const { return static_cast<int>(type.size()); }
+
+  /**
+   * @brief Copy the data of the particles and reset the forces.
+   */
+  void update(ParticleList const &pl) {
+    resize(pl.n);
+
+    for (int i = 0; i < pl.n; i++) {
+      auto const &p = pl.part[i];
+      x[i] = p.r.p[0];
+      y[i] = p.r.p[1];
+      z[i] = p.r.p[2];
+      type[i] = p.p.type;
+#ifdef ELECTROSTATICS
+      q[i] = p.p.q;
+#endif
+      fx[i] = fy[i] = fz[i] = 0.;
+    }
+  }
+
+  /**
+   * @brief Add the accumulated forces to the particles.
+   *
+   * The particles have to be the ones the copy was made from.
+   */
+  void add_forces(ParticleList &pl) const {
+    for (int i = 0; i < pl.n; i++) {
+      auto &f = pl.part[i].f.f;
+      f[0] += fx[i];
+      f[1] += fy[i];
+      f[2] += fz[i];
+    }
+  }
+
+private:
+  void resize(int n) {
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+    type.resize(n);
+#ifdef ELECTROSTATICS
+    q.resize(n);
+#endif
+    fx.resize(n);
+    fy.resize(n);
+    fz.resize(n);
+  }
+};
+
+#endif
@@ -17,6 +17,7 @@
  along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "Correlator.hpp"
+#include "cells.hpp"
 #include "integrate.hpp"
 
 #include <utils/serialization/multi_array.hpp>
@@ -28,138 +29,84 @@
 #include <boost/serialization/string.hpp>
 #include <boost/serialization/vector.hpp>
 
+#include <algorithm>
 #include <limits>
-
-namespace {
-int min(int i, unsigned int j) { return std::min(i, static_cast<int>(j)); }
-} // namespace
+#include <numeric>
 
 namespace Accumulators {
-/** The minimal version of compression function */
-std::vector<double> compress_do_nothing(std::vector<double> const &A1,
-                                        std::vector<double> const &A2) {
-  return {};
-}
-
 /** Compress computing arithmetic mean: A_compressed=(A1+A2)/2 */
-std::vector<double> compress_linear(std::vector<double> const &A1,
-                                    std::vector<double> const &A2) {
-  assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A1.size());
-
-  std::transform(A1.begin(), A1.end(), A2.begin(), A_compressed.begin(),
-                 [](double a, double b) -> double { return 0.5 * (a + b); });
-
-  return A_compressed;
+void compress_linear(double const *A1, double const *A2, double *A_compressed,
+                     unsigned dim) {
+#pragma omp simd
+  for (unsigned k = 0; k < dim; k++) {
+    A_compressed[k] = 0.5 * (A1[k] + A2[k]);
+  }
 }
 
 /** Compress discarding the 1st argument and return the 2nd */
-std::vector<double> compress_discard1(std::vector<double> const &A1,
-                                      std::vector<double> const &A2) {
-  assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A2);
-  return A_compressed;
+void compress_discard1(double const *, double const *A2, double *A_compressed,
+                       unsigned dim) {
+  std::copy_n(A2, dim, A_compressed);
 }
 
 /** Compress discarding the 2nd argument and return the 1st */
-std::vector<double> compress_discard2(std::vector<double> const &A1,
-                                      std::vector<double> const &A2) {
-  assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A1);
-  return A_compressed;
+void compress_discard2(double const *A1, double const *, double *A_compressed,
+                       unsigned dim) {
+  std::copy_n(A1, dim, A_compressed);
 }
 
-std::vector<double> scalar_product(std::vector<double> const &A,
-                                   std::vector<double> const &B,
-                                   Utils::Vector3d) {
-  if (A.size() != B.size()) {
-    throw std::runtime_error(
-        "Error in scalar product: The vector sizes do not match");
-  }
+/* The correlation operations add their result to C, the dimensions have
+ * been checked in Correlator::initialize(). */
 
-  return std::vector<double>(
-      1, std::inner_product(A.begin(), A.end(), B.begin(), 0.0));
+void scalar_product(double const *A, double const *B, double *C, unsigned dim_A,
+                    unsigned, Utils::Vector3d) {
+  C[0] += std::inner_product(A, A + dim_A, B, 0.0);
 }
 
-std::vector<double> componentwise_product(std::vector<double> const &A,
-                                          std::vector<double> const &B,
-                                          Utils::Vector3d) {
-  std::vector<double> C(A.size());
-  if (!(A.size() == B.size())) {
-    throw std::runtime_error(
-        "Error in componentwise product: The vector sizes do not match");
+void componentwise_product(double const *A, double const *B, double *C,
+                           unsigned dim_A, unsigned, Utils::Vector3d) {
+#pragma omp simd
+  for (unsigned k = 0; k < dim_A; k++) {
+    C[k] += A[k] * B[k];
   }
-
-  std::transform(A.begin(), A.end(), B.begin(), C.begin(), std::multiplies<>());
-
-  return C;
 }
 
-std::vector<double> tensor_product(std::vector<double> const &A,
-                                   std::vector<double> const &B,
-                                   Utils::Vector3d) {
-  std::vector<double> C(A.size() * B.size());
-  auto C_it = C.begin();
-
-  for (auto A_it = A.begin(); A_it != A.begin(); ++A_it) {
-    for (double B_it : B) {
-      *(C_it++) = *A_it * B_it;
+void tensor_product(double const *A, double const *B, double *C,
+                    unsigned dim_A, unsigned dim_B, Utils::Vector3d) {
+  for (unsigned i = 0; i < dim_A; i++) {
+    auto const a = A[i];
+    auto C_i = C + i * dim_B;
+#pragma omp simd
+    for (unsigned j = 0; j < dim_B; j++) {
+      C_i[j] += a * B[j];
     }
   }
-  assert(C_it == C.end());
-
-  return C;
 }
 
-std::vector<double> square_distance_componentwise(std::vector<double> const &A,
-                                                  std::vector<double> const &B,
-                                                  Utils::Vector3d) {
-  if (!(A.size() == B.size())) {
-    throw std::runtime_error(
-        "Error in square distance componentwise: The vector sizes do not "
-        "match.");
+void square_distance_componentwise(double const *A, double const *B, double *C,
+                                   unsigned dim_A, unsigned, Utils::Vector3d) {
+#pragma omp simd
+  for (unsigned k = 0; k < dim_A; k++) {
+    C[k] += (A[k] - B[k]) * (A[k] - B[k]);
   }
-
-  std::vector<double> C(A.size());
-
-  std::transform(
-      A.begin(), A.end(), B.begin(), C.begin(),
-      [](double a, double b) -> double { return (a - b) * (a - b); });
-
-  return C;
 }
 
 // note: the argument name wsquare denotes that it value is w^2 while the user
 // sets w
-std::vector<double> fcs_acf(std::vector<double> const &A,
-                            std::vector<double> const &B,
-                            Utils::Vector3d wsquare) {
-  if (!(A.size() == B.size())) {
-    throw std::runtime_error(
-        "Error in square distance componentwise: The vector sizes do not "
-        "match.");
-  }
-
-  auto const C_size = A.size() / 3;
-  if (3 * C_size != A.size()) {
-    throw std::runtime_error("Invalid dimensions.");
-  }
-
-  std::vector<double> C(C_size, 0);
+void fcs_acf(double const *A, double const *B, double *C, unsigned dim_A,
+             unsigned, Utils::Vector3d wsquare) {
+  auto const C_size = dim_A / 3;
 
   for (unsigned i = 0; i < C_size; i++) {
+    double c = 0;
     for (int j = 0; j < 3; j++) {
       auto const &a = A[3 * i + j];
       auto const &b = B[3 * i + j];
 
-      C[i] -= (a - b) * (a - b) / wsquare[j];
+      c -= (a - b) * (a - b) / wsquare[j];
     }
+    C[i] += std::exp(c);
   }
-
-  std::transform(C.begin(), C.end(), C.begin(),
-                 [](double c) -> double { return std::exp(c); });
-
-  return C;
 }
 
 /* global variables */
@@ -272,6 +219,10 @@ void Correlator::initialize() {
     throw std::runtime_error(init_errors[6]);
   }
 
+  if (dim_A != dim_B && corr_operation_name != "tensor_product") {
+    throw std::runtime_error(init_errors[8]);
+  }
+
   // choose the correlation operation
   if (corr_operation_name.empty()) {
     throw std::runtime_error(init_errors[11]); // there is no reasonable default
@@ -337,10 +288,8 @@ void Correlator::initialize() {
     throw std::runtime_error(init_errors[13]);
   }
 
-  A.resize(std::array<int, 2>{{hierarchy_depth, m_tau_lin + 1}});
-  std::fill_n(A.data(), A.num_elements(), std::vector<double>(dim_A, 0));
-  B.resize(std::array<int, 2>{{hierarchy_depth, m_tau_lin + 1}});
-  std::fill_n(B.data(), B.num_elements(), std::vector<double>(dim_B, 0));
+  A = std::vector<double>(hierarchy_depth * (m_tau_lin + 1) * dim_A, 0);
+  B = std::vector<double>(hierarchy_depth * (m_tau_lin + 1) * dim_B, 0);
 
   n_data = 0;
   A_accumulated_average = std::vector<double>(dim_A, 0);
@@ -372,6 +321,38 @@ void Correlator::initialize() {
     }
 }
 
+void Correlator::compress_level(int level) {
+  // We increase the index indicating the newest on level+1 by one (plus
+  // folding)
+  newest[level + 1] = (newest[level + 1] + 1) % (m_tau_lin + 1);
+  n_vals[level + 1] += 1;
+
+  auto const index_1 = (newest[level] + 1) % (m_tau_lin + 1);
+  auto const index_2 = (newest[level] + 2) % (m_tau_lin + 1);
+  (*compressA)(A_entry(level, index_1), A_entry(level, index_2),
+               A_entry(level + 1, newest[level + 1]), dim_A);
+  (*compressB)(B_entry(level, index_1), B_entry(level, index_2),
+               B_entry(level + 1, newest[level + 1]), dim_B);
+}
+
+void Correlator::correlate_level(int level, int j_min) {
+  auto const j_max = std::min(m_tau_lin + 1, static_cast<int>(n_vals[level]));
+
+  auto const index_new = newest[level];
+  double const *const B_new = B_entry(level, index_new);
+
+  // Every lag has its own row of the result.
+#pragma omp parallel for if (cell_structure.use_threads)
+  for (int j = j_min; j < j_max; j++) {
+    auto const index_old = (index_new - j + m_tau_lin + 1) % (m_tau_lin + 1);
+    auto const index_res = level * m_tau_lin / 2 + j;
+
+    n_sweeps[index_res]++;
+    (*corr_operation)(A_entry(level, index_old), B_new, &result[index_res][0],
+                      dim_A, dim_B, m_correlation_args);
+  }
+}
+
 void Correlator::update() {
   if (finalized) {
     throw std::runtime_error(
@@ -382,9 +363,8 @@ void Correlator::update() {
   // datapoint. For every hierarchy level we have to decide if it necessary to
   // move
   // something
-  int i, j;
+  int i;
   int highest_level_to_compress;
-  unsigned int index_new, index_old, index_res;
 
   t++;
 
@@ -408,68 +388,42 @@ void Correlator::update() {
   // Now lets compress the data level by level.
 
   for (i = highest_level_to_compress; i >= 0; i--) {
-    // We increase the index indicating the newest on level i+1 by one (plus
-    // folding)
-    newest[i + 1] = (newest[i + 1] + 1) % (m_tau_lin + 1);
-    n_vals[i + 1] += 1;
-    A[i + 1][newest[i + 1]] =
-        (*compressA)(A[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     A[i][(newest[i] + 2) % (m_tau_lin + 1)]);
-    B[i + 1][newest[i + 1]] =
-        (*compressB)(B[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     B[i][(newest[i] + 2) % (m_tau_lin + 1)]);
+    compress_level(i);
   }
 
   newest[0] = (newest[0] + 1) % (m_tau_lin + 1);
   n_vals[0]++;
 
-  A[0][newest[0]] = A_obs->operator()();
+  auto const A_new = A_entry(0, newest[0]);
+  auto const B_new = B_entry(0, newest[0]);
+  {
+    auto const values = A_obs->operator()();
+    assert(values.size() == dim_A);
+    std::copy_n(values.begin(), dim_A, A_new);
+  }
   if (A_obs != B_obs) {
-    B[0][newest[0]] = B_obs->operator()();
+    auto const values = B_obs->operator()();
+    assert(values.size() == dim_B);
+    std::copy_n(values.begin(), dim_B, B_new);
   } else {
-    B[0][newest[0]] = A[0][newest[0]];
+    std::copy_n(A_new, dim_A, B_new);
   }
 
   // Now we update the cumulated averages and variances of A and B
   n_data++;
   for (unsigned k = 0; k < dim_A; k++) {
-    A_accumulated_average[k] += A[0][newest[0]][k];
+    A_accumulated_average[k] += A_new[k];
   }
 
   for (unsigned k = 0; k < dim_B; k++) {
-    B_accumulated_average[k] += B[0][newest[0]][k];
+    B_accumulated_average[k] += B_new[k];
   }
 
   // Now update the lowest level correlation estimates
-  for (j = 0; j < min(m_tau_lin + 1, n_vals[0]); j++) {
-    index_new = newest[0];
-    index_old = (newest[0] - j + m_tau_lin + 1) % (m_tau_lin + 1);
-    auto const temp =
-        (corr_operation)(A[0][index_old], B[0][index_new], m_correlation_args);
-    assert(temp.size() == m_dim_corr);
-
-    n_sweeps[j]++;
-    for (unsigned k = 0; k < m_dim_corr; k++) {
-      result[j][k] += temp[k];
-    }
-  }
+  correlate_level(0, 0);
   // Now for the higher ones
-  for (int i = 1; i < highest_level_to_compress + 2; i++) {
-    for (unsigned j = (m_tau_lin + 1) / 2 + 1;
-         j < min(m_tau_lin + 1, n_vals[i]); j++) {
-      index_new = newest[i];
-      index_old = (newest[i] - j + m_tau_lin + 1) % (m_tau_lin + 1);
-      index_res =
-          m_tau_lin + (i - 1) * m_tau_lin / 2 + (j - m_tau_lin / 2 + 1) - 1;
-      auto const temp = (corr_operation)(A[i][index_old], B[i][index_new],
-                                         m_correlation_args);
-      assert(temp.size() == m_dim_corr);
-
-      n_sweeps[index_res]++;
-      for (unsigned k = 0; k < m_dim_corr; k++) {
-        result[index_res][k] += temp[k];
-      }
-    }
+  for (i = 1; i < highest_level_to_compress + 2; i++) {
+    correlate_level(i, (m_tau_lin + 1) / 2 + 1);
   }
 
   m_last_update = sim_time;
@@ -484,11 +438,10 @@ int Correlator::finalize() {
   // datapoint. For every hierarchy level we have to decide if it necessary to
   // move
   // something
-  int i, j;
+  int i;
   int ll;      // current lowest level
   int vals_ll; // number of values remaining in the lowest level
   int highest_level_to_compress;
-  unsigned int index_new, index_old, index_res;
 
   // make a flag that the correlation is finalized
   finalized = 1;
@@ -529,36 +482,13 @@ int Correlator::finalize() {
       // Now lets compress the data level by level.
 
       for (i = highest_level_to_compress; i >= ll; i--) {
-        // We increase the index indicating the newest on level i+1 by one (plus
-        // folding)
-        newest[i + 1] = (newest[i + 1] + 1) % (m_tau_lin + 1);
-        n_vals[i + 1] += 1;
-
-        (*compressA)(A[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     A[i][(newest[i] + 2) % (m_tau_lin + 1)]);
-        (*compressB)(B[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     B[i][(newest[i] + 2) % (m_tau_lin + 1)]);
+        compress_level(i);
       }
       newest[ll] = (newest[ll] + 1) % (m_tau_lin + 1);
 
       // We only need to update correlation estimates for the higher levels
       for (i = ll + 1; i < highest_level_to_compress + 2; i++) {
-        for (j = (m_tau_lin + 1) / 2 + 1; j < min(m_tau_lin + 1, n_vals[i]);
-             j++) {
-          index_new = newest[i];
-          index_old = (newest[i] - j + m_tau_lin + 1) % (m_tau_lin + 1);
-          index_res =
-              m_tau_lin + (i - 1) * m_tau_lin / 2 + (j - m_tau_lin / 2 + 1) - 1;
-
-          auto const temp = (corr_operation)(A[i][index_old], B[i][index_new],
-                                             m_correlation_args);
-          assert(temp.size() == m_dim_corr);
-
-          n_sweeps[index_res]++;
-          for (unsigned k = 0; k < m_dim_corr; k++) {
-            result[index_res][k] += temp[k];
-          }
-        }
+        correlate_level(i, (m_tau_lin + 1) / 2 + 1);
       }
     }
   }
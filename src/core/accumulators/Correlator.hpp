@@ -142,6 +142,11 @@ namespace Accumulators {
  * entry of the hierarchic "past" For every new entry in is incremented and if
  * tau_lin is reached,
  * it starts again from the beginning.
+ *
+ * The rings of all hierarchy levels are stored in one preallocated array
+ * per observable, ordered by level, position in the ring and component.
+ * The correlation operations and the compression work in place on this
+ * storage, so that no memory is allocated in @ref update.
  */
 class Correlator : public AccumulatorBase {
   using obs_ptr = std::shared_ptr<Observables::Observable>;
@@ -272,8 +277,8 @@ private:
   std::shared_ptr<Observables::Observable> B_obs;
 
   std::vector<int> tau; // time differences
-  boost::multi_array<std::vector<double>, 2> A;
-  boost::multi_array<std::vector<double>, 2> B;
+  std::vector<double> A; // rings of all levels, see @ref A_entry
+  std::vector<double> B; // rings of all levels, see @ref B_entry
 
   boost::multi_array<double, 2> result; // output quantity
 
@@ -294,18 +299,39 @@ private:
   unsigned int dim_A; // dimensionality of A
   unsigned int dim_B;
 
-  using correlation_operation_type =
-      std::vector<double> (*)(std::vector<double> const &,
-                              std::vector<double> const &, Utils::Vector3d);
+  /** Adds the correlation of the entries @p A and @p B with
+   *  @p dim_A and @p dim_B components to @p C */
+  using correlation_operation_type = void (*)(double const *A, double const *B,
+                                              double *C, unsigned dim_A,
+                                              unsigned dim_B, Utils::Vector3d);
 
   correlation_operation_type corr_operation;
 
-  using compression_function = std::vector<double> (*)(
-      std::vector<double> const &A1, std::vector<double> const &A2);
+  /** Writes the compression of the entries @p A1 and @p A2 with
+   *  @p dim components to @p A_compressed */
+  using compression_function = void (*)(double const *A1, double const *A2,
+                                        double *A_compressed, unsigned dim);
 
   // compressing functions
   compression_function compressA;
   compression_function compressB;
+
+  /** Entry @p index of the ring of hierarchy level @p level */
+  double *A_entry(int level, unsigned index) {
+    return A.data() + (level * (m_tau_lin + 1) + index) * dim_A;
+  }
+  double *B_entry(int level, unsigned index) {
+    return B.data() + (level * (m_tau_lin + 1) + index) * dim_B;
+  }
+
+  /** Compress the two oldest entries of level @p level into a new entry of
+   *  the next level */
+  void compress_level(int level);
+
+  /** Correlate the newest entry of level @p level with the entries that
+   *  are at least @p j_min positions older, the lag of j positions is
+   *  accumulated in result row level * tau_lin / 2 + j */
+  void correlate_level(int level, int j_min);
 };
 
 } // namespace Accumulators
@@ -0,0 +1,197 @@
+/*
+Copyright (C) 2010-2018 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CORE_ALGORITHM_CLUSTER_PAIR_IA_HPP
+#define CORE_ALGORITHM_CLUSTER_PAIR_IA_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace Algorithm {
+/** Number of consecutive particles of a cell that form a cluster. */
+constexpr int cluster_size = 4;
+
+/**
+ * @brief Pair of particle clusters with at least one interacting pair.
+ *
+ * The first cluster consists of the particles
+ * [cluster_size * i, cluster_size * (i + 1)) of the cell the list
+ * belongs to, the second one of the particles
+ * [cluster_size * j, cluster_size * (j + 1)) of the red neighbor
+ * number @p neighbor of that cell, or of the cell itself. Bit
+ * cluster_size * a + b of @p mask is set if particle a of the first
+ * and particle b of the second cluster interact.
+ *
+ * Compared to a list of particle pairs, this needs 12 instead of
+ * 16 bytes for up to cluster_size^2 pairs.
+ */
+struct ClusterPair {
+  /** Value of @ref neighbor if both clusters are in the same cell. */
+  static constexpr uint16_t same_cell = std::numeric_limits<uint16_t>::max();
+
+  int i;
+  int j;
+  uint16_t mask;
+  uint16_t neighbor;
+};
+
+static_assert(cluster_size * cluster_size <= 16,
+              "The interaction mask has 16 bits.");
+
+namespace detail {
+inline int n_clusters(int n_part) {
+  return (n_part + cluster_size - 1) / cluster_size;
+}
+
+/** Check all particle pairs of two clusters, run the pair kernel for the
+ *  interacting ones and add the cluster pair to the list of @p cell if
+ *  there are any.
+ */
+template <typename Cell, typename PairKernel, typename DistanceFunction,
+          typename VerletCriterion>
+void update_cluster_pair(Cell &cell, int i, Cell &other, int j,
+                         uint16_t neighbor, PairKernel &&pair_kernel,
+                         DistanceFunction &&distance_function,
+                         VerletCriterion &&verlet_criterion) {
+  auto const first_i = i * cluster_size;
+  auto const first_j = j * cluster_size;
+  auto const n_i = std::min(cluster_size, cell.n - first_i);
+  auto const n_j = std::min(cluster_size, other.n - first_j);
+  auto const diagonal = (&cell == &other) && (i == j);
+
+  uint16_t mask = 0;
+  for (int a = 0; a < n_i; a++) {
+    auto &p1 = cell.part[first_i + a];
+
+    for (int b = diagonal ? a + 1 : 0; b < n_j; b++) {
+      auto &p2 = other.part[first_j + b];
+      auto dist = distance_function(p1, p2);
+      if (verlet_criterion(p1, p2, dist)) {
+        pair_kernel(p1, p2, dist);
+        mask |= uint16_t(1u << (a * cluster_size + b));
+      }
+    }
+  }
+
+  if (mask) {
+    cell.m_cluster_pairs.push_back(ClusterPair{i, j, mask, neighbor});
+  }
+}
+
+template <typename Cell, typename ParticleKernel, typename PairKernel,
+          typename DistanceFunction, typename VerletCriterion>
+void update_cluster_pairs_and_kernel(Cell &cell,
+                                     ParticleKernel &&particle_kernel,
+                                     PairKernel &&pair_kernel,
+                                     DistanceFunction &&distance_function,
+                                     VerletCriterion &&verlet_criterion) {
+  /* Clear the list */
+  cell.m_cluster_pairs.clear();
+  cell.m_rebuild_verlet_list = false;
+
+  for (int i = 0; i != cell.n; i++) {
+    particle_kernel(cell.part[i]);
+  }
+
+  auto const n_clusters_cell = n_clusters(cell.n);
+  for (int i = 0; i < n_clusters_cell; i++) {
+    /* Pairs in this cell */
+    for (int j = i; j < n_clusters_cell; j++) {
+      update_cluster_pair(cell, i, cell, j, ClusterPair::same_cell,
+                          pair_kernel, distance_function, verlet_criterion);
+    }
+
+    /* Pairs with neighbors */
+    uint16_t neighbor_index = 0;
+    for (auto &neighbor : cell.neighbors().red()) {
+      for (int j = 0; j < n_clusters(neighbor->n); j++) {
+        update_cluster_pair(cell, i, *neighbor, j, neighbor_index,
+                            pair_kernel, distance_function, verlet_criterion);
+      }
+      neighbor_index++;
+    }
+  }
+}
+
+template <typename Cell, typename ParticleKernel, typename PairKernel,
+          typename DistanceFunction>
+void cluster_pair_kernel(Cell &cell, ParticleKernel &&particle_kernel,
+                         PairKernel &&pair_kernel,
+                         DistanceFunction &&distance_function) {
+  for (int i = 0; i != cell.n; i++) {
+    particle_kernel(cell.part[i]);
+  }
+
+  auto const neighbors = cell.neighbors().red();
+  for (auto const &cluster_pair : cell.m_cluster_pairs) {
+    auto &other = (cluster_pair.neighbor == ClusterPair::same_cell)
+                      ? cell
+                      : *neighbors.begin()[cluster_pair.neighbor];
+    auto *const part_i = cell.part + cluster_pair.i * cluster_size;
+    auto *const part_j = other.part + cluster_pair.j * cluster_size;
+
+    for (int bit = 0; bit < cluster_size * cluster_size; bit++) {
+      if (cluster_pair.mask & (1u << bit)) {
+        auto &p1 = part_i[bit / cluster_size];
+        auto &p2 = part_j[bit % cluster_size];
+        auto dist = distance_function(p1, p2);
+        pair_kernel(p1, p2, dist);
+      }
+    }
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Iterates over all particles in the cell range
+ *        and all pairs in the cluster-pair lists of the cells.
+ *        If rebuild is true, all neighbor cells are iterated
+ *        and the cluster-pair lists are updated with the so
+ *        found pairs.
+ *
+ * Same as @ref verlet_ia, but the pairs are stored as pairs of clusters
+ * of @ref cluster_size consecutive particles of a cell with an
+ * interaction mask (see @ref ClusterPair), instead of as pairs of
+ * particle pointers. This needs much less memory if the particles of
+ * a cell are ordered such that consecutive particles are close to each
+ * other. The cells have to provide a %m_cluster_pairs container of
+ * @ref ClusterPair. The pairs are visited in a different order than
+ * by @ref verlet_ia. As there, the lists of cells with the
+ * %m_rebuild_verlet_list flag set are always updated.
+ */
+template <typename CellIterator, typename ParticleKernel, typename PairKernel,
+          typename DistanceFunction, typename VerletCriterion>
+void cluster_pair_ia(CellIterator first, CellIterator last,
+                     ParticleKernel &&particle_kernel, PairKernel &&pair_kernel,
+                     DistanceFunction &&distance_function,
+                     VerletCriterion &&verlet_criterion, bool rebuild) {
+  for (; first != last; ++first) {
+    if (rebuild or first->m_rebuild_verlet_list) {
+      detail::update_cluster_pairs_and_kernel(*first, particle_kernel,
+                                              pair_kernel, distance_function,
+                                              verlet_criterion);
+    } else {
+      detail::cluster_pair_kernel(*first, particle_kernel, pair_kernel,
+                                  distance_function);
+    }
+  }
+}
+} // namespace Algorithm
+
+#endif
@@ -0,0 +1,112 @@
+/*
+Copyright (C) 2010-2018 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CORE_ALGORITHM_COLOR_CELLS_HPP
+#define CORE_ALGORITHM_COLOR_CELLS_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+namespace Algorithm {
+/**
+ * @brief Partition cells into groups that can be processed concurrently.
+ *
+ * The footprint of a cell is the cell itself together with all its
+ * neighbors, which are the cells a pair loop over the cell can write to.
+ * Two cells conflict if their footprints overlap. The cells are
+ * distributed into groups such that no two cells in the same group
+ * conflict.
+ *
+ * If @p keep_order is true, every cell is put into a later group than all
+ * the conflicting cells that precede it in [first, last). Executing the
+ * groups one after the other then updates every particle in the same
+ * order as a serial loop over the cell range does, so the results are
+ * bit-identical to the serial loop. Otherwise the cells are colored
+ * greedily, which gives fewer and larger groups.
+ *
+ * The cell type has to provide a %neighbors() function as described in
+ * @ref for_each_pair.
+ *
+ * @param first Begin of the cell range, dereferences to a cell pointer.
+ * @param last End of the cell range.
+ * @param keep_order Keep the order of the serial loop.
+ * @return Groups of cell pointers.
+ */
+template <typename CellIterator>
+std::vector<
+    std::vector<typename std::iterator_traits<CellIterator>::value_type>>
+color_cells(CellIterator first, CellIterator last, bool keep_order) {
+  using CellRef = typename std::iterator_traits<CellIterator>::value_type;
+
+  std::vector<std::vector<CellRef>> groups;
+  /* Groups of all cells that have a cell in their footprint,
+   * in ascending order. */
+  std::unordered_map<CellRef, std::vector<int>> groups_touching;
+
+  std::vector<CellRef> footprint;
+  std::vector<int> taken;
+  for (; first != last; ++first) {
+    auto const cell = *first;
+
+    footprint.assign(1, cell);
+    for (auto const &neighbor : cell->neighbors().all()) {
+      footprint.push_back(neighbor);
+    }
+
+    taken.clear();
+    for (auto const &c : footprint) {
+      auto const it = groups_touching.find(c);
+      if (it != groups_touching.end()) {
+        taken.insert(taken.end(), it->second.begin(), it->second.end());
+      }
+    }
+
+    int group = 0;
+    if (keep_order) {
+      if (not taken.empty()) {
+        group = *std::max_element(taken.begin(), taken.end()) + 1;
+      }
+    } else {
+      std::sort(taken.begin(), taken.end());
+      for (auto const &g : taken) {
+        if (g == group)
+          group++;
+        else if (g > group)
+          break;
+      }
+    }
+
+    for (auto const &c : footprint) {
+      auto &touching = groups_touching[c];
+      touching.insert(
+          std::upper_bound(touching.begin(), touching.end(), group), group);
+    }
+
+    if (group >= static_cast<int>(groups.size())) {
+      groups.resize(group + 1);
+    }
+    groups[group].push_back(cell);
+  }
+
+  return groups;
+}
+} // namespace Algorithm
+
+#endif
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <utility>
 
+#include "cluster_pair_ia.hpp"
 #include "link_cell.hpp"
 #include "verlet_ia.hpp"
 
@@ -34,14 +35,17 @@ namespace Algorithm {
  * evaluated and @p verlet_criterion is evaluated with the calculated distance.
  * Iff true, the pair_kernel is called.
  *
- * For details see verlet_ia and link_cell.
+ * For details see verlet_ia, cluster_pair_ia and link_cell.
  *
  * Requirements on the types:
  * The Cell type has to provide a function %neighbors() that returns
  * a cell range comprised of the topological neighbors of the cell,
  * excluding the cell itself. The cells have to provide a %m_verlet_list
  * container that can be used to store particle pairs. It can be empty and is
- * not touched if @p use_verlet_list is false.
+ * not touched if @p use_verlet_list is false. If @p use_cluster_pairs
+ * is also true, the pairs are stored in the %m_cluster_pairs container
+ * instead, see @ref cluster_pair_ia. The list of a cell is also rebuilt
+ * if its %m_rebuild_verlet_list flag is set.
  *
  * verlet_criterion(p1, p2, distance_function(p1, p2)) has to be valid and
  * convertible to bool.
@@ -57,8 +61,13 @@ void for_each_pair(CellIterator first, CellIterator last,
                    ParticleKernel &&particle_kernel, PairKernel &&pair_kernel,
                    DistanceFunction &&distance_function,
                    VerletCriterion &&verlet_criterion, bool use_verlet_list,
-                   bool rebuild) {
-  if (use_verlet_list) {
+                   bool rebuild, bool use_cluster_pairs = false) {
+  if (use_verlet_list and use_cluster_pairs) {
+    cluster_pair_ia(first, last, std::forward<ParticleKernel>(particle_kernel),
+                    std::forward<PairKernel>(pair_kernel),
+                    std::forward<DistanceFunction>(distance_function),
+                    std::forward<VerletCriterion>(verlet_criterion), rebuild);
+  } else if (use_verlet_list) {
     verlet_ia(first, last, std::forward<ParticleKernel>(particle_kernel),
               std::forward<PairKernel>(pair_kernel),
               std::forward<DistanceFunction>(distance_function),
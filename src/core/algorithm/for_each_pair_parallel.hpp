@@ -0,0 +1,68 @@
+/*
+Copyright (C) 2010-2018 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CORE_ALGORITHM_FOR_EACH_PAIR_PARALLEL_HPP
+#define CORE_ALGORITHM_FOR_EACH_PAIR_PARALLEL_HPP
+
+#include "for_each_pair.hpp"
+
+#include <boost/iterator/indirect_iterator.hpp>
+
+#include <iterator>
+#include <vector>
+
+namespace Algorithm {
+/**
+ * @brief Run single and pair kernel for each particle (pair) on
+ *        several threads.
+ *
+ * Same as @ref for_each_pair, but the cells are taken from @p groups
+ * as produced by @ref color_cells. The groups are processed one after
+ * the other, the cells within a group are distributed over the OpenMP
+ * threads. Because cells in a group do not share any particles, the
+ * kernels only have to be thread-safe with respect to state that is
+ * not stored in the particles, as long as they only access the particles
+ * they are called with. Without OpenMP this is a serial loop over the
+ * groups.
+ */
+template <typename CellRef, typename ParticleKernel, typename PairKernel,
+          typename DistanceFunction, typename VerletCriterion>
+void for_each_pair_parallel(std::vector<std::vector<CellRef>> const &groups,
+                            ParticleKernel &&particle_kernel,
+                            PairKernel &&pair_kernel,
+                            DistanceFunction &&distance_function,
+                            VerletCriterion &&verlet_criterion,
+                            bool use_verlet_list, bool rebuild,
+                            bool use_cluster_pairs = false) {
+#pragma omp parallel
+  for (auto const &group : groups) {
+    auto const n_cells = static_cast<int>(group.size());
+
+#pragma omp for schedule(dynamic)
+    for (int i = 0; i < n_cells; i++) {
+      auto const first = boost::make_indirect_iterator(group.begin() + i);
+
+      for_each_pair(first, std::next(first), particle_kernel, pair_kernel,
+                    distance_function, verlet_criterion, use_verlet_list,
+                    rebuild, use_cluster_pairs);
+    }
+  }
+}
+} // namespace Algorithm
+
+#endif
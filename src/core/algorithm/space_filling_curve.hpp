@@ -0,0 +1,123 @@
+/*
+Copyright (C) 2010-2018 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CORE_ALGORITHM_SPACE_FILLING_CURVE_HPP
+#define CORE_ALGORITHM_SPACE_FILLING_CURVE_HPP
+
+#include <utils/Vector.hpp>
+
+#include <cstdint>
+
+namespace Algorithm {
+/** Space-filling curves to order cells and particles by. */
+enum class SpaceFillingCurve { NONE, MORTON, HILBERT };
+
+/** Number of bits per coordinate of the curve indices. */
+constexpr unsigned curve_bits = 10;
+
+namespace detail {
+/** Spread the lower @ref curve_bits bits of @p v to every third bit. */
+inline uint32_t spread_bits(uint32_t v) {
+  v &= 0x3ffu;
+  v = (v | (v << 16)) & 0x030000ffu;
+  v = (v | (v << 8)) & 0x0300f00fu;
+  v = (v | (v << 4)) & 0x030c30c3u;
+  v = (v | (v << 2)) & 0x09249249u;
+  return v;
+}
+
+inline uint32_t interleave(Utils::Vector<uint32_t, 3> const &x) {
+  return spread_bits(x[0]) | (spread_bits(x[1]) << 1) |
+         (spread_bits(x[2]) << 2);
+}
+} // namespace detail
+
+/**
+ * @brief Index of a grid point on the Morton (Z-order) curve.
+ *
+ * @param pos Grid point, the coordinates have to be smaller than
+ *            2^@ref curve_bits.
+ */
+inline uint32_t morton_index(Utils::Vector<uint32_t, 3> const &pos) {
+  return detail::interleave(pos);
+}
+
+/**
+ * @brief Index of a grid point on the Hilbert curve.
+ *
+ * Uses the transpose algorithm from J. Skilling, AIP Conf. Proc. 707,
+ * 381 (2004). Consecutive indices belong to neighboring grid points,
+ * and the first 8^k indices fill the cube of edge length 2^k at the
+ * origin.
+ *
+ * @param pos Grid point, the coordinates have to be smaller than
+ *            2^@ref curve_bits.
+ */
+inline uint32_t hilbert_index(Utils::Vector<uint32_t, 3> pos) {
+  auto const m = 1u << (curve_bits - 1);
+
+  /* Inverse undo */
+  for (auto q = m; q > 1; q >>= 1) {
+    auto const p = q - 1;
+    for (int i = 0; i < 3; i++) {
+      if (pos[i] & q) {
+        pos[0] ^= p;
+      } else {
+        auto const t = (pos[0] ^ pos[i]) & p;
+        pos[0] ^= t;
+        pos[i] ^= t;
+      }
+    }
+  }
+
+  /* Gray encode */
+  for (int i = 1; i < 3; i++) {
+    pos[i] ^= pos[i - 1];
+  }
+  uint32_t t = 0;
+  for (auto q = m; q > 1; q >>= 1) {
+    if (pos[2] & q)
+      t ^= q - 1;
+  }
+  for (int i = 0; i < 3; i++) {
+    pos[i] ^= t;
+  }
+
+  /* The first coordinate holds the most significant bits */
+  return detail::interleave({pos[2], pos[1], pos[0]});
+}
+
+/**
+ * @brief Index of a grid point on a space-filling curve.
+ *
+ * For @ref SpaceFillingCurve::NONE this is 0 for all points.
+ */
+inline uint32_t curve_index(SpaceFillingCurve curve,
+                            Utils::Vector<uint32_t, 3> const &pos) {
+  switch (curve) {
+  case SpaceFillingCurve::MORTON:
+    return morton_index(pos);
+  case SpaceFillingCurve::HILBERT:
+    return hilbert_index(pos);
+  default:
+    return 0;
+  }
+}
+} // namespace Algorithm
+
+#endif
@@ -19,65 +19,58 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef CORE_ALGORITHM_VERLET_IA_HPP
 #define CORE_ALGORITHM_VERLET_IA_HPP
 
-#include <utility>
-
 namespace Algorithm {
 namespace detail {
 
-template <typename CellIterator, typename ParticleKernel, typename PairKernel,
+template <typename Cell, typename ParticleKernel, typename PairKernel,
           typename DistanceFunction, typename VerletCriterion>
-void update_and_kernel(CellIterator first, CellIterator last,
-                       ParticleKernel &&particle_kernel,
+void update_and_kernel(Cell &cell, ParticleKernel &&particle_kernel,
                        PairKernel &&pair_kernel,
                        DistanceFunction &&distance_function,
                        VerletCriterion &&verlet_criterion) {
-  for (; first != last; ++first) {
-    /* Clear the VL */
-    first->m_verlet_list.clear();
+  /* Clear the VL */
+  cell.m_verlet_list.clear();
+  cell.m_rebuild_verlet_list = false;
 
-    for (int i = 0; i != first->n; i++) {
-      auto &p1 = first->part[i];
+  for (int i = 0; i != cell.n; i++) {
+    auto &p1 = cell.part[i];
 
-      particle_kernel(p1);
+    particle_kernel(p1);
 
-      /* Pairs in this cell */
-      for (int j = i + 1; j < first->n; j++) {
-        auto dist = distance_function(p1, first->part[j]);
-        if (verlet_criterion(p1, first->part[j], dist)) {
-          pair_kernel(p1, first->part[j], dist);
-          first->m_verlet_list.emplace_back(&p1, &(first->part[j]));
-        }
+    /* Pairs in this cell */
+    for (int j = i + 1; j < cell.n; j++) {
+      auto dist = distance_function(p1, cell.part[j]);
+      if (verlet_criterion(p1, cell.part[j], dist)) {
+        pair_kernel(p1, cell.part[j], dist);
+        cell.m_verlet_list.emplace_back(&p1, &(cell.part[j]));
       }
+    }
 
-      /* Pairs with neighbors */
-      for (auto &neighbor : first->neighbors().red()) {
-        for (int j = 0; j < neighbor->n; j++) {
-          auto &p2 = neighbor->part[j];
-          auto dist = distance_function(p1, p2);
-          if (verlet_criterion(p1, p2, dist)) {
-            pair_kernel(p1, p2, dist);
-            first->m_verlet_list.emplace_back(&p1, &p2);
-          }
+    /* Pairs with neighbors */
+    for (auto &neighbor : cell.neighbors().red()) {
+      for (int j = 0; j < neighbor->n; j++) {
+        auto &p2 = neighbor->part[j];
+        auto dist = distance_function(p1, p2);
+        if (verlet_criterion(p1, p2, dist)) {
+          pair_kernel(p1, p2, dist);
+          cell.m_verlet_list.emplace_back(&p1, &p2);
         }
       }
     }
   }
 }
 
-template <typename CellIterator, typename ParticleKernel, typename PairKernel,
+template <typename Cell, typename ParticleKernel, typename PairKernel,
           typename DistanceFunction>
-void kernel(CellIterator first, CellIterator last,
-            ParticleKernel &&particle_kernel, PairKernel &&pair_kernel,
-            DistanceFunction &&distance_function) {
-  for (; first != last; ++first) {
-    for (int i = 0; i != first->n; i++) {
-      particle_kernel(first->part[i]);
-    }
+void kernel(Cell &cell, ParticleKernel &&particle_kernel,
+            PairKernel &&pair_kernel, DistanceFunction &&distance_function) {
+  for (int i = 0; i != cell.n; i++) {
+    particle_kernel(cell.part[i]);
+  }
 
-    for (auto &pair : first->m_verlet_list) {
-      auto dist = distance_function(*pair.first, *pair.second);
-      pair_kernel(*pair.first, *pair.second, dist);
-    }
+  for (auto &pair : cell.m_verlet_list) {
+    auto dist = distance_function(*pair.first, *pair.second);
+    pair_kernel(*pair.first, *pair.second, dist);
   }
 }
 } // namespace detail
@@ -87,6 +80,9 @@ void kernel(CellIterator first, CellIterator last,
  *        and all pairs in the Verlet list of the cells.
  *        If rebuild is true, all neighbor cells are iterated
  *        and the Verlet lists are updated with the so found pairs.
+ *
+ * The lists of cells with the %m_rebuild_verlet_list flag set are
+ * updated even if rebuild is false, and the flag is cleared.
  */
 template <typename CellIterator, typename ParticleKernel, typename PairKernel,
           typename DistanceFunction, typename VerletCriterion>
@@ -94,16 +90,13 @@ void verlet_ia(CellIterator first, CellIterator last,
                ParticleKernel &&particle_kernel, PairKernel &&pair_kernel,
                DistanceFunction &&distance_function,
                VerletCriterion &&verlet_criterion, bool rebuild) {
-  if (rebuild) {
-    detail::update_and_kernel(first, last,
-                              std::forward<ParticleKernel>(particle_kernel),
-                              std::forward<PairKernel>(pair_kernel),
-                              std::forward<DistanceFunction>(distance_function),
-                              std::forward<VerletCriterion>(verlet_criterion));
-  } else {
-    detail::kernel(first, last, std::forward<ParticleKernel>(particle_kernel),
-                   std::forward<PairKernel>(pair_kernel),
-                   std::forward<DistanceFunction>(distance_function));
+  for (; first != last; ++first) {
+    if (rebuild or first->m_rebuild_verlet_list) {
+      detail::update_and_kernel(*first, particle_kernel, pair_kernel,
+                                distance_function, verlet_criterion);
+    } else {
+      detail::kernel(*first, particle_kernel, pair_kernel, distance_function);
+    }
   }
 }
 } // namespace Algorithm
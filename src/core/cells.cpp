@@ -25,6 +25,7 @@
  *  Implementation of cells.hpp.
  */
 #include "cells.hpp"
+#include "algorithm/color_cells.hpp"
 #include "algorithm/link_cell.hpp"
 #include "communication.hpp"
 #include "debug.hpp"
@@ -44,9 +45,14 @@
 
 #include <boost/iterator/indirect_iterator.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 /* Variables */
 
@@ -66,6 +72,20 @@ CellStructure cell_structure;
 unsigned resort_particles = Cells::RESORT_NONE;
 bool rebuild_verletlist = true;
 
+namespace {
+/** Cell groups for the threaded short-range loop,
+ *  empty if they have to be recomputed. */
+std::vector<std::vector<Cell *>> thread_groups;
+/** Whether @ref thread_groups keep the serial order. */
+bool thread_groups_ordered = true;
+/** Local cells with and without ghost neighbors, both
+ *  empty if they have to be recomputed. */
+std::vector<Cell *> interior_cells;
+std::vector<Cell *> boundary_cells;
+/** A ghost update started by cells_begin_ghost_update() is in transit. */
+bool ghost_update_pending = false;
+} // namespace
+
 CellPList CellStructure::local_cells() const { return ::local_cells; }
 
 CellPList CellStructure::ghost_cells() const { return ::ghost_cells; }
@@ -129,6 +149,14 @@ std::vector<std::pair<int, int>> get_pairs(double distance) {
   return ret;
 }
 
+bool cells_cover_range(double range) {
+  if (cell_structure.min_range == INACTIVE_CUTOFF)
+    return false;
+  if (cell_structure.type == CELL_STRUCTURE_NSQUARE)
+    return true;
+  return range <= cell_structure.min_range - skin;
+}
+
 void mpi_get_pairs_slave(int, int) {
   double distance;
   boost::mpi::broadcast(comm_cart, distance, 0);
@@ -183,10 +211,31 @@ static void topology_release(int cs) {
   }
 }
 
+/** The other cell systems need equally sized node domains. */
+static void reset_domain_cuts() {
+  auto const &cuts = domain_cuts();
+  if (std::any_of(cuts.begin(), cuts.end(),
+                  [](std::vector<double> const &c) { return not c.empty(); }))
+    set_domain_cuts({});
+}
+
 /** Choose the topology init function of a certain cell system. */
 void topology_init(int cs, double range, CellPList *local) {
   /** broadcast the flag for using Verlet list */
   boost::mpi::broadcast(comm_cart, cell_structure.use_verlet_list, 0);
+  boost::mpi::broadcast(comm_cart, cell_structure.use_cluster_pairs, 0);
+  boost::mpi::broadcast(comm_cart, cell_structure.space_filling_curve, 0);
+  boost::mpi::broadcast(comm_cart, cell_structure.incremental_verlet_list, 0);
+  /** broadcast the flag for overlapping the ghost communication */
+  boost::mpi::broadcast(comm_cart, cell_structure.overlap_ghost_comm, 0);
+  /** broadcast the load balancing parameters */
+  boost::mpi::broadcast(comm_cart, cell_structure.load_balancing_interval, 0);
+  boost::mpi::broadcast(comm_cart, cell_structure.load_balancing_metric, 0);
+  /** broadcast the flags for the threaded short-range loop */
+  boost::mpi::broadcast(comm_cart, cell_structure.use_threads, 0);
+  boost::mpi::broadcast(comm_cart, cell_structure.deterministic_threads, 0);
+  /** broadcast the flag for the vectorized non-bonded forces */
+  boost::mpi::broadcast(comm_cart, cell_structure.use_soa, 0);
 
   switch (cs) {
   /* Default to DD */
@@ -200,9 +249,11 @@ void topology_init(int cs, double range, CellPList *local) {
     dd_topology_init(local, node_grid, range);
     break;
   case CELL_STRUCTURE_NSQUARE:
+    reset_domain_cuts();
     nsq_topology_init(local);
     break;
   case CELL_STRUCTURE_LAYERED:
+    reset_domain_cuts();
     layered_topology_init(local, node_grid, range);
     break;
   default:
@@ -257,6 +308,9 @@ void cells_re_init(int new_cs, double range) {
   /* MOVE old local_cell list to temporary buffer */
   memmove(&tmp_local, &local_cells, sizeof(CellPList));
   init_cellplist(&local_cells);
+  thread_groups.clear();
+  interior_cells.clear();
+  boundary_cells.clear();
 
   /* MOVE old cells to temporary buffer */
   auto tmp_cells = std::move(cells);
@@ -306,6 +360,48 @@ int cells_get_n_particles() {
                          [](int n, const Cell *c) { return n + c->n; });
 }
 
+std::vector<std::vector<Cell *>> const &cells_thread_groups() {
+  if (thread_groups.empty() or
+      (thread_groups_ordered != cell_structure.deterministic_threads)) {
+    thread_groups_ordered = cell_structure.deterministic_threads;
+    thread_groups = Algorithm::color_cells(
+        local_cells.begin(), local_cells.end(), thread_groups_ordered);
+  }
+
+  return thread_groups;
+}
+
+namespace {
+void split_interior_boundary() {
+  std::unordered_set<Cell const *> const ghosts(ghost_cells.begin(),
+                                                ghost_cells.end());
+
+  interior_cells.clear();
+  boundary_cells.clear();
+  for (auto &c : local_cells) {
+    auto const neighbors = c->neighbors().all();
+    auto const boundary =
+        std::any_of(neighbors.begin(), neighbors.end(),
+                    [&ghosts](Cell const *n) { return ghosts.count(n); });
+    (boundary ? boundary_cells : interior_cells).push_back(c);
+  }
+}
+} // namespace
+
+std::vector<Cell *> const &cells_interior() {
+  if (interior_cells.empty() and boundary_cells.empty())
+    split_interior_boundary();
+
+  return interior_cells;
+}
+
+std::vector<Cell *> const &cells_boundary() {
+  if (interior_cells.empty() and boundary_cells.empty())
+    split_interior_boundary();
+
+  return boundary_cells;
+}
+
 /*************************************************/
 
 namespace {
@@ -317,6 +413,65 @@ void fold_and_reset(Particle &p) {
 
   p.l.p_old = p.r.p;
 }
+
+/** Curve along which the particles in the cells are ordered on resort.
+ *  The cluster-pair lists need spatially compact clusters, so they
+ *  imply the Morton order.
+ */
+Algorithm::SpaceFillingCurve particle_order() {
+  if ((cell_structure.space_filling_curve ==
+       Algorithm::SpaceFillingCurve::NONE) and
+      cell_structure.use_verlet_list and cell_structure.use_cluster_pairs)
+    return Algorithm::SpaceFillingCurve::MORTON;
+
+  return cell_structure.space_filling_curve;
+}
+
+/**
+ * @brief Order the particles of a cell along a space-filling curve
+ *        through their bounding box.
+ *
+ * Consecutive particles are then close to each other, which improves
+ * the cache reuse in the pair loops and keeps the clusters of
+ * \ref Algorithm::cluster_pair_ia compact.
+ */
+void sort_particles_spatially(Cell &cell, Algorithm::SpaceFillingCurve curve) {
+  if (cell.n < 2)
+    return;
+
+  Utils::Vector3d lower = cell.part[0].r.p;
+  Utils::Vector3d upper = lower;
+  for (int i = 1; i < cell.n; i++) {
+    for (int d = 0; d < 3; d++) {
+      lower[d] = std::min(lower[d], cell.part[i].r.p[d]);
+      upper[d] = std::max(upper[d], cell.part[i].r.p[d]);
+    }
+  }
+
+  auto const n_bins = (1u << Algorithm::curve_bits) - 1u;
+  std::vector<std::pair<uint32_t, int>> keys(cell.n);
+  for (int i = 0; i < cell.n; i++) {
+    Utils::Vector<uint32_t, 3> bin;
+    for (int d = 0; d < 3; d++) {
+      auto const extent = upper[d] - lower[d];
+      bin[d] = (extent > 0.)
+                   ? static_cast<uint32_t>(
+                         n_bins * (cell.part[i].r.p[d] - lower[d]) / extent)
+                   : 0u;
+    }
+    keys[i] = {Algorithm::curve_index(curve, bin), i};
+  }
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<Particle> sorted;
+  sorted.reserve(cell.n);
+  for (auto const &key : keys) {
+    sorted.emplace_back(std::move(cell.part[key.second]));
+  }
+  std::move(sorted.begin(), sorted.end(), cell.part);
+
+  update_local_particles(&cell);
+}
 } // namespace
 
 /**
@@ -401,9 +556,23 @@ void cells_resort_particles(int global_flag) {
 #endif
   }
 
+  auto const curve = particle_order();
+  if (curve != Algorithm::SpaceFillingCurve::NONE) {
+    for (auto &cell : local_cells) {
+      sort_particles_spatially(*cell, curve);
+    }
+  }
+
   ghost_communicator(&cell_structure.ghost_cells_comm);
   ghost_communicator(&cell_structure.exchange_ghosts_comm);
 
+  /* The ghosts are new, their displacement is tracked locally. */
+  if (incremental_verlet_updates()) {
+    for (auto &p : ghost_cells.particles()) {
+      p.l.p_old = p.r.p;
+    }
+  }
+
   /* Particles are now sorted, but Verlet lists are invalid
      and p_old has to be reset. */
   resort_particles = Cells::RESORT_NONE;
@@ -436,7 +605,102 @@ void cells_on_geometry_change(int flags) {
 
 /*************************************************/
 
+bool incremental_verlet_updates() {
+  return cell_structure.incremental_verlet_list and
+         (cell_structure.type == CELL_STRUCTURE_DOMDEC);
+}
+
+namespace {
+/** Check if any local particle is no longer in the cell that
+ *  the cell system would assign it to.
+ */
+bool particles_left_cells() {
+  return std::any_of(local_cells.begin(), local_cells.end(), [](Cell *c) {
+    return std::any_of(c->part, c->part + c->n, [c](Particle const &p) {
+      return cell_structure.particle_to_cell(p) != c;
+    });
+  });
+}
+
+/**
+ * @brief Mark the outdated Verlet lists for rebuild.
+ *
+ * The particles of those of @p cells in which any particle moved more
+ * than a quarter of the skin since its last reference position get new
+ * reference positions, and the Verlet lists of the local cells that
+ * contain pairs with these particles are marked for rebuild. This way the
+ * reference position of a particle never changes while a list containing
+ * it is in use. Since every particle moved less than skin / 4 relative to
+ * its reference both when a list was built and now, every particle moved
+ * less than skin / 2 since the list was built, and the list is still
+ * complete.
+ *
+ * @param cells Local or ghost cells with up-to-date positions.
+ */
+void mark_outdated_verlet_lists(CellPList &cells) {
+  auto const max_displacement2 = Utils::sqr(0.25 * skin);
+
+  std::unordered_set<Cell const *> moved_cells;
+  for (auto &c : cells) {
+    auto const moved =
+        std::any_of(c->part, c->part + c->n, [&](Particle const &p) {
+          return (p.r.p - p.l.p_old).norm2() > max_displacement2;
+        });
+
+    if (moved) {
+      for (int i = 0; i < c->n; i++) {
+        c->part[i].l.p_old = c->part[i].r.p;
+      }
+      moved_cells.insert(c);
+    }
+  }
+
+  if (moved_cells.empty())
+    return;
+
+  for (auto &c : local_cells) {
+    auto const neighbors = c->neighbors().red();
+    c->m_rebuild_verlet_list |=
+        moved_cells.count(c) or
+        std::any_of(neighbors.begin(), neighbors.end(), [&](Cell const *n) {
+          return moved_cells.count(n);
+        });
+  }
+}
+
+/** Resort the particles if any node needs to.
+ *
+ *  @return Whether the particles were resorted.
+ */
+bool resort_if_needed() {
+  if (incremental_verlet_updates()) {
+    check_resort_particles();
+  }
+
+  if (topology_check_resort(cell_structure.type, resort_particles)) {
+    int global = (resort_particles & Cells::RESORT_GLOBAL)
+                     ? CELL_GLOBAL_EXCHANGE
+                     : CELL_NEIGHBOR_EXCHANGE;
+
+    /* Communication step:  number of ghosts and ghost information */
+    cells_resort_particles(global);
+
+    return true;
+  }
+
+  return false;
+}
+} // namespace
+
 void check_resort_particles() {
+  if (incremental_verlet_updates()) {
+    /* Only particles that left their cell have to be resorted,
+     * the Verlet lists are updated in cells_update_ghosts(). */
+    if (particles_left_cells())
+      resort_particles |= Cells::RESORT_LOCAL;
+    return;
+  }
+
   const double skin2 = Utils::sqr(skin / 2.0);
 
   resort_particles |= (std::any_of(local_cells.particles().begin(),
@@ -450,19 +714,51 @@ void check_resort_particles() {
 
 /*************************************************/
 void cells_update_ghosts() {
-  if (topology_check_resort(cell_structure.type, resort_particles)) {
-    int global = (resort_particles & Cells::RESORT_GLOBAL)
-                     ? CELL_GLOBAL_EXCHANGE
-                     : CELL_NEIGHBOR_EXCHANGE;
-
-    /* Communication step:  number of ghosts and ghost information */
-    cells_resort_particles(global);
-
-  } else
+  if (not resort_if_needed()) {
     /* Communication step: ghost information */
     ghost_communicator(&cell_structure.update_ghost_pos_comm);
+
+    if (incremental_verlet_updates()) {
+      mark_outdated_verlet_lists(local_cells);
+      mark_outdated_verlet_lists(ghost_cells);
+    }
+  }
+}
+
+void cells_begin_ghost_update() {
+  if (not(cell_structure.overlap_ghost_comm and
+          (cell_structure.type == CELL_STRUCTURE_DOMDEC))) {
+    cells_update_ghosts();
+    return;
+  }
+
+  if (not resort_if_needed()) {
+    /* Communication step: ghost information, finished
+     * in cells_finish_ghost_update(). */
+    ghost_communicator_begin(&cell_structure.update_ghost_pos_comm);
+    ghost_update_pending = true;
+
+    /* The interior cells only depend on local particles */
+    if (incremental_verlet_updates()) {
+      mark_outdated_verlet_lists(local_cells);
+    }
+  }
 }
 
+void cells_finish_ghost_update() {
+  if (not ghost_update_pending)
+    return;
+
+  ghost_communicator_finish();
+  ghost_update_pending = false;
+
+  if (incremental_verlet_updates()) {
+    mark_outdated_verlet_lists(ghost_cells);
+  }
+}
+
+bool cells_ghost_update_pending() { return ghost_update_pending; }
+
 Cell *find_current_cell(const Particle &p) {
   assert(not resort_particles);
 
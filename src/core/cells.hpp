@@ -66,6 +66,8 @@
 
 #include "Cell.hpp"
 #include "ParticleRange.hpp"
+#include "algorithm/space_filling_curve.hpp"
+#include "load_balancing.hpp"
 
 /** Cell Structure */
 enum {
@@ -148,6 +150,52 @@ struct CellStructure {
   int type = CELL_STRUCTURE_NONEYET;
 
   bool use_verlet_list = true;
+  /** Store the Verlet lists as lists of particle cluster pairs,
+   *  see \ref Algorithm::cluster_pair_ia.
+   */
+  bool use_cluster_pairs = false;
+  /** Order the local cells (domain decomposition only) and the
+   *  particles within the cells along this curve, to improve the
+   *  memory locality of the pair loops.
+   */
+  Algorithm::SpaceFillingCurve space_filling_curve =
+      Algorithm::SpaceFillingCurve::NONE;
+  /** Rebuild only the Verlet lists of cells whose particles or
+   *  neighbor particles moved more than a quarter of the skin, and
+   *  resort the particles only once one of them left its cell
+   *  (domain decomposition only), see \ref cells_update_ghosts.
+   */
+  bool incremental_verlet_list = false;
+  /** Overlap the update of the ghost positions in the integration
+   *  loop with the short-range forces of the interior cells (domain
+   *  decomposition only), see \ref cells_begin_ghost_update.
+   */
+  bool overlap_ghost_comm = false;
+  /** Move the boundaries of the node domains towards an even load
+   *  every that many integration steps (domain decomposition only),
+   *  0 disables the load balancing, see load_balancing.hpp.
+   */
+  int load_balancing_interval = 0;
+  /** Load that is balanced between the nodes. */
+  LoadBalancing::Metric load_balancing_metric =
+      LoadBalancing::Metric::PARTICLES;
+
+  /** Run the short-range loop on several threads,
+   *  see \ref short_range_loop_parallel. This also threads the
+   *  particle-mesh steps of P3M and dipolar P3M, see
+   *  \ref p3m_for_each_in_slabs, and the collision and streaming of the
+   *  CPU lattice-Boltzmann fluid.
+   */
+  bool use_threads = false;
+  /** Keep the particle update order of the serial short-range loop
+   *  when using threads, so that the forces are bit-identical. The
+   *  energies are then calculated without threads.
+   */
+  bool deterministic_threads = true;
+  /** Use the vectorized structure-of-arrays kernels for the
+   *  non-bonded forces where possible, see \ref SoA::add_pair_forces.
+   */
+  bool use_soa = false;
 
   /** Maximal pair range supported by current
    * cell system.
@@ -267,13 +315,68 @@ void cells_resort_particles(int global_flag);
 void cells_on_geometry_change(int flags);
 
 /** Update ghost information. If \ref resort_particles == 1,
- *  also a resorting of the particles takes place.
+ *  also a resorting of the particles takes place. With incremental
+ *  Verlet list updates, the particles are only resorted if one of
+ *  them left its cell, otherwise the Verlet lists of the cells with
+ *  moved particles are marked for rebuild.
  */
 void cells_update_ghosts();
 
+/**
+ * @brief Start the update of the ghost information.
+ *
+ * Same as \ref cells_update_ghosts, but if no resort is needed and
+ * \ref CellStructure::overlap_ghost_comm is set, the ghost positions
+ * are only sent, and received by \ref cells_finish_ghost_update. Until
+ * then, only the particles of the cells in \ref cells_interior() may be
+ * accessed. The short-range loops finish the update after the interior
+ * cells.
+ */
+void cells_begin_ghost_update();
+
+/** Complete the ghost update started by \ref cells_begin_ghost_update,
+ *  if any.
+ */
+void cells_finish_ghost_update();
+
+/** Whether a ghost update started by \ref cells_begin_ghost_update
+ *  has not been finished yet.
+ */
+bool cells_ghost_update_pending();
+
 /** Calculate and return the total number of particles on this node. */
 int cells_get_n_particles();
 
+/**
+ * @brief Groups of local cells that can be processed concurrently.
+ *
+ * The groups are computed by @ref Algorithm::color_cells on first use
+ * and cached until the cell system changes.
+ */
+std::vector<std::vector<Cell *>> const &cells_thread_groups();
+
+/**
+ * @brief Local cells without ghost cells among their neighbors.
+ *
+ * Pairs with particles in these cells do not involve ghosts.
+ * Cached until the cell system changes.
+ */
+std::vector<Cell *> const &cells_interior();
+
+/**
+ * @brief Local cells that are not in \ref cells_interior().
+ */
+std::vector<Cell *> const &cells_boundary();
+
+/**
+ * @brief Whether the pair loop over the cells finds all pairs closer
+ *        than @p range.
+ *
+ * The particles can have moved by half the skin since they were
+ * sorted into the cells.
+ */
+bool cells_cover_range(double range);
+
 /**
  * @brief Get pairs closer than distance from the cells.
  *
@@ -300,6 +403,11 @@ unsigned const &get_resort_particles();
 /** Check if a particle resorting is required. */
 void check_resort_particles();
 
+/** Whether the Verlet lists are updated incrementally,
+ *  see \ref CellStructure::incremental_verlet_list.
+ */
+bool incremental_verlet_updates();
+
 /*@}*/
 
 /**
@@ -18,21 +18,109 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "ClusterStructure.hpp"
 #include "Cluster.hpp"
+#include "algorithm/link_cell.hpp"
 #include "bonded_interactions/bonded_interaction_data.hpp"
+#include "cells.hpp"
+#include "communication.hpp"
+#include "event.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "partCfg_global.hpp"
+#include "short_range_loop.hpp"
 #include <algorithm>
+#include <boost/iterator/indirect_iterator.hpp>
+#include <boost/optional.hpp>
+#include <boost/serialization/utility.hpp>
 #include <stdexcept>
+#include <utils/NoOp.hpp>
 #include <utils/for_each_pair.hpp>
+#include <utils/mpi/gather_buffer.hpp>
 
 namespace ClusterAnalysis {
 
+namespace {
+/** @brief Links between the particles of this node and their ghosts that
+ * are neighbors, as pairs of a particle id and the smallest id in its set.
+ *
+ * Nothing is returned if the cell system does not contain all pairs within
+ * the range of the criterion, in which case this holds on all nodes.
+ */
+template <class Criterion>
+boost::optional<std::vector<std::pair<int, int>>>
+local_cluster_links(Criterion const &criterion) {
+  on_observable_calc();
+  if (!cells_cover_range(criterion.range()))
+    return {};
+  cells_finish_ghost_update();
+
+  UnionFind sets;
+  detail::decide_distance([&](auto const &distance_function) {
+    Algorithm::link_cell(
+        boost::make_indirect_iterator(local_cells.begin()),
+        boost::make_indirect_iterator(local_cells.end()), Utils::NoOp{},
+        [&](Particle const &p1, Particle const &p2, Distance const &) {
+          if (criterion.decide(p1, p2))
+            sets.unite(p1.identity(), p2.identity());
+        },
+        distance_function);
+  });
+
+  std::vector<std::pair<int, int>> links;
+  for (int id = 0; id < sets.size(); id++) {
+    if (sets.contains(id))
+      links.emplace_back(id, sets.find(id));
+  }
+  return links;
+}
+
+/** @brief Links of all nodes on the head node */
+template <class Criterion>
+boost::optional<std::vector<std::pair<int, int>>>
+gather_cluster_links(Criterion const &criterion) {
+  auto links = local_cluster_links(criterion);
+  if (links)
+    Utils::Mpi::gather_buffer(*links, comm_cart);
+  return links;
+}
+
+template <class Criterion>
+void mpi_gather_cluster_links_slave(Criterion criterion) {
+  gather_cluster_links(criterion);
+}
+
+::Communication::RegisterCallback register_distance_criterion(
+    &mpi_gather_cluster_links_slave<PairCriteria::DistanceCriterion>);
+::Communication::RegisterCallback register_energy_criterion(
+    &mpi_gather_cluster_links_slave<PairCriteria::EnergyCriterion>);
+
+/** @brief Find the neighbors with the cell system if @p criterion is a
+ * @p Criterion and the cell system covers its range.
+ *
+ * @return Whether the neighbors were found.
+ */
+template <class Criterion>
+bool run_distributed(PairCriteria::PairCriterion const &criterion,
+                     UnionFind &sets) {
+  auto const c = dynamic_cast<Criterion const *>(&criterion);
+  if (!c)
+    return false;
+
+  mpi_call(mpi_gather_cluster_links_slave<Criterion>, *c);
+  auto const links = gather_cluster_links(*c);
+  if (!links)
+    return false;
+
+  for (auto const &link : *links) {
+    sets.unite(link.first, link.second);
+  }
+  return true;
+}
+} // namespace
+
 ClusterStructure::ClusterStructure() { clear(); }
 
 void ClusterStructure::clear() {
   clusters.clear();
   cluster_id.clear();
-  m_cluster_identities.clear();
 }
 
 inline bool ClusterStructure::part_of_cluster(const Particle &p) {
@@ -43,17 +131,34 @@ inline bool ClusterStructure::part_of_cluster(const Particle &p) {
 void ClusterStructure::run_for_all_pairs() {
   // clear data structs
   clear();
+  if (!m_pair_criterion) {
+    runtimeErrorMsg() << "No cluster criterion defined";
+    return;
+  }
 
-  // Iterate over pairs
-  Utils::for_each_pair(partCfg().begin(), partCfg().end(),
-                       [this](const Particle &p1, const Particle &p2) {
-                         this->add_pair(p1, p2);
-                       });
-  merge_clusters();
+  UnionFind sets;
+  if (!run_distributed<PairCriteria::DistanceCriterion>(*m_pair_criterion,
+                                                        sets) &&
+      !run_distributed<PairCriteria::EnergyCriterion>(*m_pair_criterion,
+                                                      sets)) {
+    // Iterate over pairs
+    Utils::for_each_pair(partCfg().begin(), partCfg().end(),
+                         [this, &sets](const Particle &p1, const Particle &p2) {
+                           if (m_pair_criterion->decide(p1, p2))
+                             sets.unite(p1.p.identity, p2.p.identity);
+                         });
+  }
+  populate(sets);
 }
 
 void ClusterStructure::run_for_bonded_particles() {
   clear();
+  if (!m_pair_criterion) {
+    runtimeErrorMsg() << "No cluster criterion defined";
+    return;
+  }
+
+  UnionFind sets;
   partCfg().update_bonds();
   for (const auto &p : partCfg()) {
     int j = 0;
@@ -65,129 +170,29 @@ void ClusterStructure::run_for_bonded_particles() {
         continue;
       }
       // We are only here if bond has one partner
-      add_pair(p, partCfg()[p.bl.e[j + 1]]);
+      auto const &partner = partCfg()[p.bl.e[j + 1]];
+      if (m_pair_criterion->decide(p, partner))
+        sets.unite(p.p.identity, partner.p.identity);
       j += 2; // Type id + one partner
     }
   }
-  merge_clusters();
-}
-
-void ClusterStructure::add_pair(const Particle &p1, const Particle &p2) {
-  // * check, if there's a neighbor
-  //   * No: Then go on to the next particle
-  // * Yes: Then if
-  //   * One of them belongs to a cluster, give the other one the same cluster
-  //     id.
-  //   * None of them belongs to a cluster: Give them both a new cluster id
-  //   * Both belong to different clusters: Mark the clusters as identical
-  //   * so that they can be put together later
-  if (!m_pair_criterion) {
-    runtimeErrorMsg() << "No cluster criterion defined";
-    return;
-  }
-  // If the two particles are neighbors...
-  if (m_pair_criterion->decide(p1, p2)) {
-
-    if // None belongs to a cluster
-        ((!part_of_cluster(p1)) && (!part_of_cluster(p2))) {
-      // Both particles belong to the same, new cluster
-      const int cid = get_next_free_cluster_id();
-
-      // assign the cluster_ids
-      cluster_id[p1.p.identity] = cid;
-      cluster_id[p2.p.identity] = cid;
-    } else if // p2 belongs to a cluster but p1 doesn't
-        (part_of_cluster(p2) && !part_of_cluster(p1)) {
-      // Give p1 the same cluster id as p2
-      cluster_id[p1.p.identity] = find_id_for(cluster_id.at(p2.p.identity));
-    } else if // i belongs to a cluster but j doesn't
-        (part_of_cluster(p1) && !part_of_cluster(p2)) {
-      // give p2 the cluster id from p1
-      cluster_id[p2.p.identity] = find_id_for(cluster_id.at(p1.p.identity));
-    } else if // Both belong to different clusters
-        (part_of_cluster(p1) && part_of_cluster(p2) &&
-         cluster_id.at(p1.p.identity) != cluster_id.at(p2.p.identity)) {
-      // Clusters of p1 and p2 are one and the same. Add an identity to the list
-      // The higher number must be inserted as first value of the pair
-      // because the substitutions later have to be done in descending order
-      const int cid1 = find_id_for(cluster_id.at(p1.p.identity));
-      const int cid2 = find_id_for(cluster_id.at(p2.p.identity));
-      if (cid1 > cid2) {
-        m_cluster_identities[cid1] = cid2;
-      } else if (cid1 < cid2) {
-        m_cluster_identities[cid2] = cid1;
-      }
-      // else do nothing. The clusters are already noted for merging.
-      // Connected clusters will be merged later
-    }
-    // The case for both particles being in the same cluster does not need to be
-    // treated.
-  }
-}
-
-void ClusterStructure::merge_clusters() {
-  // Relabel particles according to the cluster identities map
-  // Also create empty cluster objects for the final cluster id
-
-  // Collect needed changes in a separate map, as doing the changes on the fly
-  // would screw up the iterators
-  std::vector<std::pair<int, int>> to_be_changed;
-
-  for (auto it : cluster_id) {
-    // particle id is in it.first and cluster id in it.second
-    // We change the cluster id according to the cluster identities
-    // map
-    const int cid = find_id_for(it.second);
-    // We note the list of changes here, so we don't modify the map
-    // while iterating
-    to_be_changed.emplace_back(it.first, cid);
-    // Empty cluster object
-    if (clusters.find(cid) == clusters.end()) {
-      clusters[cid] = std::make_shared<Cluster>();
-    }
-  }
-
-  // Now act on the changes marke in above iteration
-  for (auto it : to_be_changed) {
-    cluster_id[it.first] = it.second;
-  }
-
-  // Now fill the cluster objects with particle ids
-  // Iterate over particles, fill in the cluster map
-  // to each cluster particle the corresponding cluster id
-  for (auto it : cluster_id) {
-    // If this is the first particle in this cluster, instance a new cluster
-    // object
-    if (clusters.find(it.second) == clusters.end()) {
-      clusters[it.second] = std::make_shared<Cluster>();
-    }
-    clusters[it.second]->particles.push_back(it.first);
-  }
-
-  // Sort particles ids in the clusters
-  for (const auto &c : clusters) {
-    std::sort(c.second->particles.begin(), c.second->particles.end());
-  }
-}
-
-int ClusterStructure::find_id_for(int x) {
-  int tmp = x;
-  while (m_cluster_identities.find(tmp) != m_cluster_identities.end()) {
-    tmp = m_cluster_identities[tmp];
-  }
-  return tmp;
+  populate(sets);
 }
 
-int ClusterStructure::get_next_free_cluster_id() {
-  // iterate over cluster_id'
-  int max_seen_cluster = 0;
-  for (auto it : cluster_id) {
-    int cid = it.second;
-    if (max_seen_cluster < cid) {
-      max_seen_cluster = cid;
+void ClusterStructure::populate(UnionFind &sets) {
+  // The ids are visited in ascending order, so that the particle ids in the
+  // clusters are sorted and every cluster is created at its smallest id,
+  // which is its cluster id.
+  for (int id = 0; id < sets.size(); id++) {
+    if (!sets.contains(id))
+      continue;
+    auto const cid = sets.find(id);
+    cluster_id.emplace_hint(cluster_id.end(), id, cid);
+    if (cid == id) {
+      clusters.emplace_hint(clusters.end(), cid, std::make_shared<Cluster>());
     }
+    clusters.at(cid)->particles.push_back(id);
   }
-  return max_seen_cluster + 1;
 }
 
 } // namespace ClusterAnalysis
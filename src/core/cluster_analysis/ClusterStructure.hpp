@@ -26,6 +26,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <vector>
 
 #include "Cluster.hpp"
+#include "UnionFind.hpp"
 #include "pair_criteria/pair_criteria.hpp"
 #include "particle_data.hpp"
 
@@ -42,7 +43,15 @@ public:
   std::map<int, int> cluster_id;
   /** @brief Clear data structures */
   void clear();
-  /** @brief Run cluster analysis, consider all particle pairs */
+  /** @brief Run cluster analysis, consider all particle pairs
+   *
+   * For criteria with a finite range that is covered by the cell system,
+   * every node finds the neighbors among its particles and ghosts with the
+   * cell system and joins them in a union-find forest. The sets of all
+   * nodes are merged on the head node, where the sets that share ghost
+   * particles are joined. Otherwise, all pairs of the gathered particles
+   * are considered.
+   */
   void run_for_all_pairs();
   /** @brief Run cluster analysis, consider pairs of particles connected by a
    * bonded interaction */
@@ -60,23 +69,11 @@ public:
   }
 
 private:
-  /** @brief Clusters that turn out to be the same during the analysis process
-   * (i.e., if two particles are neighbors that already belong to different
-   * clusters
-   */
-  std::map<int, int> m_cluster_identities;
-
   /** @brief pair criterion which decides whether two particles are neighbors */
   std::shared_ptr<PairCriteria::PairCriterion> m_pair_criterion;
 
-  /** @brief Consider an individual pair of particles during cluster analysis */
-  void add_pair(const Particle &p1, const Particle &p2);
-  /** Merge clusters and populate their structures */
-  void merge_clusters();
-  /** @brief Follow a chain of cluster identities during analysis */
-  inline int find_id_for(int x);
-  /** @brief Get next free cluster id */
-  inline int get_next_free_cluster_id();
+  /** @brief Create the clusters from the sets of neighboring particles */
+  void populate(UnionFind &sets);
 };
 
 } // namespace ClusterAnalysis
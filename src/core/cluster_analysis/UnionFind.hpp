@@ -0,0 +1,83 @@
+/*
+Copyright (C) 2010-2018 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CLUSTER_ANALYSIS_UNION_FIND_HPP
+#define CLUSTER_ANALYSIS_UNION_FIND_HPP
+
+#include <vector>
+
+namespace ClusterAnalysis {
+
+/** @brief Disjoint sets of particle ids.
+ *
+ *  The parents are stored in a flat array indexed by the particle id,
+ *  like the local particle index. The representative of a set is its
+ *  smallest id, so that the sets do not depend on the order in which
+ *  the pairs are added.
+ */
+class UnionFind {
+public:
+  /** @brief Whether @p id is part of any set */
+  bool contains(int id) const {
+    return id < m_parent.size() && m_parent[id] >= 0;
+  }
+
+  /** @brief Representative of the set of @p id, which has to be part of a
+   * set */
+  int find(int id) {
+    while (m_parent[id] != id) {
+      /* path halving */
+      m_parent[id] = m_parent[m_parent[id]];
+      id = m_parent[id];
+    }
+    return id;
+  }
+
+  /** @brief Merge the sets of @p a and @p b, ids that are not part of a set
+   * yet are added */
+  void unite(int a, int b) {
+    add(a);
+    add(b);
+    auto const root_a = find(a);
+    auto const root_b = find(b);
+    if (root_a < root_b) {
+      m_parent[root_b] = root_a;
+    } else if (root_b < root_a) {
+      m_parent[root_a] = root_b;
+    }
+  }
+
+  /** @brief Upper bound for the ids in the sets */
+  int size() const { return static_cast<int>(m_parent.size()); }
+
+  void clear() { m_parent.clear(); }
+
+private:
+  void add(int id) {
+    if (id >= m_parent.size())
+      m_parent.resize(id + 1, -1);
+    if (m_parent[id] < 0)
+      m_parent[id] = id;
+  }
+
+  /** Parent of every id, -1 for ids that are not part of a set */
+  std::vector<int> m_parent;
+};
+
+} // namespace ClusterAnalysis
+#endif
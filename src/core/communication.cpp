@@ -293,8 +293,13 @@ void mpi_remove_particle_slave(int pnode, int part) {
 
 /********************* REQ_MIN_ENERGY ********/
 
-REGISTER_CALLBACK(minimize_energy)
-void mpi_minimize_energy() { mpi_call_all(minimize_energy); }
+static void mpi_minimize_energy_slave() { minimize_energy(); }
+REGISTER_CALLBACK(mpi_minimize_energy_slave)
+
+int mpi_minimize_energy() {
+  mpi_call(mpi_minimize_energy_slave);
+  return minimize_energy();
+}
 
 /********************* REQ_INTEGRATE ********/
 static int mpi_integrate_slave(int n_steps, int reuse_forces) {
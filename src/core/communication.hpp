@@ -165,8 +165,10 @@ void mpi_remove_particle(int node, int id);
  */
 int mpi_integrate(int n_steps, int reuse_forces);
 
-/** Issue REQ_MIN_ENERGY: start energy minimization. */
-void mpi_minimize_energy();
+/** Issue REQ_MIN_ENERGY: start energy minimization.
+ *  @return number of minimization steps
+ */
+int mpi_minimize_energy();
 
 void mpi_bcast_all_ia_params();
 
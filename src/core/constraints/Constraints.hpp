@@ -82,14 +82,18 @@ public:
     }
   }
 
+  void add_energy(const Particle &p, double t, Observable_stat &energy) const {
+    auto const pos = folded_position(p.r.p, box_geo);
+
+    for (auto const &c : *this) {
+      c->add_energy(p, pos, t, energy);
+    }
+  }
+
   void add_energy(const ParticleRange &particles, double t,
                   Observable_stat &energy) const {
     for (auto &p : particles) {
-      auto const pos = folded_position(p.r.p, box_geo);
-
-      for (auto const &c : *this) {
-        c->add_energy(p, pos, t, energy);
-      }
+      add_energy(p, t, energy);
     }
   }
 
@@ -38,6 +38,11 @@ using Utils::get_linear_index;
 
 #include <boost/mpi/collectives.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 /** Returns pointer to the cell which corresponds to the position if the
  *  position is in the nodes spatial domain otherwise a nullptr pointer.
  */
@@ -72,6 +77,13 @@ int min_num_cells = 1;
  *  DomainDecomposition::cell_size, and \ref
  *  DomainDecomposition::inv_cell_size.
  *
+ *  If the node domains have different sizes (see \ref domain_cuts),
+ *  the cell size is determined for the largest domain in each direction,
+ *  and the other domains get as many cells of at least this size as fit.
+ *  Nodes with the same extent in a direction then have the same number
+ *  of cells in that direction, so the cells at the faces of neighboring
+ *  nodes match.
+ *
  *  @param range Required interacting range. All pairs closer
  *         than this distance are found.
  */
@@ -92,26 +104,36 @@ void dd_create_cell_grid(double range) {
 
     n_local_cells = dd.cell_grid[0] * dd.cell_grid[1] * dd.cell_grid[2];
   } else {
+    /* Size of the largest node domain */
+    auto const &cuts = domain_cuts();
+    auto grid_length = local_geo.length();
+    for (i = 0; i < 3; i++) {
+      for (int j = 1; j < cuts[i].size(); j++) {
+        grid_length[i] = std::max(grid_length[i], (cuts[i][j] - cuts[i][j - 1]) *
+                                                      box_geo.length()[i]);
+      }
+    }
+
     /* Calculate initial cell grid */
-    double volume = local_geo.length()[0];
+    double volume = grid_length[0];
     for (i = 1; i < 3; i++)
-      volume *= local_geo.length()[i];
+      volume *= grid_length[i];
     double scale = pow(max_num_cells / volume, 1. / 3.);
     for (i = 0; i < 3; i++) {
       /* this is at least 1 */
-      dd.cell_grid[i] = (int)ceil(local_geo.length()[i] * scale);
-      cell_range[i] = local_geo.length()[i] / dd.cell_grid[i];
+      dd.cell_grid[i] = (int)ceil(grid_length[i] * scale);
+      cell_range[i] = grid_length[i] / dd.cell_grid[i];
 
       if (cell_range[i] < range) {
         /* ok, too many cells for this direction, set to minimum */
-        dd.cell_grid[i] = (int)floor(local_geo.length()[i] / range);
+        dd.cell_grid[i] = (int)floor(grid_length[i] / range);
         if (dd.cell_grid[i] < 1) {
           runtimeErrorMsg()
               << "interaction range " << range << " in direction " << i
-              << " is larger than the local box size " << local_geo.length()[i];
+              << " is larger than the local box size " << grid_length[i];
           dd.cell_grid[i] = 1;
         }
-        cell_range[i] = local_geo.length()[i] / dd.cell_grid[i];
+        cell_range[i] = grid_length[i] / dd.cell_grid[i];
       }
     }
 
@@ -139,9 +161,24 @@ void dd_create_cell_grid(double range) {
       }
 
       dd.cell_grid[min_ind]--;
-      cell_range[min_ind] = local_geo.length()[min_ind] / dd.cell_grid[min_ind];
+      cell_range[min_ind] = grid_length[min_ind] / dd.cell_grid[min_ind];
     }
 
+    /* Cells of the smaller domains */
+    for (i = 0; i < 3; i++) {
+      if (not cuts[i].empty()) {
+        dd.cell_grid[i] =
+            std::max(1, (int)floor(local_geo.length()[i] / cell_range[i]));
+        if (local_geo.length()[i] < range) {
+          runtimeErrorMsg()
+              << "interaction range " << range << " in direction " << i
+              << " is larger than the local box size "
+              << local_geo.length()[i];
+        }
+      }
+    }
+    n_local_cells = dd.cell_grid[0] * dd.cell_grid[1] * dd.cell_grid[2];
+
     /* sanity check */
     if (n_local_cells < min_num_cells) {
       runtimeErrorMsg()
@@ -178,17 +215,32 @@ void dd_create_cell_grid(double range) {
  */
 void dd_mark_cells() {
   int cnt_c = 0, cnt_l = 0, cnt_g = 0;
+  auto const curve = cell_structure.space_filling_curve;
+  /* position of the local cells on the space-filling curve */
+  std::vector<std::pair<uint32_t, Cell *>> curve_order;
 
   for (int o = 0; o < dd.ghost_cell_grid[2]; o++)
     for (int n = 0; n < dd.ghost_cell_grid[1]; n++)
       for (int m = 0; m < dd.ghost_cell_grid[0]; m++) {
         if ((m > 0 && m < dd.ghost_cell_grid[0] - 1 && n > 0 &&
              n < dd.ghost_cell_grid[1] - 1 && o > 0 &&
-             o < dd.ghost_cell_grid[2] - 1))
+             o < dd.ghost_cell_grid[2] - 1)) {
+          if (curve != Algorithm::SpaceFillingCurve::NONE) {
+            auto const index = Algorithm::curve_index(
+                curve, {uint32_t(m - 1), uint32_t(n - 1), uint32_t(o - 1)});
+            curve_order.emplace_back(index, &cells[cnt_c]);
+          }
           local_cells.cell[cnt_l++] = &cells[cnt_c++];
-        else
+        } else
           ghost_cells.cell[cnt_g++] = &cells[cnt_c++];
       }
+
+  if (curve != Algorithm::SpaceFillingCurve::NONE) {
+    std::sort(curve_order.begin(), curve_order.end());
+    for (int i = 0; i < local_cells.n; i++) {
+      local_cells.cell[i] = curve_order[i].second;
+    }
+  }
 }
 
 /** Fill a communication cell pointer list. Fill the cell pointers of
@@ -35,10 +35,14 @@ using Utils::permute_ifield;
 using Utils::get_linear_index;
 #include <utils/memory.hpp>
 
+#include "threads.hpp"
+
 #include <fftw3.h>
 #include <mpi.h>
 
+#include <algorithm>
 #include <cstring>
+#include <numeric>
 
 /************************************************
  * DEFINES
@@ -53,6 +57,29 @@ using Utils::get_linear_index;
 #define REQ_FFT_BACK 302
 /*@}*/
 
+int fft_calc_local_mesh(const int *n_pos, const int *n_grid, const int *mesh,
+                        const double *mesh_off, int *loc_mesh, int *start) {
+  int i, last[3], size = 1;
+
+  for (i = 0; i < 3; i++) {
+    start[i] =
+        (int)ceil((mesh[i] / (double)n_grid[i]) * n_pos[i] - mesh_off[i]);
+    last[i] = (int)floor((mesh[i] / (double)n_grid[i]) * (n_pos[i] + 1) -
+                         mesh_off[i]);
+    /* correct round off errors */
+    if ((mesh[i] / (double)n_grid[i]) * (n_pos[i] + 1) - mesh_off[i] - last[i] <
+        1.0e-15)
+      last[i]--;
+    if (1.0 + (mesh[i] / (double)n_grid[i]) * n_pos[i] - mesh_off[i] -
+            start[i] <
+        1.0e-15)
+      start[i]--;
+    loc_mesh[i] = last[i] - start[i] + 1;
+    size *= loc_mesh[i];
+  }
+  return size;
+}
+
 namespace {
 /** This ugly function does the bookkeeping: which nodes have to
  *  communicate to each other, when you change the node grid.
@@ -169,42 +196,6 @@ find_comm_groups(Utils::Vector3i const &grid1, Utils::Vector3i const &grid2,
   return group;
 }
 
-/** Calculate the local fft mesh.  Calculate the local mesh (loc_mesh)
- *  of a node at position (n_pos) in a node grid (n_grid) for a global
- *  mesh of size (mesh) and a mesh offset (mesh_off (in mesh units))
- *  and store also the first point (start) of the local mesh.
- *
- * \param[in]  n_pos    Position of the node in n_grid.
- * \param[in]  n_grid   node grid.
- * \param[in]  mesh     global mesh dimensions.
- * \param[in]  mesh_off global mesh offset (see \ref p3m_data_struct).
- * \param[out] loc_mesh local mesh dimension.
- * \param[out] start    first point of local mesh in global mesh.
- * \return Number of mesh points in local mesh.
- */
-int calc_local_mesh(const int *n_pos, const int *n_grid, const int *mesh,
-                    const double *mesh_off, int *loc_mesh, int *start) {
-  int i, last[3], size = 1;
-
-  for (i = 0; i < 3; i++) {
-    start[i] =
-        (int)ceil((mesh[i] / (double)n_grid[i]) * n_pos[i] - mesh_off[i]);
-    last[i] = (int)floor((mesh[i] / (double)n_grid[i]) * (n_pos[i] + 1) -
-                         mesh_off[i]);
-    /* correct round off errors */
-    if ((mesh[i] / (double)n_grid[i]) * (n_pos[i] + 1) - mesh_off[i] - last[i] <
-        1.0e-15)
-      last[i]--;
-    if (1.0 + (mesh[i] / (double)n_grid[i]) * n_pos[i] - mesh_off[i] -
-            start[i] <
-        1.0e-15)
-      start[i]--;
-    loc_mesh[i] = last[i] - start[i] + 1;
-    size *= loc_mesh[i];
-  }
-  return size;
-}
-
 /** Calculate a send (or recv.) block for grid communication during a
  *  decomposition change.  Calculate the send block specification
  *  (block = lower left corner and upper right corner) which a node at
@@ -236,8 +227,8 @@ int calc_send_block(const int *pos1, const int *grid1, const int *pos2,
   int mesh1[3], first1[3], last1[3];
   int mesh2[3], first2[3], last2[3];
 
-  calc_local_mesh(pos1, grid1, mesh, mesh_off, mesh1, first1);
-  calc_local_mesh(pos2, grid2, mesh, mesh_off, mesh2, first2);
+  fft_calc_local_mesh(pos1, grid1, mesh, mesh_off, mesh1, first1);
+  fft_calc_local_mesh(pos2, grid2, mesh, mesh_off, mesh2, first2);
 
   for (i = 0; i < 3; i++) {
     last1[i] = first1[i] + mesh1[i] - 1;
@@ -422,6 +413,287 @@ void back_grid_comm(fft_forw_plan plan_f, fft_back_plan plan_b,
   }
 }
 
+/** One redistribution of the FFT mesh between two node grids. */
+struct grid_exchange {
+  /** group of nodes which have to communicate with each other. */
+  std::vector<int> const &group;
+  /** block specifications in the input mesh, 6 integers per node. */
+  int const *send_block;
+  /** send block communication sizes. */
+  int const *send_size;
+  /** dimensions of the input mesh. */
+  int const *in_mesh;
+  /** packing function for send blocks. */
+  void (*pack_function)(double const *const, double *const, int const *,
+                        int const *, int const *, int);
+  /** block specifications in the output mesh, 6 integers per node. */
+  int const *recv_block;
+  /** recv block communication sizes. */
+  int const *recv_size;
+  /** dimensions of the output mesh. */
+  int const *out_mesh;
+  /** size of block elements. */
+  int element;
+  /** MPI tag. */
+  int tag;
+};
+
+/** Redistribution according to the given forward FFT plan. */
+grid_exchange forw_exchange(fft_forw_plan const &plan) {
+  return {plan.group,          plan.send_block, plan.send_size,
+          plan.old_mesh,       plan.pack_function,
+          plan.recv_block,     plan.recv_size,  plan.new_mesh,
+          plan.element,        REQ_FFT_FORW};
+}
+
+/** Redistribution according to the given backward FFT plan, with the
+ *  send and receive blocks of the forward plan exchanged. */
+grid_exchange back_exchange(fft_forw_plan const &plan_f,
+                            fft_back_plan const &plan_b) {
+  return {plan_f.group,          plan_f.recv_block, plan_f.recv_size,
+          plan_f.new_mesh,       plan_b.pack_function,
+          plan_f.send_block,     plan_f.send_size,  plan_f.old_mesh,
+          plan_f.element,        REQ_FFT_BACK};
+}
+
+/** Communicate the grid data with non-blocking communication.
+ *
+ *  The input mesh is produced chunk by chunk by @p chunk_kernel, every
+ *  block is sent as soon as all slabs it covers are done. Receives are
+ *  posted first, and the blocks are unpacked in the order they arrive
+ *  after all chunks are done, so the kernel may still use the output
+ *  mesh. All blocks are in flight at the same time, the communication
+ *  buffers have to be large enough for that.
+ *
+ *  \param ex           Redistribution.
+ *  \param chunks       Chunks of the input mesh, may be empty if the
+ *                      input is complete.
+ *  \param chunk_kernel Called for each chunk, in order.
+ *  \param in           input mesh.
+ *  \param out          output mesh.
+ *  \param fft          FFT communication plan.
+ *  \param comm         MPI communicator.
+ */
+template <typename ChunkKernel>
+void overlapped_grid_comm(grid_exchange const &ex,
+                          std::vector<fft_chunk> const &chunks,
+                          ChunkKernel &&chunk_kernel, const double *in,
+                          double *out, fft_data_struct &fft,
+                          const boost::mpi::communicator &comm) {
+  auto const n = static_cast<int>(ex.group.size());
+
+  /* offsets of the blocks in the communication buffers */
+  std::vector<int> send_offset(n + 1, 0), recv_offset(n + 1, 0);
+  for (int i = 0; i < n; i++) {
+    send_offset[i + 1] = send_offset[i] + ex.send_size[i];
+    recv_offset[i + 1] = recv_offset[i] + ex.recv_size[i];
+  }
+
+  std::vector<MPI_Request> recv_requests(n, MPI_REQUEST_NULL);
+  std::vector<MPI_Request> send_requests(n, MPI_REQUEST_NULL);
+  int n_remote = 0;
+  for (int i = 0; i < n; i++) {
+    if (ex.group[i] != comm.rank()) {
+      MPI_Irecv(fft.recv_buf + recv_offset[i], ex.recv_size[i], MPI_DOUBLE,
+                ex.group[i], ex.tag, comm, &recv_requests[i]);
+      n_remote++;
+    }
+  }
+
+  std::vector<bool> sent(n, false);
+  auto send = [&](int i) {
+    ex.pack_function(in, fft.send_buf + send_offset[i],
+                     &(ex.send_block[6 * i]), &(ex.send_block[6 * i + 3]),
+                     ex.in_mesh, ex.element);
+    if (ex.group[i] != comm.rank()) {
+      MPI_Isend(fft.send_buf + send_offset[i], ex.send_size[i], MPI_DOUBLE,
+                ex.group[i], ex.tag, comm, &send_requests[i]);
+    }
+    sent[i] = true;
+  };
+
+  for (auto const &chunk : chunks) {
+    chunk_kernel(chunk);
+    for (int i = 0; i < n; i++) {
+      if (not sent[i] and
+          ex.send_block[6 * i] + ex.send_block[6 * i + 3] <= chunk.end)
+        send(i);
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    if (not sent[i])
+      send(i);
+  }
+
+  auto unpack = [&](double const *buf, int i) {
+    fft_unpack_block(buf, out, &(ex.recv_block[6 * i]),
+                     &(ex.recv_block[6 * i + 3]), ex.out_mesh, ex.element);
+  };
+
+  /* Self communication... */
+  for (int i = 0; i < n; i++) {
+    if (ex.group[i] == comm.rank())
+      unpack(fft.send_buf + send_offset[i], i);
+  }
+  for (int k = 0; k < n_remote; k++) {
+    int i;
+    MPI_Waitany(n, recv_requests.data(), &i, MPI_STATUS_IGNORE);
+    unpack(fft.recv_buf + recv_offset[i], i);
+  }
+  MPI_Waitall(n, send_requests.data(), MPI_STATUSES_IGNORE);
+}
+
+/** Perform the 1D FFTs of a chunk of a local FFT mesh.
+ *  \param chunk Chunk of the mesh.
+ *  \param mesh  Dimensions of the local FFT mesh.
+ *  \param data  Complex mesh data.
+ */
+void execute_chunk(fft_chunk const &chunk, int const *mesh, double *data) {
+  if (chunk.our_fftw_plan) {
+    auto *c_data = (fftw_complex *)data + chunk.begin * mesh[1] * mesh[2];
+    fftw_execute_dft(chunk.our_fftw_plan, c_data, c_data);
+  }
+}
+
+/** Split the slabs of a local FFT mesh at the slab boundaries of the
+ *  blocks taken from it.
+ *  \param block    block specifications, 6 integers per block.
+ *  \param n_blocks number of blocks.
+ *  \param n_slabs  number of slabs of the mesh.
+ *  \return The boundaries of the chunks, starting with 0 and ending with
+ *          n_slabs.
+ */
+std::vector<int> chunk_boundaries(int const *block, int n_blocks,
+                                  int n_slabs) {
+  std::vector<int> ret{0, n_slabs};
+  for (int i = 0; i < n_blocks; i++) {
+    if (block[6 * i + 3] > 0 and block[6 * i + 4] > 0 and block[6 * i + 5] > 0)
+      ret.push_back(std::min(block[6 * i] + block[6 * i + 3], n_slabs));
+  }
+  std::sort(ret.begin(), ret.end());
+  ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+
+  return ret;
+}
+
+/** Create the FFTW plans for the chunks of a local FFT mesh.
+ *  \param c_data     Complex data array, overwritten.
+ *  \param plan       Forward plan of the mesh.
+ *  \param boundaries Chunk boundaries, see \ref chunk_boundaries.
+ *  \param dir        FFTW direction.
+ */
+std::vector<fft_chunk> create_chunks(fftw_complex *c_data,
+                                     fft_forw_plan const &plan,
+                                     std::vector<int> const &boundaries,
+                                     int dir) {
+  std::vector<fft_chunk> ret;
+  for (int i = 1; i < boundaries.size(); i++) {
+    auto const n_rows =
+        (boundaries[i] - boundaries[i - 1]) * plan.new_mesh[1];
+    fftw_plan chunk_plan = nullptr;
+    if (n_rows > 0 and plan.new_mesh[2] > 0) {
+      /* The chunks start at arbitrary rows */
+      chunk_plan = fftw_plan_many_dft(
+          1, &plan.new_mesh[2], n_rows, c_data, nullptr, 1, plan.new_mesh[2],
+          c_data, nullptr, 1, plan.new_mesh[2], dir,
+          FFTW_PATIENT | FFTW_UNALIGNED);
+    }
+    ret.push_back({boundaries[i - 1], boundaries[i], chunk_plan});
+  }
+
+  return ret;
+}
+
+void destroy_chunks(std::vector<fft_chunk> &chunks) {
+  for (auto &chunk : chunks) {
+    if (chunk.our_fftw_plan)
+      fftw_destroy_plan(chunk.our_fftw_plan);
+  }
+  chunks.clear();
+}
+
+/** Forward 3D FFT with the communication overlapped with the 1D FFTs. */
+void fft_perform_forw_overlapped(double *data, fft_data_struct &fft,
+                                 const boost::mpi::communicator &comm) {
+  /* ===== first direction  ===== */
+  /* communication to current dir row format (in is data) */
+  overlapped_grid_comm(
+      forw_exchange(fft.plan[1]), {}, [](fft_chunk const &) {}, data,
+      fft.data_buf, fft, comm);
+
+  /* complexify the real data array (in is fft.data_buf) */
+  for (int i = 0; i < fft.plan[1].new_size; i++) {
+    data[2 * i + 0] = fft.data_buf[i]; /* real value */
+    data[2 * i + 1] = 0;               /* complex value */
+  }
+
+  /* ===== second direction ===== */
+  /* perform FFT (in/out is data) while communicating to the current dir
+   * row format */
+  overlapped_grid_comm(
+      forw_exchange(fft.plan[2]), fft.plan[1].chunks,
+      [&fft, data](fft_chunk const &chunk) {
+        execute_chunk(chunk, fft.plan[1].new_mesh, data);
+      },
+      data, fft.data_buf, fft, comm);
+
+  /* ===== third direction  ===== */
+  /* perform FFT (in/out is fft.data_buf) while communicating to the current
+   * dir row format */
+  overlapped_grid_comm(
+      forw_exchange(fft.plan[3]), fft.plan[2].chunks,
+      [&fft](fft_chunk const &chunk) {
+        execute_chunk(chunk, fft.plan[2].new_mesh, fft.data_buf);
+      },
+      fft.data_buf, data, fft, comm);
+  /* perform FFT (in/out is data)*/
+  for (auto const &chunk : fft.plan[3].chunks)
+    execute_chunk(chunk, fft.plan[3].new_mesh, data);
+}
+
+/** Backward 3D FFT with the communication overlapped with the 1D FFTs. */
+void fft_perform_back_overlapped(double *data, bool check_complex,
+                                 fft_data_struct &fft,
+                                 const boost::mpi::communicator &comm) {
+  /* ===== third direction  ===== */
+  /* perform FFT (in is data) while communicating */
+  overlapped_grid_comm(
+      back_exchange(fft.plan[3], fft.back[3]), fft.back[3].chunks,
+      [&fft, data](fft_chunk const &chunk) {
+        execute_chunk(chunk, fft.plan[3].new_mesh, data);
+      },
+      data, fft.data_buf, fft, comm);
+
+  /* ===== second direction ===== */
+  /* perform FFT (in is fft.data_buf) while communicating */
+  overlapped_grid_comm(
+      back_exchange(fft.plan[2], fft.back[2]), fft.back[2].chunks,
+      [&fft](fft_chunk const &chunk) {
+        execute_chunk(chunk, fft.plan[2].new_mesh, fft.data_buf);
+      },
+      fft.data_buf, data, fft, comm);
+
+  /* ===== first direction  ===== */
+  /* perform FFT (in is data) and throw away the (hopefully) empty complex
+   * component (in is data) while communicating (in is fft.data_buf) */
+  auto const row_size = fft.plan[1].new_mesh[1] * fft.plan[1].new_mesh[2];
+  overlapped_grid_comm(
+      back_exchange(fft.plan[1], fft.back[1]), fft.back[1].chunks,
+      [&fft, data, row_size, check_complex](fft_chunk const &chunk) {
+        execute_chunk(chunk, fft.plan[1].new_mesh, data);
+        for (int i = chunk.begin * row_size; i < chunk.end * row_size; i++) {
+          fft.data_buf[i] = data[2 * i]; /* real value */
+          if (check_complex && (data[2 * i + 1] > 1e-5)) {
+            printf("Complex value is not zero (i=%d,data=%g)!!!\n", i,
+                   data[2 * i + 1]);
+            if (i > 100)
+              throw std::runtime_error("Complex value is not zero");
+          }
+        }
+      },
+      fft.data_buf, data, fft, comm);
+}
+
 /** calculate 'best' mapping between a 2d and 3d grid.
  *  This we need for the communication from 3d domain decomposition
  *  to 2d row decomposition.
@@ -580,8 +852,9 @@ int fft_init(double **data, int const *ca_mesh_dim, int const *ca_mesh_margin,
         fft.plan[i].recv_size, 1 * fft.plan[i].group.size() * sizeof(int));
 
     fft.plan[i].new_size =
-        calc_local_mesh(my_pos[i], n_grid[i], global_mesh_dim, global_mesh_off,
-                        fft.plan[i].new_mesh, fft.plan[i].start);
+        fft_calc_local_mesh(my_pos[i], n_grid[i], global_mesh_dim,
+                            global_mesh_off, fft.plan[i].new_mesh,
+                            fft.plan[i].start);
     permute_ifield(fft.plan[i].new_mesh, 3, -(fft.plan[i].n_permute));
     permute_ifield(fft.plan[i].start, 3, -(fft.plan[i].n_permute));
     fft.plan[i].n_ffts = fft.plan[i].new_mesh[0] * fft.plan[i].new_mesh[1];
@@ -651,6 +924,19 @@ int fft_init(double **data, int const *ca_mesh_dim, int const *ca_mesh_margin,
     (*ks_pnum) = 5;
   }
 
+  if (fft.overlap_comm) {
+    /* all blocks of a redistribution are in flight at the same time */
+    for (i = 1; i < 4; i++) {
+      auto const n = fft.plan[i].group.size();
+      fft.max_comm_size = std::max(
+          {fft.max_comm_size,
+           std::accumulate(fft.plan[i].send_size, fft.plan[i].send_size + n,
+                           0),
+           std::accumulate(fft.plan[i].recv_size, fft.plan[i].recv_size + n,
+                           0)});
+    }
+  }
+
   /* Factor 2 for complex numbers */
   fft.send_buf =
       Utils::realloc(fft.send_buf, fft.max_comm_size * sizeof(double));
@@ -703,6 +989,37 @@ int fft_init(double **data, int const *ca_mesh_dim, int const *ca_mesh_margin,
     fft.back[1].pack_function = pack_block_permute2;
   }
 
+  /* === FFTs in chunks for the overlapped communication === */
+  for (i = 1; i < 4; i++) {
+    destroy_chunks(fft.plan[i].chunks);
+    destroy_chunks(fft.back[i].chunks);
+  }
+  if (fft.overlap_comm) {
+#ifdef FFTW_OMP
+    /* Without communication, the FFTs are the only work */
+    static bool const threads_initialized = fftw_init_threads();
+    if (threads_initialized and comm.size() == 1)
+      fftw_plan_with_nthreads(Threads::max_threads());
+#endif
+    for (i = 1; i < 4; i++) {
+      auto const n_slabs = fft.plan[i].new_mesh[0];
+      auto const forw_boundaries =
+          (i < 3) ? chunk_boundaries(fft.plan[i + 1].send_block,
+                                     fft.plan[i + 1].group.size(), n_slabs)
+                  : std::vector<int>{0, n_slabs};
+      fft.plan[i].chunks =
+          create_chunks(c_data, fft.plan[i], forw_boundaries, FFTW_FORWARD);
+      fft.back[i].chunks = create_chunks(
+          c_data, fft.plan[i],
+          chunk_boundaries(fft.plan[i].recv_block, fft.plan[i].group.size(),
+                           n_slabs),
+          FFTW_BACKWARD);
+    }
+#ifdef FFTW_OMP
+    fftw_plan_with_nthreads(1);
+#endif
+  }
+
   fft.init_tag = true;
   /* free(data); */
   for (i = 0; i < 4; i++) {
@@ -714,6 +1031,11 @@ int fft_init(double **data, int const *ca_mesh_dim, int const *ca_mesh_margin,
 
 void fft_perform_forw(double *data, fft_data_struct &fft,
                       const boost::mpi::communicator &comm) {
+  if (fft.overlap_comm) {
+    fft_perform_forw_overlapped(data, fft, comm);
+    return;
+  }
+
   /* ===== first direction  ===== */
 
   auto *c_data = (fftw_complex *)data;
@@ -745,6 +1067,11 @@ void fft_perform_forw(double *data, fft_data_struct &fft,
 
 void fft_perform_back(double *data, bool check_complex, fft_data_struct &fft,
                       const boost::mpi::communicator &comm) {
+  if (fft.overlap_comm) {
+    fft_perform_back_overlapped(data, check_complex, fft, comm);
+    return;
+  }
+
   int i;
 
   auto *c_data = (fftw_complex *)data;
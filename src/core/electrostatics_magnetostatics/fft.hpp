@@ -35,6 +35,14 @@
  *  complex FFT (even though a real to complex FFT would be
  *  sufficient)
  *
+ *  With @ref fft_data_struct::overlap_comm, the node grids (pencils)
+ *  are the same, but the redistribution uses non-blocking point-to-point
+ *  communication: the 1D FFTs of a direction are done in chunks of
+ *  slabs, and every block is sent as soon as the chunks it is taken from
+ *  are transformed, while the rest of the FFTs are still running. The
+ *  received blocks are unpacked in the order they arrive. On a single
+ *  node, the 1D FFTs use the threaded FFTW plans if available.
+ *
  *  \todo Combine the forward and backward structures.
  *  \todo The packing routines could be moved to utils.hpp when they are needed
  * elsewhere.
@@ -50,10 +58,24 @@
 #include <boost/mpi/communicator.hpp>
 #include <fftw3.h>
 
+#include <vector>
+
 /************************************************
  * data types
  ************************************************/
 
+/** 1D FFTs of the rows in a range of slabs (slowest index) of a
+ *  local FFT mesh, see @ref fft_data_struct::overlap_comm.
+ */
+struct fft_chunk {
+  /** first slab of the chunk. */
+  int begin;
+  /** one past the last slab of the chunk. */
+  int end;
+  /** plan for the FFTs, nullptr if the chunk has no rows. */
+  fftw_plan our_fftw_plan;
+};
+
 /** Structure for performing a 1D FFT.
  *
  *  This includes the information about the redistribution of the 3D
@@ -96,6 +118,11 @@ struct fft_forw_plan {
   int *recv_size = nullptr;
   /** size of send block elements. */
   int element;
+
+  /** the FFTs in chunks, such that each send block of the following
+   *  plan is complete after one of the chunks (only with
+   *  @ref fft_data_struct::overlap_comm). */
+  std::vector<fft_chunk> chunks;
 };
 
 /** Additional information for backwards FFT.*/
@@ -108,6 +135,11 @@ struct fft_back_plan {
   /** packing function for send blocks. */
   void (*pack_function)(double const *const, double *const, int const *,
                         int const *, int const *, int);
+
+  /** the FFTs in chunks, such that each block of the backward
+   *  communication of this plan is complete after one of the chunks
+   *  (only with @ref fft_data_struct::overlap_comm). */
+  std::vector<fft_chunk> chunks;
 };
 
 /** Information about the three one dimensional FFTs and how the nodes
@@ -126,6 +158,11 @@ struct fft_data_struct {
   /** Whether FFT is initialized or not. */
   bool init_tag = false;
 
+  /** Overlap the redistribution of the mesh with the 1D FFTs, see
+   *  @ref fft.hpp. Has to be set before @ref fft_init.
+   */
+  bool overlap_comm = false;
+
   /** Maximal size of the communication buffers. */
   int max_comm_size = 0;
 
@@ -181,6 +218,22 @@ void fft_perform_forw(double *data, fft_data_struct &fft,
 void fft_perform_back(double *data, bool check_complex, fft_data_struct &fft,
                       const boost::mpi::communicator &comm);
 
+/** Calculate the local fft mesh.  Calculate the local mesh (loc_mesh)
+ *  of a node at position (n_pos) in a node grid (n_grid) for a global
+ *  mesh of size (mesh) and a mesh offset (mesh_off (in mesh units))
+ *  and store also the first point (start) of the local mesh.
+ *
+ * \param[in]  n_pos    Position of the node in n_grid.
+ * \param[in]  n_grid   node grid.
+ * \param[in]  mesh     global mesh dimensions.
+ * \param[in]  mesh_off global mesh offset (see \ref p3m_data_struct).
+ * \param[out] loc_mesh local mesh dimension.
+ * \param[out] start    first point of local mesh in global mesh.
+ * \return Number of mesh points in local mesh.
+ */
+int fft_calc_local_mesh(const int *n_pos, const int *n_grid, const int *mesh,
+                        const double *mesh_off, int *loc_mesh, int *start);
+
 /** pack a block (size[3] starting at start[3]) of an input 3d-grid
  *  with dimension dim[3] into an output 3d-block with dimension size[3].
  *
@@ -29,6 +29,11 @@
 #include <utils/constants.hpp>
 #include <utils/math/sqr.hpp>
 
+#include <boost/algorithm/clamp.hpp>
+
+#include <algorithm>
+#include <numeric>
+
 /* For debug messages */
 extern int this_node;
 
@@ -278,4 +283,25 @@ double p3m_caf(int i, double x, int cao_value) {
   }
   }
 }
+
+p3m_slabs p3m_sort_into_slabs(std::vector<int> const &planes, int cao,
+                              int n_planes) {
+  auto const n_slabs = std::max(1, (n_planes + cao - 1) / cao);
+  auto slab = [=](int plane) {
+    return boost::algorithm::clamp(plane / cao, 0, n_slabs - 1);
+  };
+
+  p3m_slabs ret;
+  ret.start.assign(n_slabs + 1, 0);
+  for (auto const plane : planes)
+    ret.start[slab(plane) + 1]++;
+  std::partial_sum(ret.start.begin(), ret.start.end(), ret.start.begin());
+
+  ret.order.resize(planes.size());
+  auto next = ret.start;
+  for (int i = 0; i < planes.size(); i++)
+    ret.order[next[slab(planes[i])]++] = i;
+
+  return ret;
+}
 #endif /* defined(P3M) || defined(DP3M) */
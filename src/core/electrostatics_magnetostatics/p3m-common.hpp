@@ -54,6 +54,8 @@
 
 #if defined(P3M) || defined(DP3M)
 
+#include <vector>
+
 /** Error Codes for p3m tuning (version 2) */
 enum P3M_TUNE_ERROR {
   /** force evaluation failed */
@@ -180,11 +182,15 @@ typedef struct {
   /** additional points around the charge assignment mesh, for method like
    *  dielectric ELC creating virtual charges. */
   double additional_mesh[3] = {};
+  /** overlap the FFT communication with the 1D FFTs, see
+   *  @ref fft_data_struct::overlap_comm. */
+  bool overlap_fft_comm = false;
 
   template <typename Archive> void serialize(Archive &ar, long int) {
     ar &tuning &alpha_L &r_cut_iL &mesh;
     ar &mesh_off &cao &inter &accuracy &epsilon &cao_cut;
     ar &a &ai &alpha &r_cut &inter2 &cao3 &additional_mesh;
+    ar &overlap_fft_comm;
   }
 
 } P3MParameters;
@@ -216,6 +222,53 @@ double p3m_analytic_cotangent_sum(int n, double mesh_i, int cao);
  */
 double p3m_caf(int i, double x, int cao_value);
 
+/** Charges sorted into slabs of the local mesh, see
+ *  \ref p3m_sort_into_slabs.
+ */
+typedef struct {
+  /** indices of the charges, ordered by slab. */
+  std::vector<int> order;
+  /** start of each slab in @ref order, followed by the end of the last. */
+  std::vector<int> start;
+} p3m_slabs;
+
+/** Sort charges into slabs of the local mesh for the threaded charge
+ *  assignment.
+ *
+ *  The slabs are @p cao mesh planes thick in the first direction. A
+ *  charge whose assignment starts in slab s only touches the mesh in the
+ *  slabs s and s + 1, so the charges of every other slab can be assigned
+ *  concurrently. Within a slab the charges keep their order.
+ *
+ *  \param planes   First mesh plane in the first direction of each charge.
+ *  \param cao      Charge assignment order.
+ *  \param n_planes Number of mesh planes in the first direction.
+ */
+p3m_slabs p3m_sort_into_slabs(std::vector<int> const &planes, int cao,
+                              int n_planes);
+
+/** Call @p kernel with the index of each charge in @p slabs.
+ *
+ *  The even slabs are processed first, then the odd ones. The slabs of
+ *  one color are distributed over the OpenMP threads, so the kernel may
+ *  add to the mesh without locks. The order of the summation does not
+ *  depend on the number of threads. Without OpenMP this is a serial loop.
+ */
+template <typename Kernel>
+void p3m_for_each_in_slabs(p3m_slabs const &slabs, Kernel &&kernel) {
+  auto const n_slabs = static_cast<int>(slabs.start.size()) - 1;
+
+#pragma omp parallel
+  for (int color = 0; color < 2; color++) {
+#pragma omp for schedule(dynamic)
+    for (int s = color; s < n_slabs; s += 2) {
+      for (int i = slabs.start[s]; i < slabs.start[s + 1]; i++) {
+        kernel(slabs.order[i]);
+      }
+    }
+  }
+}
+
 #endif /* P3M || DP3M */
 
 #endif /* _P3M_COMMON_H */
@@ -368,6 +368,7 @@ void dp3m_init() {
     dp3m.pos_shift =
         std::floor((dp3m.params.cao - 1) / 2.0) - (dp3m.params.cao % 2) / 2.0;
 
+    dp3m.fft.overlap_comm = dp3m.params.overlap_fft_comm;
     int ca_mesh_size =
         fft_init(&dp3m.rs_mesh, dp3m.local_mesh.dim, dp3m.local_mesh.margin,
                  dp3m.params.mesh, dp3m.params.mesh_off, &dp3m.ks_pnum,
@@ -561,6 +562,14 @@ int dp3m_set_eps(double eps) {
   return ES_OK;
 }
 
+int dp3m_set_overlap_fft_comm(bool overlap) {
+  dp3m.params.overlap_fft_comm = overlap;
+
+  mpi_bcast_coulomb_params();
+
+  return ES_OK;
+}
+
 int dp3m_set_ninterpol(int n) {
   if (n < 0)
     return ES_ERROR;
@@ -596,6 +605,50 @@ void dp3m_interpolate_dipole_assignment_function() {
   }
 }
 
+/** Collect the magnetic particles, in the order of the dipole fractions. */
+static std::vector<Particle *>
+dipolar_particles(const ParticleRange &particles) {
+  std::vector<Particle *> ret;
+  for (auto &p : particles) {
+    if (p.p.dipm != 0.0)
+      ret.push_back(&p);
+  }
+
+  return ret;
+}
+
+/** Assign the dipoles on several threads, see \ref p3m_sort_into_slabs.
+ *  @return The number of magnetic particles.
+ */
+static int dp3m_dipole_assign_parallel(const ParticleRange &particles) {
+  void dp3m_realloc_ca_fields(int size);
+
+  auto const dipolar = dipolar_particles(particles);
+  auto const n_dipolar = static_cast<int>(dipolar.size());
+
+  /* first mesh plane in the first direction of each dipole */
+  std::vector<int> planes(n_dipolar);
+  for (int i = 0; i < n_dipolar; i++) {
+    planes[i] = (int)(((dipolar[i]->r.p[0] - dp3m.local_mesh.ld_pos[0]) *
+                       dp3m.params.ai[0]) -
+                      dp3m.pos_shift);
+  }
+
+  /* the threads must not resize the dipole fraction fields */
+  if (n_dipolar > dp3m.ca_num)
+    dp3m_realloc_ca_fields(n_dipolar);
+
+  p3m_for_each_in_slabs(
+      p3m_sort_into_slabs(planes, dp3m.params.cao, dp3m.local_mesh.dim[0]),
+      [&dipolar](int cp_cnt) {
+        auto const &p = *dipolar[cp_cnt];
+        dp3m_assign_dipole(p.r.p.data(), p.p.dipm, p.calc_dip().data(),
+                           cp_cnt);
+      });
+
+  return n_dipolar;
+}
+
 void dp3m_dipole_assign(const ParticleRange &particles) {
   /* magnetic particle counter, dipole fraction counter */
   int cp_cnt = 0;
@@ -605,10 +658,15 @@ void dp3m_dipole_assign(const ParticleRange &particles) {
     for (int j = 0; j < dp3m.local_mesh.size; j++)
       i[j] = 0.0;
 
-  for (auto const &p : particles) {
-    if (p.p.dipm != 0.0) {
-      dp3m_assign_dipole(p.r.p.data(), p.p.dipm, p.calc_dip().data(), cp_cnt);
-      cp_cnt++;
+  if (cell_structure.use_threads) {
+    cp_cnt = dp3m_dipole_assign_parallel(particles);
+  } else {
+    for (auto const &p : particles) {
+      if (p.p.dipm != 0.0) {
+        dp3m_assign_dipole(p.r.p.data(), p.p.dipm, p.calc_dip().data(),
+                           cp_cnt);
+        cp_cnt++;
+      }
     }
   }
 
@@ -722,60 +780,58 @@ void dp3m_shrink_wrap_dipole_grid(int n_dipoles) {
 #ifdef ROTATION
 /** Assign the torques obtained from k-space */
 static void P3M_assign_torques(double prefac, int d_rs,
-                               const ParticleRange &particles) {
-  /* particle counter, charge fraction counter */
-  int cp_cnt = 0, cf_cnt = 0;
-  /* index, index jumps for dp3m.rs_mesh array */
-  int q_ind;
+                               std::vector<Particle *> const &dipolar) {
+  auto const n_dipolar = static_cast<int>(dipolar.size());
+  /* index jumps for dp3m.rs_mesh array */
   int q_m_off = (dp3m.local_mesh.dim[2] - dp3m.params.cao);
   int q_s_off =
       dp3m.local_mesh.dim[2] * (dp3m.local_mesh.dim[1] - dp3m.params.cao);
 
-  cp_cnt = 0;
-  cf_cnt = 0;
-
-  for (auto &p : particles) {
-    if ((p.p.dipm) != 0.0) {
-      const Utils::Vector3d dip = p.calc_dip();
-      q_ind = dp3m.ca_fmp[cp_cnt];
-      for (int i0 = 0; i0 < dp3m.params.cao; i0++) {
-        for (int i1 = 0; i1 < dp3m.params.cao; i1++) {
-          for (int i2 = 0; i2 < dp3m.params.cao; i2++) {
-            /*
-            The following line would fill the torque with the k-space electric
-            field (without the self-field term) [notice the minus sign!]:
-                                p.f.torque[d_rs] -=
-                prefac*dp3m.ca_frac[cf_cnt]*dp3m.rs_mesh[q_ind];
-            Since the torque is the dipole moment cross-product with E, we
-            have:
-            */
-            switch (d_rs) {
-            case 0: // E_x
-              p.f.torque[1] -=
-                  dip[2] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
-              p.f.torque[2] +=
-                  dip[1] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
-              break;
-            case 1: // E_y
-              p.f.torque[0] +=
-                  dip[2] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
-              p.f.torque[2] -=
-                  dip[0] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
-              break;
-            case 2: // E_z
-              p.f.torque[0] -=
-                  dip[1] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
-              p.f.torque[1] +=
-                  dip[0] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
-            }
-            q_ind++;
-            cf_cnt++;
+  /* the particles only write their own torques */
+#pragma omp parallel for if (cell_structure.use_threads)
+  for (int cp_cnt = 0; cp_cnt < n_dipolar; cp_cnt++) {
+    auto &p = *dipolar[cp_cnt];
+    const Utils::Vector3d dip = p.calc_dip();
+    /* charge fraction counter */
+    int cf_cnt = cp_cnt * dp3m.params.cao3;
+    /* index for dp3m.rs_mesh array */
+    int q_ind = dp3m.ca_fmp[cp_cnt];
+    for (int i0 = 0; i0 < dp3m.params.cao; i0++) {
+      for (int i1 = 0; i1 < dp3m.params.cao; i1++) {
+        for (int i2 = 0; i2 < dp3m.params.cao; i2++) {
+          /*
+          The following line would fill the torque with the k-space electric
+          field (without the self-field term) [notice the minus sign!]:
+                              p.f.torque[d_rs] -=
+              prefac*dp3m.ca_frac[cf_cnt]*dp3m.rs_mesh[q_ind];
+          Since the torque is the dipole moment cross-product with E, we
+          have:
+          */
+          switch (d_rs) {
+          case 0: // E_x
+            p.f.torque[1] -=
+                dip[2] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
+            p.f.torque[2] +=
+                dip[1] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
+            break;
+          case 1: // E_y
+            p.f.torque[0] +=
+                dip[2] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
+            p.f.torque[2] -=
+                dip[0] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
+            break;
+          case 2: // E_z
+            p.f.torque[0] -=
+                dip[1] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
+            p.f.torque[1] +=
+                dip[0] * prefac * dp3m.ca_frac[cf_cnt] * dp3m.rs_mesh[q_ind];
           }
-          q_ind += q_m_off;
+          q_ind++;
+          cf_cnt++;
         }
-        q_ind += q_s_off;
+        q_ind += q_m_off;
       }
-      cp_cnt++;
+      q_ind += q_s_off;
     }
   }
 }
@@ -783,37 +839,35 @@ static void P3M_assign_torques(double prefac, int d_rs,
 
 /** Assign the dipolar forces obtained from k-space */
 static void dp3m_assign_forces_dip(double prefac, int d_rs,
-                                   const ParticleRange &particles) {
-  /* particle counter, charge fraction counter */
-  int cp_cnt = 0, cf_cnt = 0;
-  /* index, index jumps for dp3m.rs_mesh array */
-  int q_ind;
+                                   std::vector<Particle *> const &dipolar) {
+  auto const n_dipolar = static_cast<int>(dipolar.size());
+  /* index jumps for dp3m.rs_mesh array */
   int q_m_off = (dp3m.local_mesh.dim[2] - dp3m.params.cao);
   int q_s_off =
       dp3m.local_mesh.dim[2] * (dp3m.local_mesh.dim[1] - dp3m.params.cao);
 
-  cp_cnt = 0;
-  cf_cnt = 0;
-
-  for (auto &p : particles) {
-    if ((p.p.dipm) != 0.0) {
-      const Utils::Vector3d dip = p.calc_dip();
-      q_ind = dp3m.ca_fmp[cp_cnt];
-      for (int i0 = 0; i0 < dp3m.params.cao; i0++) {
-        for (int i1 = 0; i1 < dp3m.params.cao; i1++) {
-          for (int i2 = 0; i2 < dp3m.params.cao; i2++) {
-            p.f.f[d_rs] += prefac * dp3m.ca_frac[cf_cnt] *
-                           (dp3m.rs_mesh_dip[0][q_ind] * dip[0] +
-                            dp3m.rs_mesh_dip[1][q_ind] * dip[1] +
-                            dp3m.rs_mesh_dip[2][q_ind] * dip[2]);
-            q_ind++;
-            cf_cnt++;
-          }
-          q_ind += q_m_off;
+  /* the particles only write their own forces */
+#pragma omp parallel for if (cell_structure.use_threads)
+  for (int cp_cnt = 0; cp_cnt < n_dipolar; cp_cnt++) {
+    auto &p = *dipolar[cp_cnt];
+    const Utils::Vector3d dip = p.calc_dip();
+    /* charge fraction counter */
+    int cf_cnt = cp_cnt * dp3m.params.cao3;
+    /* index for dp3m.rs_mesh array */
+    int q_ind = dp3m.ca_fmp[cp_cnt];
+    for (int i0 = 0; i0 < dp3m.params.cao; i0++) {
+      for (int i1 = 0; i1 < dp3m.params.cao; i1++) {
+        for (int i2 = 0; i2 < dp3m.params.cao; i2++) {
+          p.f.f[d_rs] += prefac * dp3m.ca_frac[cf_cnt] *
+                         (dp3m.rs_mesh_dip[0][q_ind] * dip[0] +
+                          dp3m.rs_mesh_dip[1][q_ind] * dip[1] +
+                          dp3m.rs_mesh_dip[2][q_ind] * dip[2]);
+          q_ind++;
+          cf_cnt++;
         }
-        q_ind += q_s_off;
+        q_ind += q_m_off;
       }
-      cp_cnt++;
+      q_ind += q_s_off;
     }
   }
 }
@@ -906,6 +960,9 @@ double dp3m_calc_kspace_forces(bool force_flag, bool energy_flag,
 
   /* === k-space force calculation  === */
   if (force_flag) {
+    /* the magnetic particles, in the order of the dipole fractions */
+    auto const dipolar = dipolar_particles(particles);
+
     /****************************
      * DIPOLAR TORQUES (k-space)
      ****************************/
@@ -971,7 +1028,7 @@ double dp3m_calc_kspace_forces(bool force_flag, bool energy_flag,
         /* Assign force component from mesh to particle */
         P3M_assign_torques(dipole_prefac *
                                (2 * Utils::pi() / box_geo.length()[0]),
-                           d_rs, particles);
+                           d_rs, dipolar);
       }
 #endif /*ifdef ROTATION */
 
@@ -1054,7 +1111,7 @@ double dp3m_calc_kspace_forces(bool force_flag, bool energy_flag,
         /* Assign force component from mesh to particle */
         dp3m_assign_forces_dip(
             dipole_prefac * pow(2 * Utils::pi() / box_geo.length()[0], 2), d_rs,
-            particles);
+            dipolar);
       }
     } /* if (dp3m.sum_mu2 > 0) */
   }   /* if (force_flag) */
@@ -131,6 +131,9 @@ int dp3m_set_mesh_offset(double x, double y, double z);
 /** @copydoc p3m_set_eps */
 int dp3m_set_eps(double eps);
 
+/** @copydoc p3m_set_overlap_fft_comm */
+int dp3m_set_overlap_fft_comm(bool overlap);
+
 /** Initialize all structures, parameters and arrays needed for the
  *  P3M algorithm for dipole-dipole interactions.
  */
@@ -301,6 +301,7 @@ void p3m_init() {
     p3m.send_grid.resize(p3m.sm.max);
     p3m.recv_grid.resize(p3m.sm.max);
 
+    p3m.fft.overlap_comm = p3m.params.overlap_fft_comm;
     int ca_mesh_size =
         fft_init(&p3m.rs_mesh, p3m.local_mesh.dim, p3m.local_mesh.margin,
                  p3m.params.mesh, p3m.params.mesh_off, &p3m.ks_pnum, p3m.fft,
@@ -413,6 +414,14 @@ int p3m_set_eps(double eps) {
   return ES_OK;
 }
 
+int p3m_set_overlap_fft_comm(bool overlap) {
+  p3m.params.overlap_fft_comm = overlap;
+
+  mpi_bcast_coulomb_params();
+
+  return ES_OK;
+}
+
 int p3m_set_ninterpol(int n) {
   if (n < 0)
     return ES_ERROR;
@@ -472,6 +481,50 @@ void p3m_charge_assign(const ParticleRange &particles) {
   }
 }
 
+/** Collect the charged particles, in the order of the charge fractions. */
+static std::vector<Particle *>
+charged_particles(const ParticleRange &particles) {
+  std::vector<Particle *> ret;
+  for (auto &p : particles) {
+    if (p.p.q != 0.0)
+      ret.push_back(&p);
+  }
+
+  return ret;
+}
+
+/** Assign the charges on several threads, see \ref p3m_sort_into_slabs.
+ *  @return The number of charged particles.
+ */
+template <int cao>
+static int p3m_do_charge_assign_parallel(const ParticleRange &particles) {
+  auto const charged = charged_particles(particles);
+  auto const n_charged = static_cast<int>(charged.size());
+
+  /* first mesh plane in the first direction of each charge */
+  std::vector<int> planes(n_charged);
+  for (int i = 0; i < n_charged; i++) {
+    planes[i] = (int)(((charged[i]->r.p[0] - p3m.local_mesh.ld_pos[0]) *
+                       p3m.params.ai[0]) -
+                      p3m.pos_shift);
+  }
+
+#ifdef P3M_STORE_CA_FRAC
+  /* the threads must not resize the charge fraction fields */
+  if (n_charged > p3m.ca_num)
+    p3m_realloc_ca_fields(n_charged);
+#endif
+
+  p3m_for_each_in_slabs(
+      p3m_sort_into_slabs(planes, cao, p3m.local_mesh.dim[0]),
+      [&charged](int cp_cnt) {
+        auto &p = *charged[cp_cnt];
+        p3m_do_assign_charge<cao>(p.p.q, p.r.p, cp_cnt);
+      });
+
+  return n_charged;
+}
+
 /** Assign the charges */
 template <int cao> void p3m_do_charge_assign(const ParticleRange &particles) {
   /* charged particle counter, charge fraction counter */
@@ -480,10 +533,14 @@ template <int cao> void p3m_do_charge_assign(const ParticleRange &particles) {
   for (int i = 0; i < p3m.local_mesh.size; i++)
     p3m.rs_mesh[i] = 0.0;
 
-  for (auto &p : particles) {
-    if (p.p.q != 0.0) {
-      p3m_do_assign_charge<cao>(p.p.q, p.r.p, cp_cnt);
-      cp_cnt++;
+  if (cell_structure.use_threads) {
+    cp_cnt = p3m_do_charge_assign_parallel<cao>(particles);
+  } else {
+    for (auto &p : particles) {
+      if (p.p.q != 0.0) {
+        p3m_do_assign_charge<cao>(p.p.q, p.r.p, cp_cnt);
+        cp_cnt++;
+      }
     }
   }
 
@@ -627,93 +684,88 @@ void p3m_shrink_wrap_charge_grid(int n_charges) {
 /* Assign the forces obtained from k-space */
 template <int cao>
 static void P3M_assign_forces(double force_prefac, int d_rs,
-                              const ParticleRange &particles) {
-  /* charged particle counter, charge fraction counter */
-  int cp_cnt = 0;
-#ifdef P3M_STORE_CA_FRAC
-  int cf_cnt = 0;
-#else
-  /* distance to nearest mesh point */
-  double dist[3];
-  /* index for caf interpolation grid */
-  int arg[3];
-#endif
-  /* index, index jumps for rs_mesh array */
-  int q_ind = 0;
+                              std::vector<Particle *> const &charged) {
+  auto const n_charged = static_cast<int>(charged.size());
 
-  for (auto &p : particles) {
+  /* the particles only write their own forces */
+#pragma omp parallel for if (cell_structure.use_threads)
+  for (int cp_cnt = 0; cp_cnt < n_charged; cp_cnt++) {
+    auto &p = *charged[cp_cnt];
     auto const q = p.p.q;
-    if (q != 0.0) {
+    /* index, index jumps for rs_mesh array */
+    int q_ind = 0;
 #ifdef P3M_STORE_CA_FRAC
-      q_ind = p3m.ca_fmp[cp_cnt];
+    /* charge fraction counter */
+    int cf_cnt = cp_cnt * cao * cao * cao;
+    q_ind = p3m.ca_fmp[cp_cnt];
+    for (int i0 = 0; i0 < cao; i0++) {
+      for (int i1 = 0; i1 < cao; i1++) {
+        for (int i2 = 0; i2 < cao; i2++) {
+          p.f.f[d_rs] -=
+              force_prefac * p3m.ca_frac[cf_cnt] * p3m.rs_mesh[q_ind];
+          q_ind++;
+          cf_cnt++;
+        }
+        q_ind += p3m.local_mesh.q_2_off;
+      }
+      q_ind += p3m.local_mesh.q_21_off;
+    }
+#else
+    /* distance to nearest mesh point */
+    double dist[3];
+    /* index for caf interpolation grid */
+    int arg[3];
+    double pos;
+    int nmp;
+    double tmp0, tmp1;
+    double cur_ca_frac_val;
+    for (int d = 0; d < 3; d++) {
+      /* particle position in mesh coordinates */
+      pos = ((p.r.p[d] - p3m.local_mesh.ld_pos[d]) * p3m.params.ai[d]) -
+            p3m.pos_shift;
+      /* nearest mesh point */
+      nmp = (int)pos;
+      /* 3d-array index of nearest mesh point */
+      q_ind = (d == 0) ? nmp : nmp + p3m.local_mesh.dim[d] * q_ind;
+
+      if (p3m.params.inter == 0)
+        /* distance to nearest mesh point */
+        dist[d] = (pos - nmp) - 0.5;
+      else
+        /* distance to nearest mesh point for interpolation */
+        arg[d] = (int)((pos - nmp) * p3m.params.inter2);
+    }
+
+    if (p3m.params.inter == 0) {
       for (int i0 = 0; i0 < cao; i0++) {
+        tmp0 = p3m_caf(i0, dist[0], cao);
         for (int i1 = 0; i1 < cao; i1++) {
+          tmp1 = tmp0 * p3m_caf(i1, dist[1], cao);
           for (int i2 = 0; i2 < cao; i2++) {
-            p.f.f[d_rs] -=
-                force_prefac * p3m.ca_frac[cf_cnt] * p3m.rs_mesh[q_ind];
+            cur_ca_frac_val = q * tmp1 * p3m_caf(i2, dist[2], cao);
+            p.f.f[d_rs] -= force_prefac * cur_ca_frac_val * p3m.rs_mesh[q_ind];
             q_ind++;
-            cf_cnt++;
           }
           q_ind += p3m.local_mesh.q_2_off;
         }
         q_ind += p3m.local_mesh.q_21_off;
       }
-      cp_cnt++;
-#else
-      double pos;
-      int nmp;
-      double tmp0, tmp1;
-      double cur_ca_frac_val;
-      for (int d = 0; d < 3; d++) {
-        /* particle position in mesh coordinates */
-        pos = ((p.r.p[d] - p3m.local_mesh.ld_pos[d]) * p3m.params.ai[d]) -
-              p3m.pos_shift;
-        /* nearest mesh point */
-        nmp = (int)pos;
-        /* 3d-array index of nearest mesh point */
-        q_ind = (d == 0) ? nmp : nmp + p3m.local_mesh.dim[d] * q_ind;
-
-        if (p3m.params.inter == 0)
-          /* distance to nearest mesh point */
-          dist[d] = (pos - nmp) - 0.5;
-        else
-          /* distance to nearest mesh point for interpolation */
-          arg[d] = (int)((pos - nmp) * p3m.params.inter2);
-      }
-
-      if (p3m.params.inter == 0) {
-        for (int i0 = 0; i0 < cao; i0++) {
-          tmp0 = p3m_caf(i0, dist[0], cao);
-          for (int i1 = 0; i1 < cao; i1++) {
-            tmp1 = tmp0 * p3m_caf(i1, dist[1], cao);
-            for (int i2 = 0; i2 < cao; i2++) {
-              cur_ca_frac_val = q * tmp1 * p3m_caf(i2, dist[2], cao);
-              p.f.f[d_rs] -=
-                  force_prefac * cur_ca_frac_val * p3m.rs_mesh[q_ind];
-              q_ind++;
-            }
-            q_ind += p3m.local_mesh.q_2_off;
-          }
-          q_ind += p3m.local_mesh.q_21_off;
-        }
-      } else {
-        for (int i0 = 0; i0 < cao; i0++) {
-          tmp0 = p3m.int_caf[i0][arg[0]];
-          for (int i1 = 0; i1 < cao; i1++) {
-            tmp1 = tmp0 * p3m.int_caf[i1][arg[1]];
-            for (int i2 = 0; i2 < cao; i2++) {
-              cur_ca_frac_val = q * tmp1 * p3m.int_caf[i2][arg[2]];
-              p.f.f[d_rs] -=
-                  force_prefac * cur_ca_frac_val * p3m.rs_mesh[q_ind];
-              q_ind++;
-            }
-            q_ind += p3m.local_mesh.q_2_off;
+    } else {
+      for (int i0 = 0; i0 < cao; i0++) {
+        tmp0 = p3m.int_caf[i0][arg[0]];
+        for (int i1 = 0; i1 < cao; i1++) {
+          tmp1 = tmp0 * p3m.int_caf[i1][arg[1]];
+          for (int i2 = 0; i2 < cao; i2++) {
+            cur_ca_frac_val = q * tmp1 * p3m.int_caf[i2][arg[2]];
+            p.f.f[d_rs] -= force_prefac * cur_ca_frac_val * p3m.rs_mesh[q_ind];
+            q_ind++;
           }
-          q_ind += p3m.local_mesh.q_21_off;
+          q_ind += p3m.local_mesh.q_2_off;
         }
+        q_ind += p3m.local_mesh.q_21_off;
       }
-#endif
     }
+#endif
   }
 }
 
@@ -788,6 +840,9 @@ double p3m_calc_kspace_forces(bool force_flag, bool energy_flag,
       ind++;
     }
 
+    /* the charged particles, in the order of the charge fractions */
+    auto const charged = charged_particles(particles);
+
     /* === 3 Fold backward 3D FFT (Force Component Meshes) === */
 
     /* Force component loop */
@@ -827,25 +882,25 @@ double p3m_calc_kspace_forces(bool force_flag, bool energy_flag,
       /* Assign force component from mesh to particle */
       switch (p3m.params.cao) {
       case 1:
-        P3M_assign_forces<1>(force_prefac, d_rs, particles);
+        P3M_assign_forces<1>(force_prefac, d_rs, charged);
         break;
       case 2:
-        P3M_assign_forces<2>(force_prefac, d_rs, particles);
+        P3M_assign_forces<2>(force_prefac, d_rs, charged);
         break;
       case 3:
-        P3M_assign_forces<3>(force_prefac, d_rs, particles);
+        P3M_assign_forces<3>(force_prefac, d_rs, charged);
         break;
       case 4:
-        P3M_assign_forces<4>(force_prefac, d_rs, particles);
+        P3M_assign_forces<4>(force_prefac, d_rs, charged);
         break;
       case 5:
-        P3M_assign_forces<5>(force_prefac, d_rs, particles);
+        P3M_assign_forces<5>(force_prefac, d_rs, charged);
         break;
       case 6:
-        P3M_assign_forces<6>(force_prefac, d_rs, particles);
+        P3M_assign_forces<6>(force_prefac, d_rs, charged);
         break;
       case 7:
-        P3M_assign_forces<7>(force_prefac, d_rs, particles);
+        P3M_assign_forces<7>(force_prefac, d_rs, charged);
         break;
       }
     }
@@ -280,6 +280,12 @@ int p3m_set_mesh_offset(double x, double y, double z);
  */
 int p3m_set_eps(double eps);
 
+/** Set @ref P3MParameters::overlap_fft_comm "overlap_fft_comm" parameter
+ *
+ *  @param[in]  overlap      @copybrief P3MParameters::overlap_fft_comm
+ */
+int p3m_set_overlap_fft_comm(bool overlap);
+
 /** Set @ref P3MParameters::inter "inter" parameter
  *
  *  @param[in]  n            @copybrief P3MParameters::inter
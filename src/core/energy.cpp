@@ -32,10 +32,17 @@
 #include "forces.hpp"
 
 #include "short_range_loop.hpp"
+#include "threads.hpp"
 
 #include "electrostatics_magnetostatics/coulomb.hpp"
 #include "electrostatics_magnetostatics/dipole.hpp"
 
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
 ActorList energyActors;
 
 Observable_stat energy{};
@@ -91,13 +98,41 @@ void energy_calc(double *result, const double time) {
 
   on_observable_calc();
 
-  short_range_loop(
-      [](Particle const &p) { add_single_particle_energy(p); },
-      [](Particle const &p1, Particle const &p2, Distance const &d) {
-        add_non_bonded_pair_energy(p1, p2, d.vec21, sqrt(d.dist2), d.dist2);
-      });
+  /* The energies of the threads are summed in an order that depends on
+   * the schedule, so with CellStructure::deterministic_threads they are
+   * calculated without threads to be identical to the serial run. */
+  if (cell_structure.use_threads and not cell_structure.deterministic_threads) {
+    /* Every thread sums into its own observable, the results are
+     * added up afterwards in the order of the threads. */
+    std::vector<Observable_stat> thread_energy(Threads::max_threads());
+    for (auto &e : thread_energy) {
+      init_energies(&e);
+    }
+
+    short_range_loop_parallel(
+        [&thread_energy](Particle const &p) {
+          add_single_particle_energy(p, thread_energy[Threads::thread_num()]);
+        },
+        [&thread_energy](Particle const &p1, Particle const &p2,
+                         Distance const &d) {
+          add_non_bonded_pair_energy(p1, p2, d.vec21, sqrt(d.dist2), d.dist2,
+                                     thread_energy[Threads::thread_num()]);
+        });
+
+    for (auto const &e : thread_energy) {
+      for (int i = 0; i < energy.data.n; i++) {
+        energy.data.e[i] += e.data.e[i];
+      }
+    }
+  } else {
+    short_range_loop(
+        [](Particle const &p) { add_single_particle_energy(p); },
+        [](Particle const &p1, Particle const &p2, Distance const &d) {
+          add_non_bonded_pair_energy(p1, p2, d.vec21, sqrt(d.dist2), d.dist2);
+        });
+  }
 
-  calc_long_range_energies(local_cells.particles());
+  calc_long_range_energies(local_cells.particles(), energy);
 
   auto local_parts = local_cells.particles();
   Constraints::constraints.add_energy(local_parts, time, energy);
@@ -113,17 +148,134 @@ void energy_calc(double *result, const double time) {
 
 /************************************************************/
 
-void calc_long_range_energies(const ParticleRange &particles) {
+void calc_long_range_energies(const ParticleRange &particles,
+                              Observable_stat &obs) {
 #ifdef ELECTROSTATICS
   /* calculate k-space part of electrostatic interaction. */
-  Coulomb::calc_energy_long_range(energy, particles);
+  Coulomb::calc_energy_long_range(obs, particles);
 #endif /* ifdef ELECTROSTATICS */
 
 #ifdef DIPOLES
-  Dipole::calc_energy_long_range(energy, particles);
+  Dipole::calc_energy_long_range(obs, particles);
 #endif /* ifdef DIPOLES */
 }
 
+/************************************************************/
+
+namespace {
+/** Whether a bond of @p p involves one of the particles in @p ids. */
+bool has_bond_partner_in(Particle const &p,
+                         std::unordered_set<int> const &ids) {
+  int i = 0;
+  while (i < p.bl.n) {
+    auto const n_partners = bonded_ia_params[p.bl.e[i++]].num;
+    for (int j = 0; j < n_partners; j++) {
+      if (ids.count(p.bl.e[i++]))
+        return true;
+    }
+  }
+  return false;
+}
+
+/** Cells that can hold interaction partners of particles in @p cell. */
+std::vector<Cell *> neighbor_cells(Cell *cell) {
+  std::vector<Cell *> cells{cell};
+  for (auto neighbor : cell->neighbors().all())
+    cells.push_back(neighbor);
+  std::sort(cells.begin(), cells.end());
+  cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+  return cells;
+}
+} // namespace
+
+/** Contribution of this node to @ref calculate_energy_of_particles. */
+static double local_energy_of_particles(std::vector<int> ids) {
+  if (!interactions_sanity_checks())
+    return 0.;
+
+  on_observable_calc();
+  cells_finish_ghost_update();
+
+  Observable_stat obs{};
+  init_energies(&obs);
+
+  std::unordered_set<int> const touched(ids.begin(), ids.end());
+
+  /* With the minimum image convention, every copy of a partner is the same
+   * pair. The ghosts of the other cell systems are shifted periodic images,
+   * so that for few cells per direction the same id can be found several
+   * times at different distances, and each of these is a pair of its own. */
+  auto const minimum_image = cell_structure.type == CELL_STRUCTURE_NSQUARE;
+
+  if (cell_structure.min_range != INACTIVE_CUTOFF) {
+    detail::decide_distance([&](auto const &distance_function) {
+      /* Positions are only folded and sorted into the cells on a resort,
+       * so a particle can have left the domain of its cell since then. Its
+       * partners are in the neighbors of the cell that stores it, not of
+       * the one its position belongs to. */
+      for (auto &cell : local_cells) {
+        for (auto const &p : cell->particles()) {
+          auto const id = p.identity();
+          if (!touched.count(id))
+            continue;
+
+          /* Pairs of two touched particles are done by the one with the
+           * smaller id. */
+          std::unordered_set<int> partners;
+          for (auto neighbor : neighbor_cells(cell)) {
+            for (auto const &q : neighbor->particles()) {
+              auto const q_id = q.identity();
+              if (q_id == id || (q_id < id && touched.count(q_id)) ||
+                  (minimum_image && !partners.insert(q_id).second))
+                continue;
+              auto const d = distance_function(p, q);
+              add_non_bonded_pair_energy(p, q, d.vec21, sqrt(d.dist2),
+                                         d.dist2, obs);
+            }
+          }
+        }
+      }
+    });
+  }
+
+  /* Bonds are stored with only one of their partners, so the bonds of all
+   * particles that point to a touched particle are added. */
+  if (!bonded_ia_params.empty()) {
+    for (auto const &p : local_cells.particles()) {
+      if (p.bl.n && (touched.count(p.identity()) ||
+                     has_bond_partner_in(p, touched)))
+        add_bonded_energy(&p, obs);
+    }
+  }
+
+  for (auto const id : touched) {
+    if (id >= 0 && id < max_local_particles && local_particles[id] &&
+        !local_particles[id]->l.ghost)
+      Constraints::constraints.add_energy(*local_particles[id], sim_time,
+                                          obs);
+  }
+
+  calc_long_range_energies(local_cells.particles(), obs);
+
+  /* everything but the kinetic energy */
+  double result = 0.;
+  for (int i = 1; i < obs.data.n; i++) {
+    result += obs.data.e[i];
+  }
+  return result;
+}
+
+REGISTER_CALLBACK_REDUCTION(local_energy_of_particles, std::plus<double>())
+
+double calculate_energy_of_particles(std::vector<int> const &ids) {
+  /* The energy actors can only compute the total energy */
+  if (!energyActors.empty())
+    return calculate_current_potential_energy_of_system();
+
+  return mpi_call(Communication::Result::reduction, std::plus<double>(),
+                  local_energy_of_particles, ids);
+}
+
 double calculate_current_potential_energy_of_system() {
   // calculate potential energy
   if (total_energy.init_status == 0) {
@@ -31,6 +31,8 @@
 #include "actor/ActorList.hpp"
 #include "statistics.hpp"
 
+#include <vector>
+
 /** \name Exported Variables */
 /************************************************************/
 /*@{*/
@@ -56,11 +58,25 @@ void master_energy_calc();
 void energy_calc(double *result, double time);
 
 /** Calculate long range energies (P3M, MMM2d...). */
-void calc_long_range_energies(const ParticleRange &particles);
+void calc_long_range_energies(const ParticleRange &particles,
+                              Observable_stat &obs);
 
 /** Calculate the total energy */
 double calculate_current_potential_energy_of_system();
 
+/** Potential energy of all interactions that involve at least one of the
+ *  given particles, plus the long-range energy of the whole system.
+ *
+ *  All other contributions to the energy do not depend on these
+ *  particles, so the difference of this quantity before and after a
+ *  change of the particles (position, type, charge, existence) equals the
+ *  change of @ref calculate_current_potential_energy_of_system. The
+ *  non-bonded pairs are only searched in the neighbor cells of the given
+ *  particles. Ids of particles that do not exist are ignored. Falls back
+ *  to the total energy if an energy actor is active.
+ */
+double calculate_energy_of_particles(std::vector<int> const &ids);
+
 /*@}*/
 
 #endif
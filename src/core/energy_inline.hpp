@@ -179,32 +179,36 @@ inline double calc_non_bonded_pair_energy(Particle const &p1,
  *  @param d         vector between p1 and p2.
  *  @param dist      distance between p1 and p2.
  *  @param dist2     distance squared between p1 and p2.
+ *  @param obs       observable to add to.
  */
 inline void add_non_bonded_pair_energy(Particle const &p1, Particle const &p2,
                                        Utils::Vector3d const &d,
-                                       double const dist, double const dist2) {
+                                       double const dist, double const dist2,
+                                       Observable_stat &obs = energy) {
   IA_parameters const &ia_params = *get_ia_param(p1.p.type, p2.p.type);
 
 #ifdef EXCLUSIONS
   if (do_nonbonded(p1, p2))
 #endif
-    *obsstat_nonbonded(&energy, p1.p.type, p2.p.type) +=
+    *obsstat_nonbonded(&obs, p1.p.type, p2.p.type) +=
         calc_non_bonded_pair_energy(p1, p2, ia_params, d, dist);
 
 #ifdef ELECTROSTATICS
-  energy.coulomb[0] +=
+  obs.coulomb[0] +=
       Coulomb::pair_energy(p1, p2, p1.p.q * p2.p.q, d, dist, dist2);
 #endif
 
 #ifdef DIPOLES
-  energy.dipolar[0] += Dipole::pair_energy(p1, p2, d, dist, dist2);
+  obs.dipolar[0] += Dipole::pair_energy(p1, p2, d, dist, dist2);
 #endif
 }
 
 /** Add bonded energies for one particle to the @ref energy observable.
  *  @param[in] p1   particle for which to calculate energies
+ *  @param[out] obs observable to add to
  */
-inline void add_bonded_energy(Particle const *const p1) {
+inline void add_bonded_energy(Particle const *const p1,
+                              Observable_stat &obs = energy) {
   int i = 0;
   while (i < p1->bl.n) {
     Particle const *p3 = nullptr;
@@ -343,7 +347,7 @@ inline void add_bonded_energy(Particle const *const p1) {
     } // 3 partners
 
     if (retval) {
-      *obsstat_bonded(&energy, type_num) += retval.get();
+      *obsstat_bonded(&obs, type_num) += retval.get();
     } else {
       switch (n_partners) {
       case 1:
@@ -369,8 +373,10 @@ inline void add_bonded_energy(Particle const *const p1) {
 
 /** Add kinetic energies for one particle to the @ref energy observable.
  *  @param[in] p1   particle for which to calculate energies
+ *  @param[out] obs observable to add to
  */
-inline void add_kinetic_energy(Particle const &p1) {
+inline void add_kinetic_energy(Particle const &p1,
+                               Observable_stat &obs = energy) {
 #ifdef VIRTUAL_SITES
   if (p1.p.is_virtual)
     return;
@@ -378,7 +384,7 @@ inline void add_kinetic_energy(Particle const &p1) {
 
   /* kinetic energy */
   if (not p1.p.is_virtual)
-    energy.data.e[0] += 0.5 * p1.p.mass * p1.m.v.norm2();
+    obs.data.e[0] += 0.5 * p1.p.mass * p1.m.v.norm2();
 
     // Note that rotational degrees of virtual sites are integrated
     // and therefore can contribute to kinetic energy
@@ -387,7 +393,7 @@ inline void add_kinetic_energy(Particle const &p1) {
     /* the rotational part is added to the total kinetic energy;
        Here we use the rotational inertia  */
 
-    energy.data.e[0] += 0.5 * (Utils::sqr(p1.m.omega[0]) * p1.p.rinertia[0] +
+    obs.data.e[0] += 0.5 * (Utils::sqr(p1.m.omega[0]) * p1.p.rinertia[0] +
                                Utils::sqr(p1.m.omega[1]) * p1.p.rinertia[1] +
                                Utils::sqr(p1.m.omega[2]) * p1.p.rinertia[2]);
   }
@@ -396,11 +402,13 @@ inline void add_kinetic_energy(Particle const &p1) {
 
 /** Add kinetic and bonded energies for one particle to the @ref energy
  *  observable.
- *  @param[in] p   particle for which to calculate energies
+ *  @param[in] p    particle for which to calculate energies
+ *  @param[out] obs observable to add to
  */
-inline void add_single_particle_energy(Particle const &p) {
-  add_kinetic_energy(p);
-  add_bonded_energy(&p);
+inline void add_single_particle_energy(Particle const &p,
+                                       Observable_stat &obs = energy) {
+  add_kinetic_energy(p, obs);
+  add_bonded_energy(&p, obs);
 }
 
 #endif // ENERGY_INLINE_HPP
@@ -41,6 +41,7 @@
 #include "grid_based_algorithms/lb_boundaries.hpp"
 #include "grid_based_algorithms/lb_interface.hpp"
 #include "immersed_boundaries.hpp"
+#include "load_balancing.hpp"
 #include "metadynamics.hpp"
 #include "npt.hpp"
 #include "nsquare.hpp"
@@ -245,6 +246,9 @@ void on_particle_change() {
 void on_coulomb_change() {
   invalidate_obs();
 
+  /* The grid based methods need the regular decomposition */
+  LoadBalancing::check_domains();
+
 #ifdef ELECTROSTATICS
   Coulomb::on_coulomb_change();
 #endif /* ELECTROSTATICS */
@@ -396,17 +400,20 @@ void on_parameter_change(int field) {
   case FIELD_NPTISO_PISTON:
     reinit_thermo = true;
     break;
-#ifdef NPT
   case FIELD_INTEG_SWITCH:
+#ifdef NPT
     if (integ_switch != INTEG_METHOD_NPT_ISO)
       nptiso.invalidate_p_vel = true;
-    break;
 #endif
+    /* The multiple time step integrator stores scaled forces */
+    recalc_forces = true;
+    break;
   case FIELD_THERMO_SWITCH:
     /* DPD needs ghost velocities, other thermostats not */
     on_ghost_flags_change();
     break;
   case FIELD_LATTICE_SWITCH:
+    LoadBalancing::check_domains();
     /* LB needs ghost velocities */
     on_ghost_flags_change();
     break;
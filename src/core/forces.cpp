@@ -40,11 +40,15 @@
 #include "grid_based_algorithms/lb_interface.hpp"
 #include "grid_based_algorithms/lb_particle_coupling.hpp"
 #include "immersed_boundaries.hpp"
+#include "integrators/respa.hpp"
+#include "load_balancing.hpp"
+#include "nonbonded_interactions/nonbonded_soa.hpp"
 #include "short_range_loop.hpp"
 
 #include <profiler/profiler.hpp>
 
 #include <cassert>
+#include <vector>
 
 ActorList forceActors;
 
@@ -79,6 +83,86 @@ void init_forces_ghosts(const ParticleRange &particles) {
   }
 }
 
+/** Whether the short-range force kernels only modify the particles
+ *  they are called with, so that they can run on several threads.
+ *  The NpT virial and the collision queue are shared between pairs.
+ */
+static bool short_range_forces_thread_safe() {
+#ifdef NPT
+  if (integ_switch == INTEG_METHOD_NPT_ISO)
+    return false;
+#endif
+#ifdef COLLISION_DETECTION
+  if (collision_params.mode != COLLISION_MODE_OFF)
+    return false;
+#endif
+  return true;
+}
+
+/** Add the forces of @p kernel multiplied by @p factor, leaving the
+ *  forces already present on the particles unscaled. Used by the
+ *  multiple time step integrator to apply slow forces as an impulse.
+ */
+template <class Kernel>
+static void add_scaled_forces(const ParticleRange &particles,
+                              const ParticleRange &ghosts, int factor,
+                              Kernel &&kernel) {
+  std::vector<ParticleForce> forces;
+  forces.reserve(particles.size() + ghosts.size());
+  for (auto range : {particles, ghosts}) {
+    for (auto &p : range) {
+      forces.push_back(p.f);
+      p.f = {};
+    }
+  }
+
+  kernel();
+
+  auto f = forces.begin();
+  for (auto range : {particles, ghosts}) {
+    for (auto &p : range) {
+      p.f.f = f->f + factor * p.f.f;
+#ifdef ROTATION
+      p.f.torque = f->torque + factor * p.f.torque;
+#endif
+      ++f;
+    }
+  }
+}
+
+/** Short-range forces for the multiple time step integrator: the bonded
+ *  forces every step, the non-bonded pair forces only every
+ *  @ref RespaParameters::short_range_steps "short_range_steps" steps.
+ */
+template <class VerletCriterion>
+static void add_respa_short_range_forces(CellStructure &cell_structure,
+                                         int factor,
+                                         VerletCriterion const &criterion) {
+  cells_finish_ghost_update();
+
+  auto particles = cell_structure.local_cells().particles();
+  if (factor > 0) {
+    add_scaled_forces(particles, cell_structure.ghost_cells().particles(),
+                      factor, [&criterion]() {
+                        short_range_loop(
+                            [](Particle &) {},
+                            [](Particle &p1, Particle &p2, Distance &d) {
+                              add_non_bonded_pair_force(p1, p2, d.vec21,
+                                                        sqrt(d.dist2), d.dist2);
+#ifdef COLLISION_DETECTION
+                              if (collision_params.mode != COLLISION_MODE_OFF)
+                                detect_collision(p1, p2, d.dist2);
+#endif
+                            },
+                            criterion);
+                      });
+  }
+
+  for (auto &p : particles) {
+    add_single_particle_force(p);
+  }
+}
+
 void force_calc(CellStructure &cell_structure) {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
 
@@ -91,6 +175,9 @@ void force_calc(CellStructure &cell_structure) {
   auto particles = cell_structure.local_cells().particles();
   auto ghost_particles = cell_structure.ghost_cells().particles();
 #ifdef ELECTROSTATICS
+  if (iccp3m_cfg.n_ic > 0) {
+    cells_finish_ghost_update();
+  }
   iccp3m_iteration(particles, cell_structure.ghost_cells().particles());
 #endif
   init_forces(particles);
@@ -102,7 +189,13 @@ void force_calc(CellStructure &cell_structure) {
 #endif
   }
 
-  calc_long_range_forces(particles);
+  auto const long_range_factor = respa_long_range_factor();
+  if (long_range_factor == 1) {
+    calc_long_range_forces(particles);
+  } else if (long_range_factor > 1) {
+    add_scaled_forces(particles, ghost_particles, long_range_factor,
+                      [&particles]() { calc_long_range_forces(particles); });
+  }
 
 #ifdef ELECTROSTATICS
   auto const coulomb_cutoff = Coulomb::cutoff(box_geo.length());
@@ -116,19 +209,43 @@ void force_calc(CellStructure &cell_structure) {
   auto const dipole_cutoff = INACTIVE_CUTOFF;
 #endif
 
-  short_range_loop(
-      [](Particle &p) { add_single_particle_force(p); },
-      [](Particle &p1, Particle &p2, Distance &d) {
-        add_non_bonded_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2);
+  auto const verlet_criterion =
+      VerletCriterion{skin, cell_structure.min_range, coulomb_cutoff,
+                      dipole_cutoff, collision_detection_cutoff()};
+
+  auto const short_range_start = MPI_Wtime();
+  auto const short_range_factor = respa_short_range_factor();
+  if (short_range_factor != 1) {
+    add_respa_short_range_forces(cell_structure, short_range_factor,
+                                 verlet_criterion);
+  } else if (SoA::pair_forces_applicable(cell_structure)) {
+    cells_finish_ghost_update();
+    for (auto &p : particles) {
+      add_single_particle_force(p);
+    }
+    SoA::add_pair_forces(cell_structure);
+  } else if (short_range_forces_thread_safe()) {
+    short_range_loop_parallel(
+        [](Particle &p) { add_single_particle_force(p); },
+        [](Particle &p1, Particle &p2, Distance &d) {
+          add_non_bonded_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2);
+        },
+        verlet_criterion);
+  } else {
+    short_range_loop(
+        [](Particle &p) { add_single_particle_force(p); },
+        [](Particle &p1, Particle &p2, Distance &d) {
+          add_non_bonded_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2);
 #ifdef COLLISION_DETECTION
-        if (collision_params.mode != COLLISION_MODE_OFF)
-          detect_collision(p1, p2, d.dist2);
+          if (collision_params.mode != COLLISION_MODE_OFF)
+            detect_collision(p1, p2, d.dist2);
 #endif
-      },
-      VerletCriterion{skin, cell_structure.min_range, coulomb_cutoff,
-                      dipole_cutoff, collision_detection_cutoff()});
+        },
+        verlet_criterion);
+  }
 
   Constraints::constraints.add_forces(particles, sim_time);
+  LoadBalancing::add_force_time(MPI_Wtime() - short_range_start);
 
 #ifdef OIF_GLOBAL_FORCES
   if (max_oif_objects) {
@@ -30,14 +30,19 @@
 #include "particle_data.hpp"
 
 #include <algorithm>
+#include <climits>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <map>
 #include <mpi.h>
+#include <unordered_set>
 #include <vector>
 
 /** Tag for communication in ghost_comm. */
 #define REQ_GHOST_SEND 100
+/** Tag for communication with the cached communication plans. */
+#define REQ_GHOST_PLAN 101
 
 static int n_s_buffer = 0;
 static int max_s_buffer = 0;
@@ -60,8 +65,11 @@ std::vector<int> r_bondbuffer;
 bool ghosts_have_v = false;
 bool ghosts_have_bonds = false;
 
+static void release_plan(GhostCommunicator const *gc);
+
 void prepare_comm(GhostCommunicator *comm, int data_parts, int num) {
   assert(comm);
+  release_plan(comm);
   comm->data_parts = data_parts;
   comm->num = num;
   comm->comm.resize(num);
@@ -74,10 +82,28 @@ void prepare_comm(GhostCommunicator *comm, int data_parts, int num) {
 }
 
 void free_comm(GhostCommunicator *comm) {
+  release_plan(comm);
   for (int n = 0; n < comm->num; n++)
     free(comm->comm[n].part_lists);
 }
 
+/** Size of the position data of a particle in a message. Without the
+ *  particle properties, the ghosts already exist and only their
+ *  coordinates and orientation are updated. The other members of
+ *  \ref ParticlePosition are only needed for the local particles, or are
+ *  set up for the ghosts locally, cf. save_old_pos().
+ */
+static int position_transmit_size(int data_parts) {
+  if (data_parts & GHOSTTRANS_PROPRTS)
+    return sizeof(ParticlePosition);
+
+  int size = sizeof(Utils::Vector3d);
+#ifdef ROTATION
+  size += sizeof(Utils::Vector4d);
+#endif
+  return size;
+}
+
 int calc_transmit_size(GhostCommunication *gc, int data_parts) {
   int n_buffer_new;
 
@@ -97,7 +123,7 @@ int calc_transmit_size(GhostCommunication *gc, int data_parts) {
       }
     }
     if (data_parts & GHOSTTRANS_POSITION)
-      n_buffer_new += sizeof(ParticlePosition);
+      n_buffer_new += position_transmit_size(data_parts);
     if (data_parts & GHOSTTRANS_MOMENTUM)
       n_buffer_new += sizeof(ParticleMomentum);
     if (data_parts & GHOSTTRANS_FORCE)
@@ -115,18 +141,52 @@ int calc_transmit_size(GhostCommunication *gc, int data_parts) {
   return n_buffer_new;
 }
 
-void prepare_send_buffer(GhostCommunication *gc, int data_parts) {
-  /* reallocate send buffer */
-  n_s_buffer = calc_transmit_size(gc, data_parts);
-  if (n_s_buffer > max_s_buffer) {
-    max_s_buffer = n_s_buffer;
-    s_buffer = Utils::realloc(s_buffer, max_s_buffer);
+static char *pack_position(char *insert, ParticlePosition const &r,
+                           Utils::Vector3d const &shift, int data_parts) {
+  if (data_parts & GHOSTTRANS_PROPRTS) {
+    auto pp = r;
+    if (data_parts & GHOSTTRANS_POSSHFTD)
+      pp.p += shift;
+    memcpy(insert, &pp, sizeof(pp));
+    return insert + sizeof(ParticlePosition);
   }
 
+  auto const pos = (data_parts & GHOSTTRANS_POSSHFTD) ? r.p + shift : r.p;
+  memcpy(insert, &pos, sizeof(pos));
+  insert += sizeof(pos);
+#ifdef ROTATION
+  memcpy(insert, &r.quat, sizeof(r.quat));
+  insert += sizeof(r.quat);
+#endif
+  return insert;
+}
+
+static char const *unpack_position(char const *retrieve, ParticlePosition &r,
+                                   int data_parts) {
+  if (data_parts & GHOSTTRANS_PROPRTS) {
+    memcpy(&r, retrieve, sizeof(ParticlePosition));
+    return retrieve + sizeof(ParticlePosition);
+  }
+
+  memcpy(&r.p, retrieve, sizeof(r.p));
+  retrieve += sizeof(r.p);
+#ifdef ROTATION
+  memcpy(&r.quat, retrieve, sizeof(r.quat));
+  retrieve += sizeof(r.quat);
+#endif
+  return retrieve;
+}
+
+/** Pack the data of the particles of a communication into @p buffer,
+ *  which has to be of size calc_transmit_size(gc, data_parts). The bond
+ *  lists go to \ref s_bondbuffer.
+ */
+static void pack_particles(GhostCommunication *gc, int data_parts,
+                           char *buffer, int size) {
   s_bondbuffer.resize(0);
 
   /* put in data */
-  char *insert = s_buffer;
+  char *insert = buffer;
   for (int pl = 0; pl < gc->n_part_lists; pl++) {
     int np = gc->part_lists[pl]->n;
     if (data_parts & GHOSTTRANS_PARTNUM) {
@@ -148,15 +208,8 @@ void prepare_send_buffer(GhostCommunication *gc, int data_parts) {
             }
           }
         }
-        if (data_parts & GHOSTTRANS_POSSHFTD) {
-          /* ok, this is not nice, but perhaps fast */
-          auto pp = pt.r;
-          pp.p += gc->shift;
-          memcpy(insert, &pp, sizeof(pp));
-          insert += sizeof(ParticlePosition);
-        } else if (data_parts & GHOSTTRANS_POSITION) {
-          memcpy(insert, &pt.r, sizeof(ParticlePosition));
-          insert += sizeof(ParticlePosition);
+        if (data_parts & GHOSTTRANS_POSITION) {
+          insert = pack_position(insert, pt.r, gc->shift, data_parts);
         }
         if (data_parts & GHOSTTRANS_MOMENTUM) {
           memcpy(insert, &pt.m, sizeof(ParticleMomentum));
@@ -181,15 +234,26 @@ void prepare_send_buffer(GhostCommunication *gc, int data_parts) {
     insert += sizeof(int);
   }
 
-  if (insert - s_buffer != n_s_buffer) {
+  if (insert - buffer != size) {
     fprintf(stderr,
             "%d: INTERNAL ERROR: send buffer size %d "
             "differs from what I put in (%td)\n",
-            this_node, n_s_buffer, insert - s_buffer);
+            this_node, size, insert - buffer);
     errexit();
   }
 }
 
+void prepare_send_buffer(GhostCommunication *gc, int data_parts) {
+  /* reallocate send buffer */
+  n_s_buffer = calc_transmit_size(gc, data_parts);
+  if (n_s_buffer > max_s_buffer) {
+    max_s_buffer = n_s_buffer;
+    s_buffer = Utils::realloc(s_buffer, max_s_buffer);
+  }
+
+  pack_particles(gc, data_parts, s_buffer, n_s_buffer);
+}
+
 static void prepare_ghost_cell(Cell *cell, int size) {
   using Utils::make_span;
   auto const old_cap = cell->max;
@@ -224,16 +288,21 @@ void prepare_recv_buffer(GhostCommunication *gc, int data_parts) {
   }
 }
 
-void put_recv_buffer(GhostCommunication *gc, int data_parts) {
+/** Unpack the data of the particles of a communication from @p buffer,
+ *  the inverse of pack_particles(). The bond lists are taken from
+ *  \ref r_bondbuffer.
+ */
+static void unpack_particles(GhostCommunication *gc, int data_parts,
+                             char const *buffer, int size) {
   /* put back data */
-  char *retrieve = r_buffer;
+  char const *retrieve = buffer;
 
   std::vector<int>::const_iterator bond_retrieve = r_bondbuffer.begin();
 
   for (int pl = 0; pl < gc->n_part_lists; pl++) {
     auto cur_list = gc->part_lists[pl];
     if (data_parts & GHOSTTRANS_PARTNUM) {
-      prepare_ghost_cell(cur_list, *(int *)retrieve);
+      prepare_ghost_cell(cur_list, *(int const *)retrieve);
       retrieve += sizeof(int);
     } else {
       int np = cur_list->n;
@@ -256,8 +325,7 @@ void put_recv_buffer(GhostCommunication *gc, int data_parts) {
           }
         }
         if (data_parts & GHOSTTRANS_POSITION) {
-          memcpy(&pt.r, retrieve, sizeof(ParticlePosition));
-          retrieve += sizeof(ParticlePosition);
+          retrieve = unpack_position(retrieve, pt.r, data_parts);
         }
         if (data_parts & GHOSTTRANS_MOMENTUM) {
           memcpy(&pt.m, retrieve, sizeof(ParticleMomentum));
@@ -283,11 +351,11 @@ void put_recv_buffer(GhostCommunication *gc, int data_parts) {
     retrieve += sizeof(int);
   }
 
-  if (retrieve - r_buffer != n_r_buffer) {
+  if (retrieve - buffer != size) {
     fprintf(stderr,
             "%d: recv buffer size %d differs "
             "from what I read out (%td)\n",
-            this_node, n_r_buffer, retrieve - r_buffer);
+            this_node, size, retrieve - buffer);
     errexit();
   }
   if (bond_retrieve != r_bondbuffer.end()) {
@@ -299,9 +367,14 @@ void put_recv_buffer(GhostCommunication *gc, int data_parts) {
   r_bondbuffer.resize(0);
 }
 
-void add_forces_from_recv_buffer(GhostCommunication *gc) {
+void put_recv_buffer(GhostCommunication *gc, int data_parts) {
+  unpack_particles(gc, data_parts, r_buffer, n_r_buffer);
+}
+
+/** Add the forces in @p buffer to the particles of a communication. */
+static void add_forces(GhostCommunication *gc, char const *buffer, int size) {
   /* put back data */
-  char *retrieve = r_buffer;
+  char const *retrieve = buffer;
   for (int pl = 0; pl < gc->n_part_lists; pl++) {
     int np = gc->part_lists[pl]->n;
     Particle *part = gc->part_lists[pl]->part;
@@ -313,15 +386,19 @@ void add_forces_from_recv_buffer(GhostCommunication *gc) {
       retrieve += sizeof(ParticleForce);
     }
   }
-  if (retrieve - r_buffer != n_r_buffer) {
+  if (retrieve - buffer != size) {
     fprintf(stderr,
             "%d: recv buffer size %d differs "
             "from what I put in %td\n",
-            this_node, n_r_buffer, retrieve - r_buffer);
+            this_node, size, retrieve - buffer);
     errexit();
   }
 }
 
+void add_forces_from_recv_buffer(GhostCommunication *gc) {
+  add_forces(gc, r_buffer, n_r_buffer);
+}
+
 void cell_cell_transfer(GhostCommunication *gc, int data_parts) {
   /* transfer data */
   int const offset = gc->n_part_lists / 2;
@@ -344,12 +421,18 @@ void cell_cell_transfer(GhostCommunication *gc, int data_parts) {
             pt2.bl = pt1.bl;
           }
         }
-        if (data_parts & GHOSTTRANS_POSSHFTD) {
-          /* ok, this is not nice, but perhaps fast */
-          pt2.r = pt1.r;
-          pt2.r.p += gc->shift;
-        } else if (data_parts & GHOSTTRANS_POSITION)
-          pt2.r = pt1.r;
+        if (data_parts & GHOSTTRANS_POSITION) {
+          if (data_parts & GHOSTTRANS_PROPRTS) {
+            pt2.r = pt1.r;
+          } else {
+            pt2.r.p = pt1.r.p;
+#ifdef ROTATION
+            pt2.r.quat = pt1.r.quat;
+#endif
+          }
+          if (data_parts & GHOSTTRANS_POSSHFTD)
+            pt2.r.p += gc->shift;
+        }
         if (data_parts & GHOSTTRANS_MOMENTUM) {
           pt2.m = pt1.m;
         }
@@ -391,6 +474,204 @@ static int is_recv_op(int comm_type, int node) {
           (comm_type == GHOST_RDCE && node == this_node));
 }
 
+namespace {
+/** Message buffers and persistent MPI requests of a ghost communicator,
+ *  one per communication. The requests stay valid as long as the message
+ *  sizes do not change, i.e. between two resorts of the particles.
+ *  Requests of local communications are MPI_REQUEST_NULL.
+ */
+struct CommunicationPlan {
+  std::vector<std::vector<char>> buffers;
+  std::vector<MPI_Request> requests;
+};
+
+/** Plans by communicator and data parts, since the message sizes depend
+ *  on the data parts.
+ */
+std::map<std::pair<GhostCommunicator const *, int>, CommunicationPlan> plans;
+
+/** State of a ghost communication done with a plan. */
+struct CommunicationRun {
+  GhostCommunicator *gc = nullptr;
+  CommunicationPlan *plan = nullptr;
+  int data_parts = 0;
+  /** Index of the first communication that has not been started. */
+  int next = 0;
+  /** Communications with receives in flight. */
+  std::vector<int> recv_comms;
+  /** Cells that are going to be written by the receives. */
+  std::unordered_set<Cell const *> incoming;
+};
+
+/** Communication started by \ref ghost_communicator_begin. */
+CommunicationRun pending;
+
+/** Whether a communication can be done with a plan. This is the case for
+ *  point-to-point and local communications that do not change the
+ *  ghost layout, i.e. for everything but the ghost exchange after a resort.
+ */
+bool has_plan(GhostCommunicator const *gc, int data_parts) {
+  if (data_parts & (GHOSTTRANS_PROPRTS | GHOSTTRANS_PARTNUM))
+    return false;
+
+  return std::all_of(gc->comm.begin(), gc->comm.begin() + gc->num,
+                     [](GhostCommunication const &gcn) {
+                       auto const comm_type = gcn.type & GHOST_JOBMASK;
+                       return comm_type == GHOST_SEND ||
+                              comm_type == GHOST_RECV ||
+                              comm_type == GHOST_LOCL;
+                     });
+}
+
+CommunicationPlan &get_plan(GhostCommunicator const *gc, int data_parts) {
+  auto &plan = plans[{gc, data_parts}];
+  plan.buffers.resize(gc->num);
+  plan.requests.resize(gc->num, MPI_REQUEST_NULL);
+
+  return plan;
+}
+
+/** Get the buffer of communication @p n of a plan for a message of
+ *  @p size bytes. The persistent request is (re-)created if the size
+ *  has changed.
+ */
+std::vector<char> &get_buffer(CommunicationPlan &plan, int n,
+                              GhostCommunication const &gcn, int size) {
+  auto &buffer = plan.buffers[n];
+  auto &request = plan.requests[n];
+
+  if (request == MPI_REQUEST_NULL || buffer.size() != size) {
+    if (request != MPI_REQUEST_NULL)
+      MPI_Request_free(&request);
+
+    buffer.resize(size);
+    if ((gcn.type & GHOST_JOBMASK) == GHOST_SEND)
+      MPI_Send_init(buffer.data(), size, MPI_BYTE, gcn.node, REQ_GHOST_PLAN,
+                    comm_cart, &request);
+    else
+      MPI_Recv_init(buffer.data(), size, MPI_BYTE, gcn.node, REQ_GHOST_PLAN,
+                    comm_cart, &request);
+  }
+
+  return buffer;
+}
+
+/** Whether a communication reads cells that are still in transit. */
+bool depends_on_incoming(CommunicationRun const &run,
+                         GhostCommunication const &gcn) {
+  /* For local transfers, only the first half are source cells */
+  auto const n_src = ((gcn.type & GHOST_JOBMASK) == GHOST_LOCL)
+                         ? gcn.n_part_lists / 2
+                         : gcn.n_part_lists;
+
+  return std::any_of(
+      gcn.part_lists, gcn.part_lists + n_src,
+      [&run](Cell const *c) { return run.incoming.count(c) != 0; });
+}
+
+/** Wait for all receives in flight and write back their data. */
+void finish_receives(CommunicationRun &run) {
+  for (auto const n : run.recv_comms) {
+    MPI_Wait(&run.plan->requests[n], MPI_STATUS_IGNORE);
+
+    auto const &buffer = run.plan->buffers[n];
+    /* forces have to be added, the rest overwritten. */
+    if (run.data_parts == GHOSTTRANS_FORCE)
+      add_forces(&run.gc->comm[n], buffer.data(),
+                 static_cast<int>(buffer.size()));
+    else
+      unpack_particles(&run.gc->comm[n], run.data_parts, buffer.data(),
+                       static_cast<int>(buffer.size()));
+  }
+
+  run.recv_comms.clear();
+  run.incoming.clear();
+}
+
+/** Start communication @p n of a run. */
+void start_communication(CommunicationRun &run, int n) {
+  GhostCommunication *gcn = &run.gc->comm[n];
+
+  switch (gcn->type & GHOST_JOBMASK) {
+  case GHOST_LOCL:
+    cell_cell_transfer(gcn, run.data_parts);
+    break;
+  case GHOST_SEND: {
+    auto const size = calc_transmit_size(gcn, run.data_parts);
+    auto &buffer = get_buffer(*run.plan, n, *gcn, size);
+    pack_particles(gcn, run.data_parts, buffer.data(), size);
+    MPI_Start(&run.plan->requests[n]);
+    break;
+  }
+  case GHOST_RECV: {
+    get_buffer(*run.plan, n, *gcn, calc_transmit_size(gcn, run.data_parts));
+    MPI_Start(&run.plan->requests[n]);
+    run.recv_comms.push_back(n);
+    run.incoming.insert(gcn->part_lists, gcn->part_lists + gcn->n_part_lists);
+    break;
+  }
+  default:
+    fprintf(stderr,
+            "%d: INTERNAL ERROR: ghost communication type %d "
+            "cannot be done with a plan\n",
+            this_node, gcn->type);
+    errexit();
+  }
+}
+
+/** Start the communications of a run in order. If @p wait is false, stop
+ *  at the first one that depends on data in transit, otherwise wait for
+ *  the data and go on.
+ */
+void advance_communications(CommunicationRun &run, bool wait) {
+  for (; run.next < run.gc->num; run.next++) {
+    if (depends_on_incoming(run, run.gc->comm[run.next])) {
+      if (not wait)
+        return;
+
+      finish_receives(run);
+    }
+
+    start_communication(run, run.next);
+  }
+}
+
+void start_run(CommunicationRun &run, GhostCommunicator *gc, int data_parts) {
+  run.gc = gc;
+  run.plan = &get_plan(gc, data_parts);
+  run.data_parts = data_parts;
+  run.next = 0;
+
+  advance_communications(run, false);
+}
+
+void finish_run(CommunicationRun &run) {
+  advance_communications(run, true);
+  finish_receives(run);
+
+  /* Inactive requests complete immediately */
+  MPI_Waitall(static_cast<int>(run.plan->requests.size()),
+              run.plan->requests.data(), MPI_STATUSES_IGNORE);
+
+  run.gc = nullptr;
+}
+} // namespace
+
+static void release_plan(GhostCommunicator const *gc) {
+  assert(pending.gc != gc);
+
+  auto const first = plans.lower_bound({gc, INT_MIN});
+  auto const last = plans.upper_bound({gc, INT_MAX});
+
+  for (auto it = first; it != last; ++it) {
+    for (auto &request : it->second.requests) {
+      if (request != MPI_REQUEST_NULL)
+        MPI_Request_free(&request);
+    }
+  }
+  plans.erase(first, last);
+}
+
 void ghost_communicator(GhostCommunicator *gc) {
   ghost_communicator(gc, gc->data_parts);
 }
@@ -402,6 +683,15 @@ void ghost_communicator(GhostCommunicator *gc, int data_parts) {
   if (ghosts_have_v && (data_parts & GHOSTTRANS_POSITION))
     data_parts |= GHOSTTRANS_MOMENTUM;
 
+  if (has_plan(gc, data_parts)) {
+    assert(pending.gc != gc);
+
+    CommunicationRun run;
+    start_run(run, gc, data_parts);
+    finish_run(run);
+    return;
+  }
+
   for (int n = 0; n < gc->num; n++) {
     GhostCommunication *gcn = &gc->comm[n];
     int const comm_type = gcn->type & GHOST_JOBMASK;
@@ -562,3 +852,22 @@ void ghost_communicator(GhostCommunicator *gc, int data_parts) {
     }
   }
 }
+
+/************************************************************/
+
+void ghost_communicator_begin(GhostCommunicator *gc) {
+  assert(not pending.gc);
+
+  int data_parts = gc->data_parts;
+  if (ghosts_have_v && (data_parts & GHOSTTRANS_POSITION))
+    data_parts |= GHOSTTRANS_MOMENTUM;
+  assert(has_plan(gc, data_parts));
+
+  start_run(pending, gc, data_parts);
+}
+
+void ghost_communicator_finish() {
+  assert(pending.gc);
+
+  finish_run(pending);
+}
@@ -92,6 +92,14 @@ communication step, thereby reducing the latency a little bit. The pststore is
 similar and postpones the write back of received data until a send operation
 (with a precreated send buffer) is finished.
 
+Communicators that only consist of GHOST_SEND, GHOST_RECV and GHOST_LOCL
+communications and do not transfer GHOSTTRANS_PROPRTS or GHOSTTRANS_PARTNUM,
+i.e. the position updates and force collections between two resorts, keep
+their message buffers and persistent MPI requests from call to call. Since
+the ghosts already exist, their position updates only transfer the
+coordinates and the orientation of the particles, not the whole
+\ref ParticlePosition.
+
 The ghost communicators are created in the init routines of the cell systems,
 therefore have a look at \ref dd_topology_init or \ref nsq_topology_init for
 further details.
@@ -209,6 +217,26 @@ void ghost_communicator(GhostCommunicator *gc);
  */
 void ghost_communicator(GhostCommunicator *gc, int data_parts);
 
+/**
+ * @brief Start a ghost communication without waiting for the data.
+ *
+ * All communications of @p gc that do not depend on data in transit
+ * are started with non-blocking MPI calls, the rest is done by
+ * \ref ghost_communicator_finish. In between, the cells that are
+ * received must not be accessed. Only point-to-point and local
+ * communications without \ref GHOSTTRANS_PROPRTS and
+ * \ref GHOSTTRANS_PARTNUM are supported, i.e. updates of the ghost
+ * positions and force collections. Only one communication can be in
+ * progress at a time.
+ */
+void ghost_communicator_begin(GhostCommunicator *gc);
+
+/**
+ * @brief Complete the communication started by
+ *        \ref ghost_communicator_begin.
+ */
+void ghost_communicator_finish();
+
 /*@}*/
 
 #endif
@@ -33,6 +33,8 @@
 #include <mpi.h>
 #include <utils/mpi/cart_comm.hpp>
 
+#include <algorithm>
+
 /**********************************************
  * variables
  **********************************************/
@@ -42,6 +44,10 @@ LocalBox<double> local_geo;
 
 Utils::Vector3i node_grid{};
 
+namespace {
+std::array<std::vector<double>, 3> cuts;
+}
+
 /************************************************************/
 
 void init_node_grid() {
@@ -54,7 +60,15 @@ int map_position_node_array(const Utils::Vector3d &pos) {
 
   Utils::Vector3i im;
   for (int i = 0; i < 3; i++) {
-    im[i] = std::floor(f_pos[i] / local_geo.length()[i]);
+    if (cuts[i].empty()) {
+      im[i] = std::floor(f_pos[i] / local_geo.length()[i]);
+    } else {
+      auto const rel_pos = f_pos[i] / box_geo.length()[i];
+      im[i] = std::distance(cuts[i].begin(), std::upper_bound(cuts[i].begin(),
+                                                              cuts[i].end(),
+                                                              rel_pos)) -
+              1;
+    }
     im[i] = boost::algorithm::clamp(im[i], 0, node_grid[i] - 1);
   }
 
@@ -99,8 +113,37 @@ LocalBox<double> regular_decomposition(const BoxGeometry &box,
   return {my_left, local_length, boundaries};
 }
 
+LocalBox<double>
+rectilinear_decomposition(const BoxGeometry &box,
+                          Utils::Vector3i const &node_pos,
+                          Utils::Vector3i const &node_grid,
+                          std::array<std::vector<double>, 3> const &cuts) {
+  auto const regular = regular_decomposition(box, node_pos, node_grid);
+
+  auto my_left = regular.my_left();
+  auto local_length = regular.length();
+  for (int i = 0; i < 3; i++) {
+    if (not cuts[i].empty()) {
+      assert(cuts[i].size() == node_grid[i] + 1);
+      my_left[i] = cuts[i][node_pos[i]] * box.length()[i];
+      local_length[i] =
+          (cuts[i][node_pos[i] + 1] - cuts[i][node_pos[i]]) * box.length()[i];
+    }
+  }
+
+  return {my_left, local_length, regular.boundary()};
+}
+
+std::array<std::vector<double>, 3> const &domain_cuts() { return cuts; }
+
+void set_domain_cuts(std::array<std::vector<double>, 3> const &new_cuts) {
+  cuts = new_cuts;
+  grid_changed_box_l(box_geo);
+}
+
 void grid_changed_box_l(const BoxGeometry &box) {
-  local_geo = regular_decomposition(box, calc_node_pos(comm_cart), node_grid);
+  local_geo = rectilinear_decomposition(box, calc_node_pos(comm_cart),
+                                        node_grid, cuts);
 }
 
 void grid_changed_n_nodes() {
@@ -111,6 +154,9 @@ void grid_changed_n_nodes() {
 
   calc_node_neighbors(comm_cart);
 
+  /* The cuts are only valid for the old node grid */
+  cuts = {};
+
   grid_changed_box_l(box_geo);
 }
 
@@ -40,8 +40,10 @@
 #include <utils/Vector.hpp>
 
 #include <boost/mpi/communicator.hpp>
+#include <array>
 #include <cassert>
 #include <limits>
+#include <vector>
 
 extern BoxGeometry box_geo;
 extern LocalBox<double> local_geo;
@@ -63,6 +65,23 @@ extern Utils::Vector3i node_grid;
     determine one automatically. */
 void init_node_grid();
 
+/** Boundaries between the node domains.
+ *
+ *  For each direction, either empty if the box is divided into equal
+ *  parts, or the node_grid[i] + 1 positions of the boundaries in units
+ *  of the box length, starting with 0 and ending with 1. All nodes in
+ *  the same layer of the node grid have the same extent in that
+ *  direction, see \ref rectilinear_decomposition.
+ */
+std::array<std::vector<double>, 3> const &domain_cuts();
+
+/** Set the boundaries between the node domains and update
+ *  \ref local_geo, see \ref domain_cuts. Has to be called on all nodes
+ *  with the same value, the cell system has to be re-initialized
+ *  afterwards.
+ */
+void set_domain_cuts(std::array<std::vector<double>, 3> const &cuts);
+
 /** map a spatial position to the node grid */
 int map_position_node_array(const Utils::Vector3d &pos);
 
@@ -188,5 +207,23 @@ inline Utils::Vector3d unfolded_position(const Utils::Vector3d &pos,
 LocalBox<double> regular_decomposition(const BoxGeometry &box,
                                        Utils::Vector3i const &node_pos,
                                        Utils::Vector3i const &node_grid);
+
+/**
+ * @brief Composition of the simulation box into slabs of different width
+ *        in each direction.
+ *
+ * Same as @ref regular_decomposition for directions without cuts.
+ *
+ * @param box Geometry of the simulation box
+ * @param node_pos Position of node in the node grid
+ * @param node_grid Nodes in each direction
+ * @param cuts Boundaries of the slabs, see @ref domain_cuts
+ * @return Geometry for the node
+ */
+LocalBox<double>
+rectilinear_decomposition(const BoxGeometry &box,
+                          Utils::Vector3i const &node_pos,
+                          Utils::Vector3i const &node_grid,
+                          std::array<std::vector<double>, 3> const &cuts);
 /*@}*/
 #endif
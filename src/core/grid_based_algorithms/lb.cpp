@@ -47,6 +47,7 @@
 #include <utils/Counter.hpp>
 #include <utils/index.hpp>
 #include <utils/math/matrix_vector_product.hpp>
+#include <utils/mpi/cart_comm.hpp>
 #include <utils/uniform.hpp>
 using Utils::get_linear_index;
 #include <utils/constants.hpp>
@@ -57,10 +58,12 @@ using Utils::get_linear_index;
 #include <mpi.h>
 #include <profiler/profiler.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 
 namespace {
 /** Basis of the mode space as described in [Duenweg, Schiller, Ladd] */
@@ -107,6 +110,8 @@ extern constexpr const std::array<std::array<int, 19>, 19> e_ki_transposed = {
      {{1, 0, -1, 1, 1, -1, -1, 0, 0, -1, 0, -1, 1, 0, 1, -1, 1, -1, -1}}}};
 } // namespace
 
+static void lb_realloc_populations(bool in_place);
+
 void lb_on_param_change(LBParam param) {
   switch (param) {
   case LBParam::AGRID:
@@ -124,6 +129,9 @@ void lb_on_param_change(LBParam param) {
   case LBParam::GAMMA_EVEN:
   case LBParam::TAU:
     break;
+  case LBParam::IN_PLACE_STREAMING:
+    lb_realloc_populations(lbpar.in_place_streaming);
+    break;
   }
   lb_reinit_parameters(lbpar);
 }
@@ -161,7 +169,9 @@ LB_Parameters lbpar = {
     // phi
     {},
     // Thermal energy
-    0.0};
+    0.0,
+    // in_place_streaming
+    false};
 
 Lattice lblattice;
 
@@ -178,6 +188,20 @@ LB_Fluid lbfluid_post;
 
 std::vector<LB_FluidNode> lbfields;
 
+/** Contiguous runs of fluid nodes along the x-rows of the local lattice
+ *  (halo excluded), see @ref lb_update_fluid_node_lists. The border runs
+ *  hold the nodes that stream into the halo, the bulk runs all others.
+ */
+static std::vector<LB_Fluid_Run> border_runs;
+static std::vector<LB_Fluid_Run> bulk_runs;
+
+#ifdef LB_BOUNDARIES
+/** Links along which populations stream from the local lattice into
+ *  boundary nodes, see @ref lb_update_fluid_node_lists.
+ */
+static std::vector<LB_Boundary_Link> boundary_links;
+#endif // LB_BOUNDARIES
+
 HaloCommunicator update_halo_comm = HaloCommunicator(0);
 
 /** measures the MD time since the last fluid update */
@@ -201,21 +225,100 @@ void lb_initialize_fields(std::vector<LB_FluidNode> &fields,
     field.boundary = false;
 #endif // LB_BOUNDARIES
   }
+  lb_update_fluid_node_lists(fields, lb_lattice);
+}
+
+void lb_update_fluid_node_lists(const std::vector<LB_FluidNode> &lb_fields,
+                                const Lattice &lb_lattice) {
+  auto is_fluid = [&lb_fields](Lattice::index_t index) {
+#ifdef LB_BOUNDARIES
+    return not lb_fields[index].boundary;
+#else
+    return true;
+#endif // LB_BOUNDARIES
+  };
+
+  auto const &grid = lb_lattice.grid;
+  border_runs.clear();
+  bulk_runs.clear();
+  for (int z = 1; z <= grid[2]; z++) {
+    for (int y = 1; y <= grid[1]; y++) {
+      auto const row = get_linear_index(0, y, z, lb_lattice.halo_grid);
+      auto const border_row =
+          y == 1 or y == grid[1] or z == 1 or z == grid[2];
+      for (int x = 1; x <= grid[0]; x++) {
+        if (not is_fluid(row + x))
+          continue;
+        auto &runs =
+            (border_row or x == 1 or x == grid[0]) ? border_runs : bulk_runs;
+        if (runs.empty() or runs.back().begin + runs.back().length != row + x) {
+          runs.push_back({row + x, 0});
+        }
+        runs.back().length++;
+      }
+    }
+  }
+
+#ifdef LB_BOUNDARIES
+  boundary_links.clear();
+  for (int z = 0; z < lb_lattice.grid[2] + 2; z++) {
+    for (int y = 0; y < lb_lattice.grid[1] + 2; y++) {
+      for (int x = 0; x < lb_lattice.grid[0] + 2; x++) {
+        auto const k = get_linear_index(x, y, z, lb_lattice.halo_grid);
+        if (is_fluid(k))
+          continue;
+        for (int i = 0; i < 19; i++) {
+          if (x - D3Q19::c[i][0] > 0 &&
+              x - D3Q19::c[i][0] < lb_lattice.grid[0] + 1 &&
+              y - D3Q19::c[i][1] > 0 &&
+              y - D3Q19::c[i][1] < lb_lattice.grid[1] + 1 &&
+              z - D3Q19::c[i][2] > 0 &&
+              z - D3Q19::c[i][2] < lb_lattice.grid[2] + 1) {
+            boundary_links.push_back({k, i});
+          }
+        }
+      }
+    }
+  }
+#endif // LB_BOUNDARIES
 }
 
-/** (Re-)allocate memory for the fluid and initialize pointers. */
+/** (Re-)allocate memory for the fluid and initialize pointers.
+ *  With @p in_place, only @p lb_fluid is allocated.
+ */
 void lb_realloc_fluid(LB_FluidData &lb_fluid_a, LB_FluidData &lb_fluid_b,
-                      const Lattice::index_t halo_grid_volume,
+                      const Lattice::index_t halo_grid_volume, bool in_place,
                       LB_Fluid &lb_fluid, LB_Fluid &lb_fluid_post) {
   const std::array<int, 2> size = {{D3Q19::n_vel, halo_grid_volume}};
+  const std::array<int, 2> size_post = {
+      {D3Q19::n_vel, in_place ? 0 : halo_grid_volume}};
 
   lb_fluid_a.resize(size);
-  lb_fluid_b.resize(size);
+  lb_fluid_b.resize(size_post);
 
   using Utils::Span;
   for (int i = 0; i < size[0]; i++) {
     lb_fluid[i] = Span<double>(lb_fluid_a[i].origin(), size[1]);
-    lb_fluid_post[i] = Span<double>(lb_fluid_b[i].origin(), size[1]);
+    lb_fluid_post[i] = Span<double>(lb_fluid_b[i].origin(), size_post[1]);
+  }
+}
+
+/** Re-allocate the populations for a change of
+ *  @ref LB_Parameters::in_place_streaming, keeping their current values.
+ */
+static void lb_realloc_populations(bool in_place) {
+  auto const volume = lbfluid[0].size();
+  LB_FluidData populations(boost::extents[D3Q19::n_vel][volume]);
+  for (int i = 0; i < D3Q19::n_vel; i++) {
+    std::copy(lbfluid[i].begin(), lbfluid[i].end(), populations[i].begin());
+  }
+
+  lb_realloc_fluid(lbfluid_a, lbfluid_b, volume, in_place, lbfluid,
+                   lbfluid_post);
+
+  for (int i = 0; i < D3Q19::n_vel; i++) {
+    std::copy(populations[i].begin(), populations[i].end(),
+              lbfluid[i].begin());
   }
 }
 
@@ -248,13 +351,14 @@ void lb_init(const LB_Parameters &lb_parameters) {
   }
 
   /* allocate memory for data structures */
-  lb_realloc_fluid(lbfluid_a, lbfluid_b, lblattice.halo_grid_volume, lbfluid,
-                   lbfluid_post);
+  lb_realloc_fluid(lbfluid_a, lbfluid_b, lblattice.halo_grid_volume,
+                   lb_parameters.in_place_streaming, lbfluid, lbfluid_post);
 
   lb_initialize_fields(lbfields, lbpar, lblattice);
 
   /* prepare the halo communication */
   lb_prepare_communication(update_halo_comm, lblattice);
+  lb_prepare_push_communication(lblattice);
 
   /* initialize derived parameters */
   lb_reinit_parameters(lbpar);
@@ -324,272 +428,146 @@ void lb_reinit_parameters(LB_Parameters &lb_parameters) {
   }
 }
 
-/** Halo communication for push scheme */
-static void halo_push_communication(LB_Fluid &lb_fluid,
-                                    const Lattice &lb_lattice) {
-  Lattice::index_t index;
-  int x, y, z, count;
-  int rnode, snode;
-  double *buffer;
-  MPI_Status status;
-
-  auto const yperiod = lb_lattice.halo_grid[0];
-  auto const zperiod = lb_lattice.halo_grid[0] * lb_lattice.halo_grid[1];
-
-  auto const node_neighbors = calc_node_neighbors(comm_cart);
-
-  /***************
-   * X direction *
-   ***************/
-  count = 5 * lb_lattice.halo_grid[1] * lb_lattice.halo_grid[2];
-  std::vector<double> sbuf(count);
-  std::vector<double> rbuf(count);
-
-  /* send to right, recv from left i = 1, 7, 9, 11, 13 */
-  snode = node_neighbors[1];
-  rnode = node_neighbors[0];
-
-  buffer = sbuf.data();
-  index = get_linear_index(lb_lattice.grid[0] + 1, 0, 0, lb_lattice.halo_grid);
-  for (z = 0; z < lb_lattice.halo_grid[2]; z++) {
-    for (y = 0; y < lb_lattice.halo_grid[1]; y++) {
-      buffer[0] = lb_fluid[1][index];
-      buffer[1] = lb_fluid[7][index];
-      buffer[2] = lb_fluid[9][index];
-      buffer[3] = lb_fluid[11][index];
-      buffer[4] = lb_fluid[13][index];
-      buffer += 5;
-
-      index += yperiod;
-    }
-  }
-
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
-               comm_cart, &status);
-
-  buffer = rbuf.data();
-  index = get_linear_index(1, 0, 0, lb_lattice.halo_grid);
-  for (z = 0; z < lb_lattice.halo_grid[2]; z++) {
-    for (y = 0; y < lb_lattice.halo_grid[1]; y++) {
-      lb_fluid[1][index] = buffer[0];
-      lb_fluid[7][index] = buffer[1];
-      lb_fluid[9][index] = buffer[2];
-      lb_fluid[11][index] = buffer[3];
-      lb_fluid[13][index] = buffer[4];
-      buffer += 5;
-
-      index += yperiod;
-    }
-  }
-
-  /* send to left, recv from right i = 2, 8, 10, 12, 14 */
-  snode = node_neighbors[0];
-  rnode = node_neighbors[1];
-
-  buffer = sbuf.data();
-  index = get_linear_index(0, 0, 0, lb_lattice.halo_grid);
-  for (z = 0; z < lb_lattice.halo_grid[2]; z++) {
-    for (y = 0; y < lb_lattice.halo_grid[1]; y++) {
-      buffer[0] = lb_fluid[2][index];
-      buffer[1] = lb_fluid[8][index];
-      buffer[2] = lb_fluid[10][index];
-      buffer[3] = lb_fluid[12][index];
-      buffer[4] = lb_fluid[14][index];
-      buffer += 5;
-
-      index += yperiod;
-    }
-  }
-
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
-               comm_cart, &status);
-
-  buffer = rbuf.data();
-  index = get_linear_index(lb_lattice.grid[0], 0, 0, lb_lattice.halo_grid);
-  for (z = 0; z < lb_lattice.halo_grid[2]; z++) {
-    for (y = 0; y < lb_lattice.halo_grid[1]; y++) {
-      lb_fluid[2][index] = buffer[0];
-      lb_fluid[8][index] = buffer[1];
-      lb_fluid[10][index] = buffer[2];
-      lb_fluid[12][index] = buffer[3];
-      lb_fluid[14][index] = buffer[4];
-      buffer += 5;
-
-      index += yperiod;
-    }
-  }
-
-  /***************
-   * Y direction *
-   ***************/
-  count = 5 * lb_lattice.halo_grid[0] * lb_lattice.halo_grid[2];
-  sbuf.resize(count);
-  rbuf.resize(count);
-
-  /* send to right, recv from left i = 3, 7, 10, 15, 17 */
-  snode = node_neighbors[3];
-  rnode = node_neighbors[2];
-
-  buffer = sbuf.data();
-  index = get_linear_index(0, lb_lattice.grid[1] + 1, 0, lb_lattice.halo_grid);
-  for (z = 0; z < lb_lattice.halo_grid[2]; z++) {
-    for (x = 0; x < lb_lattice.halo_grid[0]; x++) {
-      buffer[0] = lb_fluid[3][index];
-      buffer[1] = lb_fluid[7][index];
-      buffer[2] = lb_fluid[10][index];
-      buffer[3] = lb_fluid[15][index];
-      buffer[4] = lb_fluid[17][index];
-      buffer += 5;
-
-      ++index;
-    }
-    index += zperiod - lb_lattice.halo_grid[0];
-  }
-
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
-               comm_cart, &status);
-
-  buffer = rbuf.data();
-  index = get_linear_index(0, 1, 0, lb_lattice.halo_grid);
-  for (z = 0; z < lb_lattice.halo_grid[2]; z++) {
-    for (x = 0; x < lb_lattice.halo_grid[0]; x++) {
-      lb_fluid[3][index] = buffer[0];
-      lb_fluid[7][index] = buffer[1];
-      lb_fluid[10][index] = buffer[2];
-      lb_fluid[15][index] = buffer[3];
-      lb_fluid[17][index] = buffer[4];
-      buffer += 5;
-
-      ++index;
-    }
-    index += zperiod - lb_lattice.halo_grid[0];
-  }
-
-  /* send to left, recv from right i = 4, 8, 9, 16, 18 */
-  snode = node_neighbors[2];
-  rnode = node_neighbors[3];
-
-  buffer = sbuf.data();
-  index = get_linear_index(0, 0, 0, lb_lattice.halo_grid);
-  for (z = 0; z < lb_lattice.halo_grid[2]; z++) {
-    for (x = 0; x < lb_lattice.halo_grid[0]; x++) {
-      buffer[0] = lb_fluid[4][index];
-      buffer[1] = lb_fluid[8][index];
-      buffer[2] = lb_fluid[9][index];
-      buffer[3] = lb_fluid[16][index];
-      buffer[4] = lb_fluid[18][index];
-      buffer += 5;
-
-      ++index;
+/** Halo region of the push scheme: the halo cells on one face or edge of
+ *  the local lattice, into which populations stream out of the domain.
+ *  Each region is exchanged directly with the neighbor it belongs to, so
+ *  that all regions can be in flight at the same time.
+ */
+struct LB_Push_Region {
+  /** neighbor in the direction of the region, to which it is sent */
+  int dest_node;
+  /** neighbor in the opposite direction, from which it is received */
+  int source_node;
+  /** population of every value that is exchanged */
+  std::vector<int> population;
+  /** halo node every value is sent from */
+  std::vector<Lattice::index_t> send_index;
+  /** border node every value is received into */
+  std::vector<Lattice::index_t> recv_index;
+  std::vector<double> send_buffer;
+  std::vector<double> recv_buffer;
+};
+
+static std::vector<LB_Push_Region> push_regions;
+static std::vector<MPI_Request> push_requests;
+
+/** Set up the regions of the push halo exchange, one per face and edge of
+ *  the local lattice. Only populations that were streamed out of the
+ *  local domain are exchanged, so every population of a border node is
+ *  received exactly once.
+ */
+void lb_prepare_push_communication(const Lattice &lb_lattice) {
+  auto const &grid = lb_lattice.grid;
+  auto const node_pos = calc_node_pos(comm_cart);
+
+  auto is_interior = [&grid](Utils::Vector3i const &pos) {
+    for (int k = 0; k < 3; k++) {
+      if (pos[k] < 1 or pos[k] > grid[k])
+        return false;
     }
-    index += zperiod - lb_lattice.halo_grid[0];
-  }
+    return true;
+  };
+
+  push_regions.clear();
+  for (int dz = -1; dz <= 1; dz++) {
+    for (int dy = -1; dy <= 1; dy++) {
+      for (int dx = -1; dx <= 1; dx++) {
+        Utils::Vector3i const dir{dx, dy, dz};
+        auto const n_dirs = std::abs(dx) + std::abs(dy) + std::abs(dz);
+        /* D3Q19 has no velocities along the space diagonals */
+        if (n_dirs == 0 or n_dirs == 3)
+          continue;
+
+        LB_Push_Region region;
+        region.dest_node = Utils::Mpi::cart_rank(comm_cart, node_pos + dir);
+        region.source_node = Utils::Mpi::cart_rank(comm_cart, node_pos - dir);
+
+        /* halo cells of the region */
+        Utils::Vector3i lower, upper;
+        for (int k = 0; k < 3; k++) {
+          lower[k] = (dir[k] == 0) ? 1 : (dir[k] > 0) ? grid[k] + 1 : 0;
+          upper[k] = (dir[k] == 0) ? grid[k] : lower[k];
+        }
 
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
-               comm_cart, &status);
-
-  buffer = rbuf.data();
-  index = get_linear_index(0, lb_lattice.grid[1], 0, lb_lattice.halo_grid);
-  for (z = 0; z < lb_lattice.halo_grid[2]; z++) {
-    for (x = 0; x < lb_lattice.halo_grid[0]; x++) {
-      lb_fluid[4][index] = buffer[0];
-      lb_fluid[8][index] = buffer[1];
-      lb_fluid[9][index] = buffer[2];
-      lb_fluid[16][index] = buffer[3];
-      lb_fluid[18][index] = buffer[4];
-      buffer += 5;
-
-      ++index;
+        Utils::Vector3i pos;
+        for (pos[2] = lower[2]; pos[2] <= upper[2]; pos[2]++) {
+          for (pos[1] = lower[1]; pos[1] <= upper[1]; pos[1]++) {
+            for (pos[0] = lower[0]; pos[0] <= upper[0]; pos[0]++) {
+              Utils::Vector3i recv_pos;
+              for (int k = 0; k < 3; k++) {
+                recv_pos[k] = pos[k] - dir[k] * grid[k];
+              }
+              for (int i = 0; i < D3Q19::n_vel; i++) {
+                Utils::Vector3i source;
+                for (int k = 0; k < 3; k++) {
+                  source[k] = pos[k] - static_cast<int>(D3Q19::c[i][k]);
+                }
+                if (not is_interior(source))
+                  continue;
+                region.population.push_back(i);
+                region.send_index.push_back(
+                    get_linear_index(pos, lb_lattice.halo_grid));
+                region.recv_index.push_back(
+                    get_linear_index(recv_pos, lb_lattice.halo_grid));
+              }
+            }
+          }
+        }
+        region.send_buffer.resize(region.send_index.size());
+        region.recv_buffer.resize(region.recv_index.size());
+        push_regions.push_back(std::move(region));
+      }
     }
-    index += zperiod - lb_lattice.halo_grid[0];
   }
+}
 
-  /***************
-   * Z direction *
-   ***************/
-  count = 5 * lb_lattice.halo_grid[0] * lb_lattice.halo_grid[1];
-  sbuf.resize(count);
-  rbuf.resize(count);
-
-  /* send to right, recv from left i = 5, 11, 14, 15, 18 */
-  snode = node_neighbors[5];
-  rnode = node_neighbors[4];
-
-  buffer = sbuf.data();
-  index = get_linear_index(0, 0, lb_lattice.grid[2] + 1, lb_lattice.halo_grid);
-  for (y = 0; y < lb_lattice.halo_grid[1]; y++) {
-    for (x = 0; x < lb_lattice.halo_grid[0]; x++) {
-      buffer[0] = lb_fluid[5][index];
-      buffer[1] = lb_fluid[11][index];
-      buffer[2] = lb_fluid[14][index];
-      buffer[3] = lb_fluid[15][index];
-      buffer[4] = lb_fluid[18][index];
-      buffer += 5;
-
-      ++index;
-    }
+/** Start the halo exchange of the push scheme. Only reads the halo of
+ *  @p lb_fluid, so the bulk of the lattice can be collided and streamed
+ *  while the messages are in flight.
+ */
+static void halo_push_communication_begin(const LB_Fluid &lb_fluid) {
+  auto const n_regions = static_cast<int>(push_regions.size());
+  push_requests.resize(2 * n_regions);
+
+  for (int n = 0; n < n_regions; n++) {
+    auto &region = push_regions[n];
+    MPI_Irecv(region.recv_buffer.data(),
+              static_cast<int>(region.recv_buffer.size()), MPI_DOUBLE,
+              region.source_node, REQ_HALO_SPREAD + n, comm_cart,
+              &push_requests[n]);
   }
 
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
-               comm_cart, &status);
-
-  buffer = rbuf.data();
-  index = get_linear_index(0, 0, 1, lb_lattice.halo_grid);
-  for (y = 0; y < lb_lattice.halo_grid[1]; y++) {
-    for (x = 0; x < lb_lattice.halo_grid[0]; x++) {
-      lb_fluid[5][index] = buffer[0];
-      lb_fluid[11][index] = buffer[1];
-      lb_fluid[14][index] = buffer[2];
-      lb_fluid[15][index] = buffer[3];
-      lb_fluid[18][index] = buffer[4];
-      buffer += 5;
-
-      ++index;
+  for (int n = 0; n < n_regions; n++) {
+    auto &region = push_regions[n];
+    for (std::size_t j = 0; j < region.send_buffer.size(); j++) {
+      region.send_buffer[j] =
+          lb_fluid[region.population[j]][region.send_index[j]];
     }
+    MPI_Isend(region.send_buffer.data(),
+              static_cast<int>(region.send_buffer.size()), MPI_DOUBLE,
+              region.dest_node, REQ_HALO_SPREAD + n, comm_cart,
+              &push_requests[n_regions + n]);
   }
+}
 
-  /* send to left, recv from right i = 6, 12, 13, 16, 17 */
-  snode = node_neighbors[4];
-  rnode = node_neighbors[5];
-
-  buffer = sbuf.data();
-  index = get_linear_index(0, 0, 0, lb_lattice.halo_grid);
-  for (y = 0; y < lb_lattice.halo_grid[1]; y++) {
-    for (x = 0; x < lb_lattice.halo_grid[0]; x++) {
-      buffer[0] = lb_fluid[6][index];
-      buffer[1] = lb_fluid[12][index];
-      buffer[2] = lb_fluid[13][index];
-      buffer[3] = lb_fluid[16][index];
-      buffer[4] = lb_fluid[17][index];
-      buffer += 5;
-
-      ++index;
+/** Finish the halo exchange of the push scheme and write the received
+ *  populations to the border nodes of @p lb_fluid.
+ */
+static void halo_push_communication_end(LB_Fluid &lb_fluid) {
+  auto const n_regions = static_cast<int>(push_regions.size());
+
+  for (int count = 0; count < n_regions; count++) {
+    int n;
+    MPI_Waitany(n_regions, push_requests.data(), &n, MPI_STATUS_IGNORE);
+    auto const &region = push_regions[n];
+    for (std::size_t j = 0; j < region.recv_buffer.size(); j++) {
+      lb_fluid[region.population[j]][region.recv_index[j]] =
+          region.recv_buffer[j];
     }
   }
 
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
-               comm_cart, &status);
-
-  buffer = rbuf.data();
-  index = get_linear_index(0, 0, lb_lattice.grid[2], lb_lattice.halo_grid);
-  for (y = 0; y < lb_lattice.halo_grid[1]; y++) {
-    for (x = 0; x < lb_lattice.halo_grid[0]; x++) {
-      lb_fluid[6][index] = buffer[0];
-      lb_fluid[12][index] = buffer[1];
-      lb_fluid[13][index] = buffer[2];
-      lb_fluid[16][index] = buffer[3];
-      lb_fluid[17][index] = buffer[4];
-      buffer += 5;
-
-      ++index;
-    }
-  }
+  MPI_Waitall(n_regions, push_requests.data() + n_regions,
+              MPI_STATUSES_IGNORE);
 }
 
 /***********************************************************************/
@@ -937,86 +915,241 @@ std::array<T, 19> lb_calc_n_from_m(const std::array<T, 19> &modes) {
   return ret;
 }
 
-template <typename T>
-inline void lb_stream(LB_Fluid &lbfluid, Lattice::index_t index,
-                      const std::array<T, 19> &populations,
-                      const Lattice &lb_lattice) {
+/** Offsets of the nodes the populations of a node are streamed to. */
+std::array<Lattice::index_t, 19> lb_stream_offsets(const Lattice &lb_lattice) {
   const std::array<int, 3> period = {
       {1, lb_lattice.halo_grid[0],
        lb_lattice.halo_grid[0] * lb_lattice.halo_grid[1]}};
 
-  for (int i = 0; i < populations.size(); i++) {
-    auto const next = index + boost::inner_product(period, D3Q19::c[i], 0);
-    lbfluid[i][next] = populations[i];
+  std::array<Lattice::index_t, 19> offsets;
+  for (int i = 0; i < offsets.size(); i++) {
+    offsets[i] = boost::inner_product(period, D3Q19::c[i], 0);
   }
+  return offsets;
 }
 
-/* Collisions and streaming (push scheme) */
-inline void lb_collide_stream() {
-  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
-  /* loop over all lattice cells (halo excluded) */
-#ifdef LB_BOUNDARIES
-  for (auto &lbboundary : LBBoundaries::lbboundaries) {
-    (*lbboundary).reset_force();
+/** Index of the velocity opposite to each velocity. */
+constexpr std::array<int, 19> lb_reverse = {
+    {0, 2, 1, 4, 3, 6, 5, 8, 7, 10, 9, 12, 11, 14, 13, 16, 15, 18, 17}};
+
+/** Where the post-collision populations of a node are written to. */
+struct LB_Stream_Targets {
+  /** populations that are written. */
+  LB_Fluid *fluid;
+  /** population each population is written to. */
+  std::array<int, 19> population;
+  /** offset of the node each population is written to. */
+  std::array<Lattice::index_t, 19> offset;
+};
+
+/** Push the populations to the neighbor nodes in @ref lbfluid_post. */
+LB_Stream_Targets lb_push_targets(const Lattice &lb_lattice) {
+  LB_Stream_Targets targets{&lbfluid_post, {}, lb_stream_offsets(lb_lattice)};
+  std::iota(targets.population.begin(), targets.population.end(), 0);
+  return targets;
+}
+
+/** Store the populations reversed at the same node in @ref lbfluid,
+ *  for @ref lb_swap_stream.
+ */
+LB_Stream_Targets lb_in_place_targets() {
+  return {&lbfluid, lb_reverse, {}};
+}
+
+/** Streaming for @ref LB_Parameters::in_place_streaming.
+ *
+ *  After an in-place collision, the population that leaves node x in
+ *  direction i is stored in the slot of the opposite direction at x.
+ *  Swapping it with the population of direction i at x + c_i moves both
+ *  populations of the link to their targets. Every slot belongs to
+ *  exactly one link, so the swaps are independent. Links between two
+ *  halo nodes are swapped as well, the halo is refreshed afterwards.
+ */
+void lb_swap_stream(LB_Fluid &lb_fluid, const Lattice &lb_lattice) {
+  auto const &halo_grid = lb_lattice.halo_grid;
+  auto const offsets = lb_stream_offsets(lb_lattice);
+
+#pragma omp parallel for if (cell_structure.use_threads)
+  for (int z = 0; z < halo_grid[2]; z++) {
+    for (int y = 0; y < halo_grid[1]; y++) {
+      auto const row = Utils::get_linear_index(0, y, z, halo_grid);
+      for (int i = 1; i < 19; i++) {
+        /* each link once, from the node with the smaller index */
+        if (offsets[i] < 0)
+          continue;
+        auto const cx = static_cast<int>(D3Q19::c[i][0]);
+        auto const cy = static_cast<int>(D3Q19::c[i][1]);
+        auto const cz = static_cast<int>(D3Q19::c[i][2]);
+        if (y + cy < 0 or y + cy >= halo_grid[1] or z + cz < 0 or
+            z + cz >= halo_grid[2])
+          continue;
+        auto *const from = lb_fluid[lb_reverse[i]].data() + row;
+        auto *const to = lb_fluid[i].data() + row + offsets[i];
+        for (int x = std::max(0, -cx); x < halo_grid[0] - std::max(0, cx);
+             x++) {
+          std::swap(from[x], to[x]);
+        }
+      }
+    }
   }
-#endif // LB_BOUNDARIES
+}
 
-  Lattice::index_t index = lblattice.halo_offset;
-  for (int z = 1; z <= lblattice.grid[2]; z++) {
-    for (int y = 1; y <= lblattice.grid[1]; y++) {
-      for (int x = 1; x <= lblattice.grid[0]; x++) {
-        // as we only want to apply this to non-boundary nodes we can throw out
-        // the if-clause if we have a non-bounded domain
-#ifdef LB_BOUNDARIES
-        if (!lbfields[index].boundary)
-#endif // LB_BOUNDARIES
-        {
-          /* calculate modes locally */
-          auto const modes = lb_calc_modes(index, lbfluid);
+/** Number of nodes of an x-row that are collided together. */
+constexpr int lb_chunk_size = 16;
+
+/** Modes or populations of a chunk of an x-row, one array per velocity. */
+using LB_Chunk = std::array<std::array<double, lb_chunk_size>, 19>;
+
+/** One node of a @ref LB_Chunk, for the mode transformations. */
+class LB_Chunk_Ref {
+public:
+  LB_Chunk_Ref(int x, const LB_Chunk &chunk) : m_x(x), m_chunk(chunk) {}
+  template <std::size_t I> const auto &get() const { return m_chunk[I][m_x]; }
+
+private:
+  const int m_x;
+  const LB_Chunk &m_chunk;
+};
+
+/* declared after @ref Utils::matrix_vector_product, so it is found by
+ * argument-dependent lookup */
+template <std::size_t I> auto get(const LB_Chunk_Ref &chunk) {
+  return chunk.get<I>();
+}
+
+/** Collide a chunk of a run of fluid nodes and stream the populations.
+ *
+ *  The mode transformations are done for all nodes of the chunk at once
+ *  on contiguous data, so that they can be vectorized over the nodes.
+ *  Relaxation, noise and forces are applied node by node in between.
+ *
+ *  @param index    Index of the first node.
+ *  @param n        Number of fluid nodes, at most @ref lb_chunk_size.
+ *  @param targets  Where the populations are written to.
+ */
+void lb_collide_stream_chunk(Lattice::index_t index, int n,
+                             LB_Stream_Targets const &targets) {
+  LB_Chunk modes, populations;
+
+  /* calculate modes locally */
+#pragma omp simd
+  for (int x = 0; x < n; x++) {
+    auto const m = lb_calc_modes(index + x, lbfluid);
+    for (int k = 0; k < 19; k++)
+      modes[k][x] = m[k];
+  }
 
-          /* deterministic collisions */
-          auto const relaxed_modes = lb_relax_modes(index, modes, lbpar);
+  for (int x = 0; x < n; x++) {
+    std::array<double, 19> m;
+    for (int k = 0; k < 19; k++)
+      m[k] = modes[k][x];
 
-          /* fluctuating hydrodynamics */
-          auto const thermalized_modes = lb_thermalize_modes(
-              index, relaxed_modes, lbpar, rng_counter_fluid);
+    /* deterministic collisions */
+    auto const relaxed_modes = lb_relax_modes(index + x, m, lbpar);
 
-          /* apply forces */
-          auto const modes_with_forces =
-              lb_apply_forces(index, thermalized_modes, lbpar, lbfields);
+    /* fluctuating hydrodynamics */
+    auto const thermalized_modes = lb_thermalize_modes(
+        index + x, relaxed_modes, lbpar, rng_counter_fluid);
+
+    /* apply forces */
+    auto const modes_with_forces =
+        lb_apply_forces(index + x, thermalized_modes, lbpar, lbfields);
 
 #ifdef VIRTUAL_SITES_INERTIALESS_TRACERS
-          // Safeguard the node forces so that we can later use them for the IBM
-          // particle update
-          lbfields[index].force_density_buf = lbfields[index].force_density;
+    // Safeguard the node forces so that we can later use them for the IBM
+    // particle update
+    lbfields[index + x].force_density_buf = lbfields[index + x].force_density;
 #endif
 
-          /* reset the force density */
-          lbfields[index].force_density = lbpar.ext_force_density;
+    /* reset the force density */
+    lbfields[index + x].force_density = lbpar.ext_force_density;
 
-          auto const populations = lb_calc_n_from_m(modes_with_forces);
+    auto const normalized_modes = normalize_modes(modes_with_forces);
+    for (int k = 0; k < 19; k++)
+      modes[k][x] = normalized_modes[k];
+  }
 
-          /* transform back to populations and streaming */
-          lb_stream(lbfluid_post, index, populations, lblattice);
-        }
+  /* transform back to populations */
+#pragma omp simd
+  for (int x = 0; x < n; x++) {
+    auto const p =
+        Utils::matrix_vector_product<double, 19, e_ki_transposed>(
+            LB_Chunk_Ref(x, modes));
+    for (int i = 0; i < 19; i++)
+      populations[i][x] = p[i] * D3Q19::w[i];
+  }
 
-        ++index; /* next node */
-      }
-      index += 2; /* skip halo region */
+  /* streaming */
+  for (int i = 0; i < 19; i++) {
+    auto *const next = (*targets.fluid)[targets.population[i]].data() + index +
+                       targets.offset[i];
+    for (int x = 0; x < n; x++) {
+      next[x] = populations[i][x];
     }
-    index += 2 * lblattice.halo_grid[0]; /* skip halo region */
   }
+}
 
-  /* exchange halo regions */
-  halo_push_communication(lbfluid_post, lblattice);
+/** Collide and stream a list of runs of fluid nodes. Every node streams to
+ *  distinct sites, so the runs can be done concurrently. The runs are
+ *  ordered by z-plane, so the static schedule gives each thread a
+ *  contiguous block of the lattice.
+ */
+void lb_collide_stream_runs(std::vector<LB_Fluid_Run> const &runs,
+                            LB_Stream_Targets const &targets) {
+  auto const n_runs = static_cast<int>(runs.size());
+#pragma omp parallel for schedule(static) if (cell_structure.use_threads)
+  for (int r = 0; r < n_runs; r++) {
+    auto const &run = runs[r];
+    for (int x = 0; x < run.length; x += lb_chunk_size) {
+      lb_collide_stream_chunk(run.begin + x,
+                              std::min(lb_chunk_size, run.length - x),
+                              targets);
+    }
+  }
+}
 
+/* Collisions and streaming (push scheme) */
+inline void lb_collide_stream() {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
 #ifdef LB_BOUNDARIES
-  /* boundary conditions for links */
-  lb_bounce_back(lbfluid_post, lbpar, lbfields);
+  for (auto &lbboundary : LBBoundaries::lbboundaries) {
+    (*lbboundary).reset_force();
+  }
 #endif // LB_BOUNDARIES
 
-  /* swap the pointers for old and new population fields */
-  std::swap(lbfluid, lbfluid_post);
+  auto const targets = lbpar.in_place_streaming ? lb_in_place_targets()
+                                                : lb_push_targets(lblattice);
+
+  if (lbpar.in_place_streaming) {
+    lb_collide_stream_runs(border_runs, targets);
+    lb_collide_stream_runs(bulk_runs, targets);
+
+    /* the halo needs the post-collision populations of the neighbors */
+    halo_communication(&update_halo_comm,
+                       reinterpret_cast<char *>(lbfluid[0].data()));
+
+    lb_swap_stream(lbfluid, lblattice);
+
+#ifdef LB_BOUNDARIES
+    /* boundary conditions for links */
+    lb_bounce_back(lbfluid, lbpar, lbfields);
+#endif // LB_BOUNDARIES
+  } else {
+    /* only the border streams into the halo, so the halo regions can be
+     * exchanged while the bulk is collided */
+    lb_collide_stream_runs(border_runs, targets);
+    halo_push_communication_begin(lbfluid_post);
+    lb_collide_stream_runs(bulk_runs, targets);
+    halo_push_communication_end(lbfluid_post);
+
+#ifdef LB_BOUNDARIES
+    /* boundary conditions for links */
+    lb_bounce_back(lbfluid_post, lbpar, lbfields);
+#endif // LB_BOUNDARIES
+
+    /* swap the pointers for old and new population fields */
+    std::swap(lbfluid, lbfluid_post);
+  }
 
   halo_communication(&update_halo_comm,
                      reinterpret_cast<char *>(lbfluid[0].data()));
@@ -1366,42 +1499,26 @@ void lb_bounce_back(LB_Fluid &lbfluid, const LB_Parameters &lb_parameters,
   int reverse[] = {0, 2,  1,  4,  3,  6,  5,  8,  7, 10,
                    9, 12, 11, 14, 13, 16, 15, 18, 17};
 
-  /* bottom-up sweep */
-  for (int z = 0; z < lblattice.grid[2] + 2; z++) {
-    for (int y = 0; y < lblattice.grid[1] + 2; y++) {
-      for (int x = 0; x < lblattice.grid[0] + 2; x++) {
-        k = get_linear_index(x, y, z, lblattice.halo_grid);
-
-        if (lb_fields[k].boundary) {
-          for (i = 0; i < 19; i++) {
-            population_shift = 0;
-            for (l = 0; l < 3; l++) {
-              population_shift -= lb_parameters.density * 2 * D3Q19::c[i][l] *
-                                  D3Q19::w[i] * lb_fields[k].slip_velocity[l] /
-                                  D3Q19::c_sound_sq<double>;
-            }
+  /* in the order of a bottom-up sweep over the boundary nodes */
+  for (auto const &link : boundary_links) {
+    k = link.node;
+    i = link.velocity;
+    population_shift = 0;
+    for (l = 0; l < 3; l++) {
+      population_shift -= lb_parameters.density * 2 * D3Q19::c[i][l] *
+                          D3Q19::w[i] * lb_fields[k].slip_velocity[l] /
+                          D3Q19::c_sound_sq<double>;
+    }
 
-            if (x - D3Q19::c[i][0] > 0 &&
-                x - D3Q19::c[i][0] < lblattice.grid[0] + 1 &&
-                y - D3Q19::c[i][1] > 0 &&
-                y - D3Q19::c[i][1] < lblattice.grid[1] + 1 &&
-                z - D3Q19::c[i][2] > 0 &&
-                z - D3Q19::c[i][2] < lblattice.grid[2] + 1) {
-              if (!lb_fields[k - next[i]].boundary) {
-                for (l = 0; l < 3; l++) {
-                  (*LBBoundaries::lbboundaries[lb_fields[k].boundary - 1])
-                      .force()[l] += // TODO
-                      (2 * lbfluid[i][k] + population_shift) * D3Q19::c[i][l];
-                }
-                lbfluid[reverse[i]][k - next[i]] =
-                    lbfluid[i][k] + population_shift;
-              } else {
-                lbfluid[reverse[i]][k - next[i]] = lbfluid[i][k] = 0.0;
-              }
-            }
-          }
-        }
+    if (!lb_fields[k - next[i]].boundary) {
+      for (l = 0; l < 3; l++) {
+        (*LBBoundaries::lbboundaries[lb_fields[k].boundary - 1])
+            .force()[l] += // TODO
+            (2 * lbfluid[i][k] + population_shift) * D3Q19::c[i][l];
       }
+      lbfluid[reverse[i]][k - next[i]] = lbfluid[i][k] + population_shift;
+    } else {
+      lbfluid[reverse[i]][k - next[i]] = lbfluid[i][k] = 0.0;
     }
   }
 }
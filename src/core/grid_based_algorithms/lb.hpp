@@ -76,6 +76,24 @@ struct LB_FluidNode {
 #endif
 };
 
+/** Contiguous run of fluid nodes along an x-row of the local lattice */
+struct LB_Fluid_Run {
+  /** linear index of the first node */
+  Lattice::index_t begin;
+  /** number of nodes */
+  int length;
+};
+
+#ifdef LB_BOUNDARIES
+/** Link from a boundary node to a fluid site of the local lattice */
+struct LB_Boundary_Link {
+  /** linear index of the boundary node */
+  Lattice::index_t node;
+  /** velocity pointing from the fluid site into the boundary node */
+  int velocity;
+};
+#endif // LB_BOUNDARIES
+
 /** Data structure holding the parameters for the Lattice Boltzmann system. */
 struct LB_Parameters {
   /** number density (LB units) */
@@ -121,9 +139,15 @@ struct LB_Parameters {
   /** Thermal energy */
   double kT;
 
+  /** Stream in place in a single population array instead of pushing
+   *  into a second one. Takes effect on the next @ref lb_init.
+   */
+  bool in_place_streaming;
+
   template <class Archive> void serialize(Archive &ar, long int) {
     ar &density &viscosity &bulk_viscosity &agrid &tau &ext_force_density
-        &gamma_odd &gamma_even &gamma_shear &gamma_bulk &is_TRT &phi &kT;
+        &gamma_odd &gamma_even &gamma_shear &gamma_bulk &is_TRT &phi &kT
+            &in_place_streaming;
   }
 };
 
@@ -145,7 +169,8 @@ void lb_reinit_fluid(std::vector<LB_FluidNode> &lb_fields,
 void lb_reinit_parameters(LB_Parameters &lb_parameters);
 /** Pointer to the velocity populations of the fluid.
  *  lbfluid contains pre-collision populations, lbfluid_post
- *  contains post-collision populations
+ *  contains post-collision populations (empty with
+ *  @ref LB_Parameters::in_place_streaming)
  */
 using LB_Fluid = std::array<Utils::Span<double>, 19>;
 extern LB_Fluid lbfluid;
@@ -248,6 +273,7 @@ uint64_t lb_fluid_get_rng_state();
 void lb_fluid_set_rng_state(uint64_t counter);
 void lb_prepare_communication(HaloCommunicator &halo_comm,
                               const Lattice &lb_lattice);
+void lb_prepare_push_communication(const Lattice &lb_lattice);
 
 #ifdef LB_BOUNDARIES
 /** Bounce back boundary conditions.
@@ -269,6 +295,17 @@ void lb_collect_boundary_forces(double *result);
 void lb_initialize_fields(std::vector<LB_FluidNode> &fields,
                           LB_Parameters const &lb_parameters,
                           Lattice const &lb_lattice);
+/** Rebuild the lists of fluid runs and boundary links from the boundary
+ *  flags. The collide-stream step and the bounce-back only visit the nodes
+ *  in these lists. This is an index over the dense lattice, there is no
+ *  sparse storage of the fluid nodes: the populations and fields of
+ *  boundary nodes are still allocated, and the halo exchange and the
+ *  particle coupling work on the full lattice. The fluid nodes next to the
+ *  halo are kept apart, so that the halo exchange can overlap with the
+ *  bulk. Has to be called whenever the boundary flags change.
+ */
+void lb_update_fluid_node_lists(const std::vector<LB_FluidNode> &lb_fields,
+                                const Lattice &lb_lattice);
 void lb_on_param_change(LBParam param);
 
 /*@}*/
@@ -270,6 +270,7 @@ void lb_init_boundaries() {
         }
       }
     }
+    lb_update_fluid_node_lists(lbfields, lblattice);
 #endif
   }
 }
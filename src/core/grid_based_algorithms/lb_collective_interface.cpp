@@ -1,11 +1,24 @@
 #include <utils/index.hpp>
 
 #include "MpiCallbacks.hpp"
+#include "cells.hpp"
 #include "communication.hpp"
 #include "grid.hpp"
+#include "halo.hpp"
+#include "lb-d3q19.hpp"
 #include "lb.hpp"
 #include "lb_interpolation.hpp"
 
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/collectives/gather.hpp>
+#include <boost/mpi/collectives/scatter.hpp>
+#include <boost/serialization/string.hpp>
+
+#include <mpi.h>
+
+#include <functional>
+#include <string>
+
 using Utils::get_linear_index;
 
 /* LB CPU callback interface */
@@ -46,8 +59,248 @@ auto lb_calc_fluid_kernel(Utils::Vector3i const &index, Kernel kernel) {
     return kernel(modes, force_density);
   });
 }
+
+/** Intersection of a box of the global lattice with the local lattice.
+ *  @return The first node and the shape of the intersection.
+ */
+std::pair<Utils::Vector3i, Utils::Vector3i>
+lb_local_slice(Utils::Vector3i const &lower, Utils::Vector3i const &upper) {
+  Utils::Vector3i local_lower, local_shape;
+  for (int k = 0; k < 3; k++) {
+    local_lower[k] = std::max(lower[k], lblattice.local_index_offset[k]);
+    auto const local_upper = std::min(
+        upper[k], lblattice.local_index_offset[k] + lblattice.grid[k]);
+    local_shape[k] = std::max(local_upper - local_lower[k], 0);
+  }
+  return {local_lower, local_shape};
+}
+
+/** Call @p f with the position in a box of the global lattice and the
+ *  length of every x-y row of a block of the box, in the order of the
+ *  block. Positions and lengths are in nodes.
+ *
+ *  @param lower        First node of the box.
+ *  @param upper        One past the last node of the box.
+ *  @param block_lower  First node of the block.
+ *  @param block_shape  Shape of the block.
+ *  @param f            Called with the position and the length.
+ */
+template <class F>
+void lb_for_each_slice_row(Utils::Vector3i const &lower,
+                           Utils::Vector3i const &upper,
+                           Utils::Vector3i const &block_lower,
+                           Utils::Vector3i const &block_shape, F f) {
+  auto const shape = upper - lower;
+  auto const offset = block_lower - lower;
+  for (int x = 0; x < block_shape[0]; x++) {
+    for (int y = 0; y < block_shape[1]; y++) {
+      auto const index =
+          ((offset[0] + x) * shape[1] + offset[1] + y) * shape[2] + offset[2];
+      f(static_cast<std::size_t>(index), block_shape[2]);
+    }
+  }
+}
+
+/** Evaluate a kernel on all nodes of a box of the global lattice and
+ *  gather the values on the head node. Every rank evaluates the part of
+ *  the box it owns.
+ *
+ *  @param lower   First node of the box.
+ *  @param upper   One past the last node of the box.
+ *  @param kernel  Returns the @p N values of a node from its linear index.
+ *  @return On the head node, the values in row-major order of the box
+ *          (x slowest, values of a node contiguous). Empty elsewhere.
+ */
+template <std::size_t N, class Kernel>
+std::vector<double> lb_calc_slice(Utils::Vector3i const &lower,
+                                  Utils::Vector3i const &upper,
+                                  Kernel kernel) {
+  Utils::Vector3i local_lower, local_shape;
+  std::tie(local_lower, local_shape) = lb_local_slice(lower, upper);
+
+  std::vector<double> local_values(N * local_shape[0] * local_shape[1] *
+                                   local_shape[2]);
+#pragma omp parallel for if (cell_structure.use_threads)
+  for (int x = 0; x < local_shape[0]; x++) {
+    auto out = local_values.begin() + N * x * local_shape[1] * local_shape[2];
+    Utils::Vector3i index;
+    index[0] = local_lower[0] + x;
+    for (index[1] = local_lower[1];
+         index[1] < local_lower[1] + local_shape[1]; index[1]++) {
+      for (index[2] = local_lower[2];
+           index[2] < local_lower[2] + local_shape[2]; index[2]++) {
+        auto const linear_index =
+            get_linear_index(lblattice.local_index(index), lblattice.halo_grid);
+        auto const values = kernel(linear_index);
+        out = std::copy(values.begin(), values.end(), out);
+      }
+    }
+  }
+
+  std::vector<std::vector<double>> values;
+  std::vector<Utils::Vector3i> lowers, shapes;
+  boost::mpi::gather(comm_cart, local_values, values, 0);
+  boost::mpi::gather(comm_cart, local_lower, lowers, 0);
+  boost::mpi::gather(comm_cart, local_shape, shapes, 0);
+
+  std::vector<double> result;
+  if (comm_cart.rank() != 0) {
+    return result;
+  }
+
+  auto const shape = upper - lower;
+  result.resize(N * shape[0] * shape[1] * shape[2]);
+  for (std::size_t rank = 0; rank < values.size(); rank++) {
+    auto in = values[rank].begin();
+    lb_for_each_slice_row(lower, upper, lowers[rank], shapes[rank],
+                          [&](std::size_t index, int length) {
+                            std::copy_n(in, N * length,
+                                        result.begin() + N * index);
+                            in += N * length;
+                          });
+  }
+  return result;
+}
+
+/** Set the values of all nodes of a box of the global lattice from the
+ *  head node. The inverse of @ref lb_calc_slice, every rank receives the
+ *  values of the part of the box it owns in one message.
+ *
+ *  @param lower   First node of the box.
+ *  @param upper   One past the last node of the box.
+ *  @param values   On the head node, the values in the layout returned by
+ *                  @ref lb_calc_slice. Ignored elsewhere.
+ *  @param kernel  Sets a node from its linear index and an iterator to
+ *                 its @p N values.
+ */
+template <std::size_t N, class Kernel>
+void lb_set_slice(Utils::Vector3i const &lower, Utils::Vector3i const &upper,
+                  std::vector<double> const &values, Kernel kernel) {
+  Utils::Vector3i local_lower, local_shape;
+  std::tie(local_lower, local_shape) = lb_local_slice(lower, upper);
+
+  std::vector<Utils::Vector3i> lowers, shapes;
+  boost::mpi::gather(comm_cart, local_lower, lowers, 0);
+  boost::mpi::gather(comm_cart, local_shape, shapes, 0);
+
+  std::vector<std::vector<double>> blocks;
+  if (comm_cart.rank() == 0) {
+    blocks.resize(comm_cart.size());
+    for (std::size_t rank = 0; rank < blocks.size(); rank++) {
+      auto &block = blocks[rank];
+      lb_for_each_slice_row(lower, upper, lowers[rank], shapes[rank],
+                            [&](std::size_t index, int length) {
+                              auto const in = values.begin() + N * index;
+                              block.insert(block.end(), in, in + N * length);
+                            });
+    }
+  }
+
+  std::vector<double> local_values;
+  boost::mpi::scatter(comm_cart, blocks, local_values, 0);
+
+#pragma omp parallel for if (cell_structure.use_threads)
+  for (int x = 0; x < local_shape[0]; x++) {
+    auto in = local_values.begin() + N * x * local_shape[1] * local_shape[2];
+    Utils::Vector3i index;
+    index[0] = local_lower[0] + x;
+    for (index[1] = local_lower[1];
+         index[1] < local_lower[1] + local_shape[1]; index[1]++) {
+      for (index[2] = local_lower[2];
+           index[2] < local_lower[2] + local_shape[2]; index[2]++) {
+        auto const linear_index =
+            get_linear_index(lblattice.local_index(index), lblattice.halo_grid);
+        kernel(linear_index, in);
+        in += N;
+      }
+    }
+  }
+}
+
+auto density_slice_kernel(Lattice::index_t linear_index) {
+  auto const modes = lb_calc_modes(linear_index, lbfluid);
+  return Utils::Vector<double, 1>{lb_calc_density(modes, lbpar)};
+}
+
+auto velocity_slice_kernel(Lattice::index_t linear_index) {
+  auto const modes = lb_calc_modes(linear_index, lbfluid);
+  auto const density = lb_calc_density(modes, lbpar);
+  return lb_calc_momentum_density(modes,
+                                  lbfields[linear_index].force_density) /
+         density;
+}
+
+auto population_slice_kernel(Lattice::index_t linear_index) {
+  return lb_get_population(linear_index);
+}
+
+void set_population_slice_kernel(
+    Lattice::index_t linear_index,
+    std::vector<double>::const_iterator population) {
+  Utils::Vector19d pop;
+  std::copy_n(population, D3Q19::n_vel, pop.begin());
+  lb_set_population(linear_index, pop);
+}
 } // namespace detail
 
+void mpi_lb_get_density_slice_slave(Utils::Vector3i const &lower,
+                                    Utils::Vector3i const &upper) {
+  detail::lb_calc_slice<1>(lower, upper, detail::density_slice_kernel);
+}
+
+REGISTER_CALLBACK(mpi_lb_get_density_slice_slave)
+
+std::vector<double> mpi_lb_get_density_slice(Utils::Vector3i const &lower,
+                                             Utils::Vector3i const &upper) {
+  mpi_call(mpi_lb_get_density_slice_slave, lower, upper);
+  return detail::lb_calc_slice<1>(lower, upper, detail::density_slice_kernel);
+}
+
+void mpi_lb_get_velocity_slice_slave(Utils::Vector3i const &lower,
+                                     Utils::Vector3i const &upper) {
+  detail::lb_calc_slice<3>(lower, upper, detail::velocity_slice_kernel);
+}
+
+REGISTER_CALLBACK(mpi_lb_get_velocity_slice_slave)
+
+std::vector<double> mpi_lb_get_velocity_slice(Utils::Vector3i const &lower,
+                                              Utils::Vector3i const &upper) {
+  mpi_call(mpi_lb_get_velocity_slice_slave, lower, upper);
+  return detail::lb_calc_slice<3>(lower, upper,
+                                  detail::velocity_slice_kernel);
+}
+
+void mpi_lb_get_populations_slice_slave(Utils::Vector3i const &lower,
+                                        Utils::Vector3i const &upper) {
+  detail::lb_calc_slice<19>(lower, upper, detail::population_slice_kernel);
+}
+
+REGISTER_CALLBACK(mpi_lb_get_populations_slice_slave)
+
+std::vector<double>
+mpi_lb_get_populations_slice(Utils::Vector3i const &lower,
+                             Utils::Vector3i const &upper) {
+  mpi_call(mpi_lb_get_populations_slice_slave, lower, upper);
+  return detail::lb_calc_slice<19>(lower, upper,
+                                   detail::population_slice_kernel);
+}
+
+void mpi_lb_set_populations_slice_slave(Utils::Vector3i const &lower,
+                                        Utils::Vector3i const &upper) {
+  detail::lb_set_slice<19>(lower, upper, {},
+                           detail::set_population_slice_kernel);
+}
+
+REGISTER_CALLBACK(mpi_lb_set_populations_slice_slave)
+
+void mpi_lb_set_populations_slice(Utils::Vector3i const &lower,
+                                  Utils::Vector3i const &upper,
+                                  std::vector<double> const &populations) {
+  mpi_call(mpi_lb_set_populations_slice_slave, lower, upper);
+  detail::lb_set_slice<19>(lower, upper, populations,
+                           detail::set_population_slice_kernel);
+}
+
 boost::optional<Utils::Vector3d>
 mpi_lb_get_interpolated_velocity(Utils::Vector3d const &pos) {
   return detail::lb_calc_for_pos(pos, [&](auto pos) {
@@ -130,6 +383,194 @@ auto mpi_lb_get_stress(Utils::Vector3i const &index) {
 
 REGISTER_CALLBACK_ONE_RANK(mpi_lb_get_stress)
 
+namespace detail {
+/** Size in bytes of the grid dimensions at the start of a checkpoint */
+constexpr MPI_Offset checkpoint_header_size = 3 * sizeof(int);
+
+/** MPI datatypes of a checkpoint. The elements are the populations of
+ *  one node, so that the counts stay in the range of int also for the
+ *  lattices of large simulations.
+ */
+struct LBCheckpointTypes {
+  /** populations of one node */
+  MPI_Datatype node_type;
+  /** local block of the lattice from all nodes, stored in row-major
+   *  order (x slowest) */
+  MPI_Datatype block_type;
+  /** number of nodes in the local block */
+  int n_nodes;
+
+  LBCheckpointTypes() {
+    MPI_Type_contiguous(D3Q19::n_vel, MPI_DOUBLE, &node_type);
+    MPI_Type_commit(&node_type);
+
+    auto sizes = lblattice.global_grid;
+    auto subsizes = lblattice.grid;
+    auto starts = lblattice.local_index_offset;
+    MPI_Type_create_subarray(3, sizes.data(), subsizes.data(), starts.data(),
+                             MPI_ORDER_C, node_type, &block_type);
+    MPI_Type_commit(&block_type);
+
+    n_nodes = subsizes[0] * subsizes[1] * subsizes[2];
+  }
+  ~LBCheckpointTypes() {
+    MPI_Type_free(&block_type);
+    MPI_Type_free(&node_type);
+  }
+};
+
+/** Call @p f with the linear index of every local node, in the order of
+ *  @ref LBCheckpointTypes::block_type.
+ */
+template <class F> void lb_for_each_local_node(F f) {
+  for (int x = 1; x <= lblattice.grid[0]; x++) {
+    for (int y = 1; y <= lblattice.grid[1]; y++) {
+      for (int z = 1; z <= lblattice.grid[2]; z++) {
+        f(get_linear_index(x, y, z, lblattice.halo_grid));
+      }
+    }
+  }
+}
+
+bool any_rank_failed(int ret) {
+  return boost::mpi::all_reduce(comm_cart, static_cast<int>(ret != MPI_SUCCESS),
+                                std::plus<int>()) > 0;
+}
+
+/** Write the populations of the local nodes to a binary checkpoint.
+ *  @return An error message, the same on all ranks, or an empty string.
+ */
+std::string lb_save_checkpoint_local(std::string const &filename) {
+  MPI_File f;
+  auto ret = MPI_File_open(comm_cart, const_cast<char *>(filename.c_str()),
+                           MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL,
+                           &f);
+  if (ret != MPI_SUCCESS) {
+    return "could not open file for writing.";
+  }
+
+  std::vector<double> populations;
+  populations.reserve(D3Q19::n_vel * lblattice.grid[0] * lblattice.grid[1] *
+                      lblattice.grid[2]);
+  lb_for_each_local_node([&](Lattice::index_t index) {
+    for (int i = 0; i < D3Q19::n_vel; i++) {
+      populations.push_back(lbfluid[i][index]);
+    }
+  });
+
+  LBCheckpointTypes const types;
+  ret = MPI_File_set_size(f, 0);
+  if (comm_cart.rank() == 0) {
+    ret |= MPI_File_write_at(f, 0, lblattice.global_grid.data(), 3, MPI_INT,
+                             MPI_STATUS_IGNORE);
+  }
+  ret |= MPI_File_set_view(f, checkpoint_header_size, types.node_type,
+                           types.block_type, const_cast<char *>("native"),
+                           MPI_INFO_NULL);
+  ret |= MPI_File_write_all(f, populations.data(), types.n_nodes,
+                            types.node_type, MPI_STATUS_IGNORE);
+  MPI_File_close(&f);
+
+  if (any_rank_failed(ret)) {
+    return "could not write file.";
+  }
+  return {};
+}
+
+/** Read the populations of the local nodes from a binary checkpoint.
+ *  @return An error message, the same on all ranks, or an empty string.
+ */
+std::string lb_load_checkpoint_local(std::string const &filename) {
+  MPI_File f;
+  auto ret = MPI_File_open(comm_cart, const_cast<char *>(filename.c_str()),
+                           MPI_MODE_RDONLY, MPI_INFO_NULL, &f);
+  if (ret != MPI_SUCCESS) {
+    return "could not open file for reading.";
+  }
+
+  auto const &gridsize = lblattice.global_grid;
+  MPI_Offset file_size;
+  Utils::Vector3i saved_gridsize;
+  ret = MPI_File_get_size(f, &file_size);
+  if (ret != MPI_SUCCESS or file_size < checkpoint_header_size) {
+    MPI_File_close(&f);
+    return "incorrectly formatted data.";
+  }
+  ret = MPI_File_read_at_all(f, 0, saved_gridsize.data(), 3, MPI_INT,
+                             MPI_STATUS_IGNORE);
+  if (ret != MPI_SUCCESS) {
+    MPI_File_close(&f);
+    return "incorrectly formatted data.";
+  }
+  if (saved_gridsize != gridsize) {
+    MPI_File_close(&f);
+    return "grid dimensions mismatch, read [" +
+           std::to_string(saved_gridsize[0]) + ' ' +
+           std::to_string(saved_gridsize[1]) + ' ' +
+           std::to_string(saved_gridsize[2]) + "], expected [" +
+           std::to_string(gridsize[0]) + ' ' + std::to_string(gridsize[1]) +
+           ' ' + std::to_string(gridsize[2]) + "].";
+  }
+  auto const data_size = static_cast<MPI_Offset>(sizeof(double)) *
+                         D3Q19::n_vel * gridsize[0] * gridsize[1] *
+                         gridsize[2];
+  if (file_size < checkpoint_header_size + data_size) {
+    MPI_File_close(&f);
+    return "incorrectly formatted data.";
+  }
+  if (file_size > checkpoint_header_size + data_size) {
+    MPI_File_close(&f);
+    return "extra data found, expected EOF.";
+  }
+
+  std::vector<double> populations(D3Q19::n_vel * lblattice.grid[0] *
+                                  lblattice.grid[1] * lblattice.grid[2]);
+  LBCheckpointTypes const types;
+  ret = MPI_File_set_view(f, checkpoint_header_size, types.node_type,
+                          types.block_type, const_cast<char *>("native"),
+                          MPI_INFO_NULL);
+  ret |= MPI_File_read_all(f, populations.data(), types.n_nodes,
+                           types.node_type, MPI_STATUS_IGNORE);
+  MPI_File_close(&f);
+
+  if (any_rank_failed(ret)) {
+    return "incorrectly formatted data.";
+  }
+
+  auto it = populations.begin();
+  lb_for_each_local_node([&](Lattice::index_t index) {
+    for (int i = 0; i < D3Q19::n_vel; i++) {
+      lbfluid[i][index] = *it++;
+    }
+  });
+  halo_communication(&update_halo_comm,
+                     reinterpret_cast<char *>(lbfluid[0].data()));
+  return {};
+}
+} // namespace detail
+
+void mpi_lb_save_checkpoint_slave(std::string const &filename) {
+  detail::lb_save_checkpoint_local(filename);
+}
+
+REGISTER_CALLBACK(mpi_lb_save_checkpoint_slave)
+
+std::string mpi_lb_save_checkpoint(std::string const &filename) {
+  mpi_call(mpi_lb_save_checkpoint_slave, filename);
+  return detail::lb_save_checkpoint_local(filename);
+}
+
+void mpi_lb_load_checkpoint_slave(std::string const &filename) {
+  detail::lb_load_checkpoint_local(filename);
+}
+
+REGISTER_CALLBACK(mpi_lb_load_checkpoint_slave)
+
+std::string mpi_lb_load_checkpoint(std::string const &filename) {
+  mpi_call(mpi_lb_load_checkpoint_slave, filename);
+  return detail::lb_load_checkpoint_local(filename);
+}
+
 void mpi_bcast_lb_params_slave(LBParam field, LB_Parameters const &params) {
   lbpar = params;
   lb_on_param_change(field);
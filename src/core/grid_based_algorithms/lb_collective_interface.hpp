@@ -4,6 +4,9 @@
 #include <boost/optional.hpp>
 #include <utils/Vector.hpp>
 
+#include <string>
+#include <vector>
+
 /* collective getter functions */
 boost::optional<Utils::Vector3d>
 mpi_lb_get_interpolated_velocity(Utils::Vector3d const &pos);
@@ -16,6 +19,30 @@ mpi_lb_get_momentum_density(Utils::Vector3i const &index);
 boost::optional<Utils::Vector6d>
 mpi_lb_get_stress(Utils::Vector3i const &index);
 
+/* collective getter functions for a box of nodes [lower, upper),
+ * the values are only returned on the head node */
+std::vector<double> mpi_lb_get_density_slice(Utils::Vector3i const &lower,
+                                             Utils::Vector3i const &upper);
+std::vector<double> mpi_lb_get_velocity_slice(Utils::Vector3i const &lower,
+                                              Utils::Vector3i const &upper);
+std::vector<double>
+mpi_lb_get_populations_slice(Utils::Vector3i const &lower,
+                             Utils::Vector3i const &upper);
+
+/* collective binary checkpoint of the populations with MPI-IO, every rank
+ * reads or writes its own block of the lattice. The file layout is the grid
+ * dimensions followed by the populations of all nodes in row-major order.
+ * Return an error message, or an empty string on success. */
+std::string mpi_lb_save_checkpoint(std::string const &filename);
+std::string mpi_lb_load_checkpoint(std::string const &filename);
+
+/* collective setter for a box of nodes [lower, upper), the populations
+ * in the layout of mpi_lb_get_populations_slice are only needed on the
+ * head node */
+void mpi_lb_set_populations_slice(Utils::Vector3i const &lower,
+                                  Utils::Vector3i const &upper,
+                                  std::vector<double> const &populations);
+
 /* collective setter functions */
 void mpi_lb_set_population(Utils::Vector3i const &index,
                            Utils::Vector19d const &population);
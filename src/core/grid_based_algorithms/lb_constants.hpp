@@ -37,7 +37,8 @@ enum class LBParam {
   KT,                /**< thermal energy */
   GAMMA_ODD,         /**< Relaxation constant for odd modes */
   GAMMA_EVEN,        /**< Relaxation constant for even modes */
-  TAU                /**< LB time step */
+  TAU,               /**< LB time step */
+  IN_PLACE_STREAMING /**< streaming in a single population array */
 };
 
 #endif /* LB_CONSTANTS_HPP */
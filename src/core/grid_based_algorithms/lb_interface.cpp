@@ -321,6 +321,19 @@ void lb_lbfluid_set_gamma_even(double gamma_even) {
   }
 }
 
+void lb_lbfluid_set_in_place_streaming(bool in_place) {
+  if (lattice_switch == ActiveLB::GPU) {
+    if (in_place)
+      throw std::invalid_argument(
+          "In-place streaming is only available for the CPU LB.");
+  } else if (lattice_switch == ActiveLB::CPU) {
+    lbpar.in_place_streaming = in_place;
+    mpi_bcast_lb_params(LBParam::IN_PLACE_STREAMING);
+  } else {
+    throw NoLBActive();
+  }
+}
+
 double lb_lbfluid_get_gamma_even() {
   if (lattice_switch == ActiveLB::GPU) {
 #ifdef CUDA
@@ -614,11 +627,20 @@ void lb_lbfluid_print_vtk_velocity(const std::string &filename,
             (bb_high[0] - bb_low[0] + 1) * (bb_high[1] - bb_low[1] + 1) *
                 (bb_high[2] - bb_low[2] + 1));
 
-    for (pos[2] = bb_low[2]; pos[2] <= bb_high[2]; pos[2]++)
-      for (pos[1] = bb_low[1]; pos[1] <= bb_high[1]; pos[1]++)
-        for (pos[0] = bb_low[0]; pos[0] <= bb_high[0]; pos[0]++) {
-          auto u = lb_lbnode_get_velocity(pos) * lb_lbfluid_get_lattice_speed();
-          fprintf(fp, "%f %f %f\n", u[0], u[1], u[2]);
+    Utils::Vector3i const lower{bb_low[0], bb_low[1], bb_low[2]};
+    Utils::Vector3i const upper{bb_high[0] + 1, bb_high[1] + 1,
+                                bb_high[2] + 1};
+    auto const shape = upper - lower;
+    auto const velocities = mpi_lb_get_velocity_slice(lower, upper);
+    auto const lattice_speed = lb_lbfluid_get_lattice_speed();
+    /* the slice is stored with x slowest, VTK expects x fastest */
+    for (pos[2] = 0; pos[2] < shape[2]; pos[2]++)
+      for (pos[1] = 0; pos[1] < shape[1]; pos[1]++)
+        for (pos[0] = 0; pos[0] < shape[0]; pos[0]++) {
+          auto const u = velocities.data() +
+                         3 * ((pos[0] * shape[1] + pos[1]) * shape[2] + pos[2]);
+          fprintf(fp, "%f %f %f\n", u[0] * lattice_speed,
+                  u[1] * lattice_speed, u[2] * lattice_speed);
         }
   }
   fclose(fp);
@@ -698,14 +720,20 @@ void lb_lbfluid_print_velocity(const std::string &filename) {
 #endif //  CUDA
   } else {
     Utils::Vector3i pos;
-
-    for (pos[2] = 0; pos[2] < lblattice.global_grid[2]; pos[2]++) {
-      for (pos[1] = 0; pos[1] < lblattice.global_grid[1]; pos[1]++) {
-        for (pos[0] = 0; pos[0] < lblattice.global_grid[0]; pos[0]++) {
-          auto const u = lb_lbnode_get_velocity(pos) * lattice_speed;
+    auto const &shape = lblattice.global_grid;
+    auto const velocities =
+        mpi_lb_get_velocity_slice(Utils::Vector3i{}, shape);
+
+    for (pos[2] = 0; pos[2] < shape[2]; pos[2]++) {
+      for (pos[1] = 0; pos[1] < shape[1]; pos[1]++) {
+        for (pos[0] = 0; pos[0] < shape[0]; pos[0]++) {
+          auto const u =
+              velocities.data() +
+              3 * ((pos[0] * shape[1] + pos[1]) * shape[2] + pos[2]);
           fprintf(fp, "%f %f %f %f %f %f\n", (pos[0] + 0.5) * agrid,
-                  (pos[1] + 0.5) * agrid, (pos[2] + 0.5) * agrid, u[0], u[1],
-                  u[2]);
+                  (pos[1] + 0.5) * agrid, (pos[2] + 0.5) * agrid,
+                  u[0] * lattice_speed, u[1] * lattice_speed,
+                  u[2] * lattice_speed);
         }
       }
     }
@@ -744,40 +772,27 @@ void lb_lbfluid_save_checkpoint(const std::string &filename, int binary) {
     }
 #endif //  CUDA
   } else if (lattice_switch == ActiveLB::CPU) {
-    std::fstream cpfile;
     if (binary) {
-      cpfile.open(filename, std::ios::out | std::ios::binary);
-    } else {
-      cpfile.open(filename, std::ios::out);
-      cpfile.precision(16);
-      cpfile << std::fixed;
+      /* every rank writes its own block */
+      auto const error = mpi_lb_save_checkpoint(filename);
+      if (!error.empty()) {
+        throw std::runtime_error("Error while writing LB checkpoint: " +
+                                 error);
+      }
+      return;
     }
 
-    auto const gridsize = lblattice.global_grid;
+    std::fstream cpfile(filename, std::ios::out);
+    cpfile.precision(16);
+    cpfile << std::fixed;
 
-    if (!binary) {
-      cpfile << gridsize[0] << " " << gridsize[1] << " " << gridsize[2] << "\n";
-    } else {
-      cpfile.write(reinterpret_cast<const char *>(gridsize.data()),
-                   3 * sizeof(gridsize[0]));
-    }
+    auto const gridsize = lblattice.global_grid;
+    cpfile << gridsize[0] << " " << gridsize[1] << " " << gridsize[2] << "\n";
 
-    for (int i = 0; i < gridsize[0]; i++) {
-      for (int j = 0; j < gridsize[1]; j++) {
-        for (int k = 0; k < gridsize[2]; k++) {
-          Utils::Vector3i ind{{i, j, k}};
-          auto const pop = mpi_call(::Communication::Result::one_rank,
-                                    mpi_lb_get_populations, ind);
-          if (!binary) {
-            for (auto const &p : pop) {
-              cpfile << p << "\n";
-            }
-          } else {
-            cpfile.write(reinterpret_cast<const char *>(&pop[0]),
-                         pop.size() * sizeof(double));
-          }
-        }
-      }
+    auto const populations =
+        mpi_lb_get_populations_slice(Utils::Vector3i{}, gridsize);
+    for (auto const &p : populations) {
+      cpfile << p << "\n";
     }
     cpfile.close();
   }
@@ -875,6 +890,17 @@ void lb_lbfluid_load_checkpoint(const std::string &filename, int binary) {
     lb_load_checkpoint_GPU(host_checkpoint_vd.data());
 #endif //  CUDA
   } else if (lattice_switch == ActiveLB::CPU) {
+    mpi_bcast_lb_params(LBParam::DENSITY);
+
+    if (binary) {
+      /* every rank reads its own block */
+      auto const error = mpi_lb_load_checkpoint(filename);
+      if (!error.empty()) {
+        throw std::runtime_error(err_msg + error);
+      }
+      return;
+    }
+
     FILE *cpfile;
     cpfile = fopen(filename.c_str(), "r");
     if (!cpfile) {
@@ -883,24 +909,16 @@ void lb_lbfluid_load_checkpoint(const std::string &filename, int binary) {
 
     auto const gridsize = lblattice.global_grid;
     int saved_gridsize[3];
-    mpi_bcast_lb_params(LBParam::DENSITY);
 
-    if (!binary) {
-      res = fscanf(cpfile, "%i %i %i\n", &saved_gridsize[0], &saved_gridsize[1],
-                   &saved_gridsize[2]);
-      if (res == EOF) {
-        fclose(cpfile);
-        throw std::runtime_error(err_msg + "EOF found.");
-      }
-      if (res != 3) {
-        fclose(cpfile);
-        throw std::runtime_error(err_msg + "incorrectly formatted data.");
-      }
-    } else {
-      if (fread(&saved_gridsize[0], sizeof(int), 3, cpfile) != 3) {
-        fclose(cpfile);
-        throw std::runtime_error(err_msg + "incorrectly formatted data.");
-      }
+    res = fscanf(cpfile, "%i %i %i\n", &saved_gridsize[0], &saved_gridsize[1],
+                 &saved_gridsize[2]);
+    if (res == EOF) {
+      fclose(cpfile);
+      throw std::runtime_error(err_msg + "EOF found.");
+    }
+    if (res != 3) {
+      fclose(cpfile);
+      throw std::runtime_error(err_msg + "incorrectly formatted data.");
     }
     if (saved_gridsize[0] != gridsize[0] || saved_gridsize[1] != gridsize[1] ||
         saved_gridsize[2] != gridsize[2]) {
@@ -914,52 +932,41 @@ void lb_lbfluid_load_checkpoint(const std::string &filename, int binary) {
                                std::to_string(gridsize[2]) + "].");
     }
 
-    for (int i = 0; i < gridsize[0]; i++) {
-      for (int j = 0; j < gridsize[1]; j++) {
-        for (int k = 0; k < gridsize[2]; k++) {
-          Utils::Vector3i ind{{i, j, k}};
-          Utils::Vector19d pop;
-          if (!binary) {
-            res = fscanf(cpfile,
-                         "%lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf "
-                         "%lf %lf %lf %lf %lf %lf \n",
-                         &pop[0], &pop[1], &pop[2], &pop[3], &pop[4], &pop[5],
-                         &pop[6], &pop[7], &pop[8], &pop[9], &pop[10], &pop[11],
-                         &pop[12], &pop[13], &pop[14], &pop[15], &pop[16],
-                         &pop[17], &pop[18]);
-            if (res == EOF) {
-              fclose(cpfile);
-              throw std::runtime_error(err_msg + "EOF found.");
-            }
-            if (res != 19) {
-              fclose(cpfile);
-              throw std::runtime_error(err_msg + "incorrectly formatted data.");
-            }
-          } else {
-            if (fread(pop.data(), sizeof(double), 19, cpfile) != 19) {
-              fclose(cpfile);
-              throw std::runtime_error(err_msg + "incorrectly formatted data.");
-            }
-          }
-          lb_lbnode_set_pop(ind, pop);
-        }
+    /* the nodes in the order of the populations slice */
+    std::vector<double> populations;
+    populations.reserve(D3Q19::n_vel * gridsize[0] * gridsize[1] *
+                        gridsize[2]);
+    for (int n = 0; n < gridsize[0] * gridsize[1] * gridsize[2]; n++) {
+      Utils::Vector19d pop;
+      res = fscanf(cpfile,
+                   "%lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf "
+                   "%lf %lf %lf %lf %lf %lf \n",
+                   &pop[0], &pop[1], &pop[2], &pop[3], &pop[4], &pop[5],
+                   &pop[6], &pop[7], &pop[8], &pop[9], &pop[10], &pop[11],
+                   &pop[12], &pop[13], &pop[14], &pop[15], &pop[16], &pop[17],
+                   &pop[18]);
+      if (res == EOF) {
+        fclose(cpfile);
+        throw std::runtime_error(err_msg + "EOF found.");
       }
-    }
-    if (!binary) {
-      // skip spaces
-      for (int n = 0; n < 2; ++n) {
-        res = fgetc(cpfile);
-        if (res != (int)' ' && res != (int)'\n')
-          break;
+      if (res != 19) {
+        fclose(cpfile);
+        throw std::runtime_error(err_msg + "incorrectly formatted data.");
       }
-    } else {
+      populations.insert(populations.end(), pop.begin(), pop.end());
+    }
+    // skip spaces
+    for (int n = 0; n < 2; ++n) {
       res = fgetc(cpfile);
+      if (res != (int)' ' && res != (int)'\n')
+        break;
     }
     if (res != EOF) {
       fclose(cpfile);
       throw std::runtime_error(err_msg + "extra data found, expected EOF.");
     }
     fclose(cpfile);
+    mpi_lb_set_populations_slice(Utils::Vector3i{}, gridsize, populations);
   } else {
     throw std::runtime_error(
         "To load an LB checkpoint one needs to have already "
@@ -1147,6 +1154,93 @@ const Utils::Vector19d lb_lbnode_get_pop(const Utils::Vector3i &ind) {
   throw NoLBActive();
 }
 
+#ifdef CUDA
+namespace {
+/** Copy the values of a box of nodes out of a GPU array of all nodes
+ *  (x fastest) into row-major order of the box (x slowest).
+ */
+template <class F>
+std::vector<double> lb_gpu_slice(Utils::Vector3i const &lower,
+                                 Utils::Vector3i const &upper,
+                                 std::size_t n_values, F get_values) {
+  auto const shape = upper - lower;
+  std::vector<double> result(n_values * shape[0] * shape[1] * shape[2]);
+  auto out = result.begin();
+  for (int x = lower[0]; x < upper[0]; x++) {
+    for (int y = lower[1]; y < upper[1]; y++) {
+      for (int z = lower[2]; z < upper[2]; z++) {
+        auto const index =
+            x + y * lbpar_gpu.dim_x + z * lbpar_gpu.dim_x * lbpar_gpu.dim_y;
+        out = get_values(index, out);
+      }
+    }
+  }
+  return result;
+}
+} // namespace
+#endif // CUDA
+
+std::vector<double> lb_lbnode_get_density_slice(const Utils::Vector3i &lower,
+                                                const Utils::Vector3i &upper) {
+  if (lattice_switch == ActiveLB::GPU) {
+#ifdef CUDA
+    std::vector<LB_rho_v_pi_gpu> host_values(lbpar_gpu.number_of_nodes);
+    lb_get_values_GPU(host_values.data());
+    return lb_gpu_slice(lower, upper, 1, [&](std::size_t index, auto out) {
+      *out = host_values[index].rho;
+      return ++out;
+    });
+#else
+    return {};
+#endif //  CUDA
+  }
+  if (lattice_switch == ActiveLB::CPU) {
+    return mpi_lb_get_density_slice(lower, upper);
+  }
+  throw NoLBActive();
+}
+
+std::vector<double> lb_lbnode_get_velocity_slice(const Utils::Vector3i &lower,
+                                                 const Utils::Vector3i &upper) {
+  if (lattice_switch == ActiveLB::GPU) {
+#ifdef CUDA
+    std::vector<LB_rho_v_pi_gpu> host_values(lbpar_gpu.number_of_nodes);
+    lb_get_values_GPU(host_values.data());
+    return lb_gpu_slice(lower, upper, 3, [&](std::size_t index, auto out) {
+      return std::copy_n(host_values[index].v, 3, out);
+    });
+#else
+    return {};
+#endif //  CUDA
+  }
+  if (lattice_switch == ActiveLB::CPU) {
+    return mpi_lb_get_velocity_slice(lower, upper);
+  }
+  throw NoLBActive();
+}
+
+std::vector<double> lb_lbnode_get_pop_slice(const Utils::Vector3i &lower,
+                                            const Utils::Vector3i &upper) {
+  if (lattice_switch == ActiveLB::GPU) {
+#ifdef CUDA
+    auto const n_nodes = lbpar_gpu.number_of_nodes;
+    std::vector<float> host_populations(LBQ * n_nodes);
+    lb_save_checkpoint_GPU(host_populations.data());
+    return lb_gpu_slice(lower, upper, LBQ, [&](std::size_t index, auto out) {
+      for (int i = 0; i < LBQ; ++i)
+        *out++ = host_populations[i * n_nodes + index];
+      return out;
+    });
+#else
+    return {};
+#endif //  CUDA
+  }
+  if (lattice_switch == ActiveLB::CPU) {
+    return mpi_lb_get_populations_slice(lower, upper);
+  }
+  throw NoLBActive();
+}
+
 void lb_lbnode_set_density(const Utils::Vector3i &ind, double p_density) {
   if (lattice_switch == ActiveLB::GPU) {
 #ifdef CUDA
@@ -96,6 +96,12 @@ void lb_lbfluid_set_gamma_odd(double p_gamma_odd);
  */
 void lb_lbfluid_set_gamma_even(double p_gamma_even);
 
+/**
+ * @brief Stream in place in a single population array (CPU only).
+ * Takes effect when the lattice is (re-)initialized.
+ */
+void lb_lbfluid_set_in_place_streaming(bool in_place);
+
 /**
  * @brief Set the global LB lattice spacing.
  */
@@ -209,6 +215,36 @@ int lb_lbnode_get_boundary(const Utils::Vector3i &ind);
  */
 const Utils::Vector19d lb_lbnode_get_pop(const Utils::Vector3i &ind);
 
+/**
+ * @brief Get the LB fluid densities for a box of nodes.
+ *
+ * The box spans the nodes from @p lower up to but excluding @p upper.
+ * All ranks contribute their part of the box in a single collective
+ * call, so this is much faster than iterating over the nodes.
+ *
+ * @return The values in row-major order (x index slowest).
+ */
+std::vector<double> lb_lbnode_get_density_slice(const Utils::Vector3i &lower,
+                                                const Utils::Vector3i &upper);
+
+/**
+ * @brief Get the LB fluid velocities for a box of nodes.
+ *
+ * See @ref lb_lbnode_get_density_slice. The three components of a node
+ * are contiguous.
+ */
+std::vector<double> lb_lbnode_get_velocity_slice(const Utils::Vector3i &lower,
+                                                 const Utils::Vector3i &upper);
+
+/**
+ * @brief Get the LB fluid populations for a box of nodes.
+ *
+ * See @ref lb_lbnode_get_density_slice. The 19 populations of a node
+ * are contiguous.
+ */
+std::vector<double> lb_lbnode_get_pop_slice(const Utils::Vector3i &lower,
+                                            const Utils::Vector3i &upper);
+
 /* IO routines */
 void lb_lbfluid_print_vtk_boundary(const std::string &filename);
 void lb_lbfluid_print_vtk_velocity(const std::string &filename,
@@ -47,6 +47,7 @@
 #include "grid_based_algorithms/lb_interface.hpp"
 #include "grid_based_algorithms/lb_particle_coupling.hpp"
 #include "immersed_boundaries.hpp"
+#include "load_balancing.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "npt.hpp"
 #include "particle_data.hpp"
@@ -57,6 +58,7 @@
 #include "thermostat.hpp"
 #include "virtual_sites.hpp"
 
+#include "integrators/respa.hpp"
 #include "integrators/steepest_descent.hpp"
 #include "integrators/velocity_verlet_inline.hpp"
 #include "integrators/velocity_verlet_npt.hpp"
@@ -125,12 +127,15 @@ void integrator_sanity_checks() {
 bool integrator_step_1(ParticleRange &particles) {
   switch (integ_switch) {
   case INTEG_METHOD_STEEPEST_DESCENT:
-    if (steepest_descent_step(particles))
+    if (minimize_energy_step(particles))
       return true; // early exit
     break;
   case INTEG_METHOD_NVT:
     velocity_verlet_step_1(particles);
     break;
+  case INTEG_METHOD_RESPA:
+    respa_step_1(particles);
+    break;
 #ifdef NPT
   case INTEG_METHOD_NPT_ISO:
     velocity_verlet_npt_step_1(particles);
@@ -151,6 +156,9 @@ void integrator_step_2(ParticleRange &particles) {
   case INTEG_METHOD_NVT:
     velocity_verlet_step_2(particles);
     break;
+  case INTEG_METHOD_RESPA:
+    respa_step_2(particles);
+    break;
 #ifdef NPT
   case INTEG_METHOD_NPT_ISO:
     velocity_verlet_npt_step_2(particles);
@@ -251,8 +259,9 @@ void integrate_vv(int n_steps, int reuse_forces) {
     virtual_sites()->update();
 #endif
 
-    // Communication step: distribute ghost positions
-    cells_update_ghosts();
+    // Communication step: distribute ghost positions, this
+    // may be overlapped with the short-range force calculation
+    cells_begin_ghost_update();
 
     particles = cell_structure.local_cells().particles();
 
@@ -290,6 +299,8 @@ void integrate_vv(int n_steps, int reuse_forces) {
     }
 #endif
 
+    LoadBalancing::integration_step();
+
     if (check_runtime_errors(comm_cart))
       break;
 
@@ -30,6 +30,7 @@
 #define INTEG_METHOD_NPT_ISO 0
 #define INTEG_METHOD_NVT 1
 #define INTEG_METHOD_STEEPEST_DESCENT 2
+#define INTEG_METHOD_RESPA 3
 
 /************************************************************/
 /** \name Exported Variables */
@@ -83,7 +84,8 @@ void integrator_sanity_checks();
     the forces still stored with the particles for the first time step.
 
     @details This function calls two hooks for propagation kernels such as
-    velocity verlet, velocity verlet + npt box changes, and steepest_descent.
+    velocity verlet, velocity verlet + npt box changes, multiple time step
+    velocity verlet (r-RESPA) and steepest_descent.
     One hook is called before and one after the force calculation.
     It is up to the propagation kernels to increment the simulation time.
 
@@ -0,0 +1,128 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+  Copyright (C) 2002,2003,2004,2005,2006,2007,2008,2009,2010
+  Max-Planck-Institute for Polymer Research, Theory Group
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "integrators/fire.hpp"
+#include "cells.hpp"
+#include "communication.hpp"
+#include "integrate.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/mpi/collectives/all_reduce.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace {
+/** \name FIRE parameters of Bitzek et al. */
+/*@{*/
+constexpr int n_min = 5;
+constexpr double f_inc = 1.1;
+constexpr double f_dec = 0.5;
+constexpr double alpha_start = 0.1;
+constexpr double f_alpha = 0.99;
+/** Maximal time step in units of @ref time_step */
+constexpr double dt_max_factor = 10.;
+/*@}*/
+
+/** State of the minimization, identical on all nodes */
+struct FireState {
+  double dt;
+  double alpha;
+  /** Number of consecutive steps with positive power */
+  int n_positive;
+};
+
+FireState state;
+
+void zero_velocities(const ParticleRange &particles) {
+  for (auto &p : particles)
+    p.m.v = {};
+}
+} // namespace
+
+void fire_init(const ParticleRange &particles) {
+  state = {time_step, alpha_start, 0};
+  zero_velocities(particles);
+}
+
+void fire_finalize(const ParticleRange &particles) {
+  zero_velocities(particles);
+}
+
+bool fire_step(const ParticleRange &particles,
+               const MinimizeEnergyParameters &params) {
+  // Power, square velocity and square force, and the largest force
+  Utils::Vector3d sums{};
+  auto f_max = -std::numeric_limits<double>::max();
+  for (auto const &p : particles) {
+    auto const f = minimization_force(p);
+    sums[0] += f * p.m.v;
+    sums[1] += p.m.v.norm2();
+    sums[2] += f.norm2();
+    f_max = std::max(f_max, minimization_force2(p));
+  }
+
+  if (minimization_converged(f_max))
+    return true;
+
+  sums = boost::mpi::all_reduce(comm_cart, sums, std::plus<Utils::Vector3d>());
+  auto const power = sums[0];
+
+  if (power > 0.) {
+    // Turn the velocity towards the force
+    auto const mix =
+        (sums[2] > 0.) ? state.alpha * std::sqrt(sums[1] / sums[2]) : 0.;
+    for (auto &p : particles)
+      p.m.v = (1. - state.alpha) * p.m.v + mix * minimization_force(p);
+
+    if (++state.n_positive > n_min) {
+      state.dt = std::min(state.dt * f_inc, dt_max_factor * time_step);
+      state.alpha *= f_alpha;
+    }
+  } else {
+    // Uphill: stop and restart with a smaller step
+    state.n_positive = 0;
+    state.dt *= f_dec;
+    state.alpha = alpha_start;
+    zero_velocities(particles);
+  }
+
+  for (auto &p : particles) {
+    // Semi-implicit Euler step, the velocity is that of the FIRE dynamics
+    p.m.v += (state.dt / p.p.mass) * minimization_force(p);
+    auto dx = state.dt * p.m.v;
+
+    // Crop the displacement to the maximum allowed by user
+    auto const l = dx.norm();
+    if (l > params.max_displacement)
+      dx *= params.max_displacement / l;
+    p.r.p += dx;
+
+    minimization_rotate(p, params.gamma, params.max_displacement);
+  }
+
+  set_resort_particles(Cells::RESORT_LOCAL);
+
+  return false;
+}
@@ -0,0 +1,56 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+  Copyright (C) 2002,2003,2004,2005,2006,2007,2008,2009,2010
+  Max-Planck-Institute for Polymer Research, Theory Group
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef INTEGRATORS_FIRE_HPP
+#define INTEGRATORS_FIRE_HPP
+
+/** \file
+ *  Fast inertial relaxation engine (FIRE) for energy minimization.
+ *
+ *  The particles follow damped molecular dynamics in which the velocity
+ *  is turned towards the force; the time step grows while the power
+ *  @f$ P = \vec{F}\cdot\vec{v} @f$ stays positive and the motion is
+ *  stopped as soon as it becomes uphill. See Bitzek et al.,
+ *  Phys. Rev. Lett. 97, 170201 (2006). The initial time step is
+ *  @ref time_step, the displacement of a particle per step is capped at
+ *  @ref MinimizeEnergyParameters::max_displacement "max_displacement".
+ *  The particle velocities are used as the FIRE velocities and are zero
+ *  before and after the minimization.
+ *
+ *  Implementation in fire.cpp.
+ */
+
+#include "ParticleRange.hpp"
+#include "integrators/steepest_descent.hpp"
+
+/** Reset the FIRE state and the particle velocities */
+void fire_init(const ParticleRange &particles);
+
+/** Zero the particle velocities after the minimization */
+void fire_finalize(const ParticleRange &particles);
+
+/** FIRE integrator
+ *  @return whether the maximum force/torque encountered is below the user
+ *          limit @ref MinimizeEnergyParameters::f_max "f_max".
+ */
+bool fire_step(const ParticleRange &particles,
+               const MinimizeEnergyParameters &params);
+
+#endif
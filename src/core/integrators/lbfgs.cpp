@@ -0,0 +1,262 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+  Copyright (C) 2002,2003,2004,2005,2006,2007,2008,2009,2010
+  Max-Planck-Institute for Polymer Research, Theory Group
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "integrators/lbfgs.hpp"
+#include "cells.hpp"
+#include "communication.hpp"
+#include "particle_data.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/mpi/collectives/all_gather.hpp>
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/collectives/all_to_all.hpp>
+#include <boost/mpi/operations.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+/** L-BFGS data of one particle */
+struct LbfgsParticle {
+  /** Force before the last step */
+  Utils::Vector3d f_old = {};
+  /** Last step */
+  Utils::Vector3d step = {};
+  /** Position differences, oldest first */
+  std::vector<Utils::Vector3d> s;
+  /** Gradient differences, oldest first */
+  std::vector<Utils::Vector3d> y;
+
+  template <class Archive> void serialize(Archive &ar, const unsigned int) {
+    ar &f_old &step &s &y;
+  }
+};
+
+/** History of the local particles, by particle id */
+std::unordered_map<int, LbfgsParticle> history;
+/** @f$ 1/(s_k\cdot y_k) @f$ of the stored pairs, identical on all nodes */
+std::vector<double> rho;
+/** Scale of the initial inverse Hessian */
+double h0;
+/** Whether there is a previous step to build a pair from */
+bool started = false;
+
+bool is_local(int id) {
+  return id < max_local_particles && local_particles[id] &&
+         !local_particles[id]->l.ghost;
+}
+
+double global_sum(double local) {
+  return boost::mpi::all_reduce(comm_cart, local, std::plus<double>());
+}
+
+void reset(double gamma) {
+  rho.clear();
+  for (auto &h : history) {
+    h.second.s.clear();
+    h.second.y.clear();
+  }
+  h0 = gamma;
+}
+
+/** Move the history of particles that changed the node along with them.
+ *  Particles move rarely, so the common case costs a single reduction.
+ */
+void redistribute(const ParticleRange &particles) {
+  std::vector<int> missing;
+  for (auto const &p : particles)
+    if (history.find(p.identity()) == history.end())
+      missing.push_back(p.identity());
+
+  if (!boost::mpi::all_reduce(comm_cart, !missing.empty(),
+                              std::logical_or<bool>()))
+    return;
+
+  std::vector<std::vector<int>> requests;
+  boost::mpi::all_gather(comm_cart, missing, requests);
+
+  using Entry = std::pair<int, LbfgsParticle>;
+  std::vector<std::vector<Entry>> send_buf(comm_cart.size());
+  for (int node = 0; node < comm_cart.size(); node++) {
+    for (auto const id : requests[node]) {
+      auto it = history.find(id);
+      if (it != history.end()) {
+        send_buf[node].emplace_back(id, std::move(it->second));
+        history.erase(it);
+      }
+    }
+  }
+
+  std::vector<std::vector<Entry>> recv_buf(comm_cart.size());
+  boost::mpi::all_to_all(comm_cart, send_buf, recv_buf);
+  for (auto &entries : recv_buf)
+    for (auto &e : entries)
+      history.insert(std::move(e));
+
+  // Particles that are new to the minimization start without curvature
+  // information, but with a history of the same length as all others.
+  for (auto const id : missing) {
+    if (history.find(id) == history.end()) {
+      auto &h = history[id];
+      h.f_old = minimization_force(*local_particles[id]);
+      h.s.resize(rho.size());
+      h.y.resize(rho.size());
+    }
+  }
+
+  // Drop the history of particles that no longer exist
+  for (auto it = history.begin(); it != history.end();) {
+    if (is_local(it->first))
+      ++it;
+    else
+      it = history.erase(it);
+  }
+}
+} // namespace
+
+void lbfgs_init(const MinimizeEnergyParameters &params) {
+  history.clear();
+  started = false;
+  reset(params.gamma);
+}
+
+void lbfgs_finalize() {
+  history.clear();
+  rho.clear();
+  started = false;
+}
+
+bool lbfgs_step(const ParticleRange &particles,
+                const MinimizeEnergyParameters &params) {
+  auto f_max = -std::numeric_limits<double>::max();
+  for (auto const &p : particles)
+    f_max = std::max(f_max, minimization_force2(p));
+
+  if (minimization_converged(f_max))
+    return true;
+
+  redistribute(particles);
+
+  std::vector<LbfgsParticle *> entries;
+  std::vector<Utils::Vector3d> forces;
+  for (auto const &p : particles) {
+    entries.push_back(&history.at(p.identity()));
+    forces.push_back(minimization_force(p));
+  }
+  auto const n = entries.size();
+
+  if (started) {
+    // Curvature of the last step; y is the change of the gradient -F
+    Utils::Vector2d sy_yy{};
+    for (std::size_t i = 0; i < n; i++) {
+      auto const y = entries[i]->f_old - forces[i];
+      sy_yy[0] += entries[i]->step * y;
+      sy_yy[1] += y.norm2();
+    }
+    sy_yy = boost::mpi::all_reduce(comm_cart, sy_yy,
+                                   std::plus<Utils::Vector2d>());
+
+    if (sy_yy[0] > 0.) {
+      auto const trim =
+          rho.size() >= static_cast<std::size_t>(params.lbfgs_memory);
+      for (std::size_t i = 0; i < n; i++) {
+        auto &h = *entries[i];
+        if (trim) {
+          h.s.erase(h.s.begin());
+          h.y.erase(h.y.begin());
+        }
+        h.s.push_back(h.step);
+        h.y.push_back(h.f_old - forces[i]);
+      }
+      if (trim)
+        rho.erase(rho.begin());
+      rho.push_back(1. / sy_yy[0]);
+      h0 = sy_yy[0] / sy_yy[1];
+    } else {
+      reset(params.gamma);
+    }
+  }
+
+  // Two-loop recursion for the step H F = -H grad
+  auto const m = rho.size();
+  auto q = forces;
+  std::vector<double> alpha(m);
+  for (std::size_t k = m; k-- > 0;) {
+    auto local = 0.;
+    for (std::size_t i = 0; i < n; i++)
+      local += entries[i]->s[k] * q[i];
+    alpha[k] = rho[k] * global_sum(local);
+    for (std::size_t i = 0; i < n; i++)
+      q[i] -= alpha[k] * entries[i]->y[k];
+  }
+  for (auto &d : q)
+    d *= h0;
+  for (std::size_t k = 0; k < m; k++) {
+    auto local = 0.;
+    for (std::size_t i = 0; i < n; i++)
+      local += entries[i]->y[k] * q[i];
+    auto const beta = rho[k] * global_sum(local);
+    for (std::size_t i = 0; i < n; i++)
+      q[i] += (alpha[k] - beta) * entries[i]->s[k];
+  }
+
+  // Fall back to steepest descent if the step is not downhill
+  auto descent = 0.;
+  for (std::size_t i = 0; i < n; i++)
+    descent += q[i] * forces[i];
+  if (!(global_sum(descent) > 0.)) {
+    reset(params.gamma);
+    for (std::size_t i = 0; i < n; i++)
+      q[i] = params.gamma * forces[i];
+  }
+
+  // Crop the step to the maximum displacement allowed by user
+  auto d_max = 0.;
+  for (auto const &d : q)
+    d_max = std::max(d_max, d.norm());
+  d_max = boost::mpi::all_reduce(comm_cart, d_max,
+                                 boost::mpi::maximum<double>());
+  auto const scale =
+      (d_max > params.max_displacement) ? params.max_displacement / d_max : 1.;
+
+  std::size_t i = 0;
+  for (auto &p : particles) {
+    auto &h = *entries[i];
+    h.step = scale * q[i];
+    h.f_old = forces[i];
+    p.r.p += h.step;
+    minimization_rotate(p, params.gamma, params.max_displacement);
+    i++;
+  }
+  started = true;
+
+  set_resort_particles(Cells::RESORT_LOCAL);
+
+  return false;
+}
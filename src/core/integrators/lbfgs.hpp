@@ -0,0 +1,61 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+  Copyright (C) 2002,2003,2004,2005,2006,2007,2008,2009,2010
+  Max-Planck-Institute for Polymer Research, Theory Group
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef INTEGRATORS_LBFGS_HPP
+#define INTEGRATORS_LBFGS_HPP
+
+/** \file
+ *  Limited-memory BFGS (L-BFGS) energy minimization.
+ *
+ *  The step is the force multiplied with an approximation of the inverse
+ *  Hessian built from the last
+ *  @ref MinimizeEnergyParameters::lbfgs_memory "lbfgs_memory" position
+ *  and force differences, evaluated with the two-loop recursion of
+ *  Nocedal, Math. Comp. 35, 773 (1980). There is no line search: the step
+ *  is scaled down such that no particle moves by more than
+ *  @ref MinimizeEnergyParameters::max_displacement "max_displacement",
+ *  and the history is dropped whenever the curvature condition fails or
+ *  the step is not downhill, in which case a steepest descent step
+ *  with @ref MinimizeEnergyParameters::gamma "gamma" is taken.
+ *
+ *  The history of a particle is stored on the node that owns it and
+ *  migrates with the particle; every scalar product is a reduction over
+ *  all nodes.
+ *
+ *  Implementation in lbfgs.cpp.
+ */
+
+#include "ParticleRange.hpp"
+#include "integrators/steepest_descent.hpp"
+
+/** Clear the L-BFGS history */
+void lbfgs_init(const MinimizeEnergyParameters &params);
+
+/** Release the L-BFGS history after the minimization */
+void lbfgs_finalize();
+
+/** L-BFGS integrator
+ *  @return whether the maximum force/torque encountered is below the user
+ *          limit @ref MinimizeEnergyParameters::f_max "f_max".
+ */
+bool lbfgs_step(const ParticleRange &particles,
+                const MinimizeEnergyParameters &params);
+
+#endif
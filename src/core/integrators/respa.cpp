@@ -0,0 +1,82 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+  Copyright (C) 2002,2003,2004,2005,2006,2007,2008,2009,2010
+  Max-Planck-Institute for Polymer Research, Theory Group
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "integrators/respa.hpp"
+#include "communication.hpp"
+#include "errorhandling.hpp"
+#include "event.hpp"
+#include "global.hpp"
+#include "integrate.hpp"
+#include "integrators/velocity_verlet_inline.hpp"
+
+#include <utils/constants.hpp>
+
+RespaParameters respa_params;
+
+/** Position within the outer time step, the forces are due when this is
+ *  a multiple of the respective number of steps.
+ */
+static int respa_step = 0;
+
+static int respa_factor(int steps) {
+  if (integ_switch != INTEG_METHOD_RESPA)
+    return 1;
+  return (respa_step % steps == 0) ? steps : 0;
+}
+
+int respa_long_range_factor() {
+  return respa_factor(respa_params.long_range_steps);
+}
+
+int respa_short_range_factor() {
+  return respa_factor(respa_params.short_range_steps);
+}
+
+void respa_step_1(const ParticleRange &particles) {
+  velocity_verlet_step_1(particles);
+  respa_step = (respa_step + 1) % respa_params.long_range_steps;
+}
+
+void respa_step_2(const ParticleRange &particles) {
+  velocity_verlet_step_2(particles);
+}
+
+static void mpi_set_respa_local(int long_range_steps, int short_range_steps) {
+  respa_params.long_range_steps = long_range_steps;
+  respa_params.short_range_steps = short_range_steps;
+  respa_step = 0;
+  integ_switch = INTEG_METHOD_RESPA;
+  on_parameter_change(FIELD_INTEG_SWITCH);
+}
+
+REGISTER_CALLBACK(mpi_set_respa_local)
+
+int integrate_set_respa(int long_range_steps, int short_range_steps) {
+  if (short_range_steps < 1 || long_range_steps < short_range_steps ||
+      long_range_steps % short_range_steps != 0) {
+    runtimeErrorMsg() << "RESPA: the number of long-range steps has to be a "
+                         "multiple of the number of short-range steps";
+    return ES_ERROR;
+  }
+
+  mpi_call_all(mpi_set_respa_local, long_range_steps, short_range_steps);
+  return ES_OK;
+}
@@ -0,0 +1,80 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+  Copyright (C) 2002,2003,2004,2005,2006,2007,2008,2009,2010
+  Max-Planck-Institute for Polymer Research, Theory Group
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef INTEGRATORS_RESPA_HPP
+#define INTEGRATORS_RESPA_HPP
+
+/** \file
+ *  Multiple time step (r-RESPA) variant of the Velocity Verlet integrator.
+ *
+ *  The slowly varying force contributions are only evaluated every few
+ *  time steps and are then applied as an impulse: their force is
+ *  multiplied by the number of steps between two evaluations, while the
+ *  steps in between do not see them at all. With the half-step kicks of
+ *  @ref velocity_verlet_step_2 and @ref velocity_verlet_step_1 around a
+ *  force evaluation this is exactly the nested Verlet-I/r-RESPA scheme
+ *  of Tuckerman, Berne and Martyna (J. Chem. Phys. 97, 1990 (1992)).
+ *  @ref time_step is the innermost step.
+ *
+ *  Implementation in respa.cpp.
+ */
+
+#include "ParticleRange.hpp"
+
+/** Parameters of the multiple time step integrator */
+struct RespaParameters {
+  /** Number of time steps between two evaluations of the long-range
+   *  (k-space) forces. A multiple of @ref short_range_steps.
+   */
+  int long_range_steps = 1;
+  /** Number of time steps between two evaluations of the non-bonded
+   *  short-range forces. The bonded forces are evaluated every step.
+   */
+  int short_range_steps = 1;
+};
+
+extern RespaParameters respa_params;
+
+/** Factor for the long-range forces in the current force calculation.
+ *  @return 1 if the multiple time step integrator is not active, the
+ *          impulse factor on steps where the long-range forces are due
+ *          and 0 otherwise.
+ */
+int respa_long_range_factor();
+
+/** Factor for the non-bonded short-range forces in the current force
+ *  calculation, see @ref respa_long_range_factor.
+ */
+int respa_short_range_factor();
+
+/** First half of a multiple time step, see @ref velocity_verlet_step_1 */
+void respa_step_1(const ParticleRange &particles);
+
+/** Second half of a multiple time step, see @ref velocity_verlet_step_2 */
+void respa_step_2(const ParticleRange &particles);
+
+/** Select the multiple time step integrator on all nodes.
+ *  @param long_range_steps  see @ref RespaParameters::long_range_steps
+ *  @param short_range_steps see @ref RespaParameters::short_range_steps
+ *  @return ES_OK on success, ES_ERROR if the step numbers are invalid.
+ */
+int integrate_set_respa(int long_range_steps, int short_range_steps);
+
+#endif
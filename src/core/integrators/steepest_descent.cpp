@@ -24,6 +24,8 @@
 #include "communication.hpp"
 #include "event.hpp"
 #include "integrate.hpp"
+#include "integrators/fire.hpp"
+#include "integrators/lbfgs.hpp"
 #include "rotation.hpp"
 
 #include <utils/math/sqr.hpp>
@@ -38,73 +40,109 @@
 /** Currently active steepest descent instance */
 static MinimizeEnergyParameters *params = nullptr;
 
+/** Number of steps of the current minimization */
+static int n_minimization_steps = 0;
+
+Utils::Vector3d minimization_force(const Particle &p) {
+  Utils::Vector3d f{};
+#ifdef VIRTUAL_SITES
+  // Virtual sites are placed by their parent, not by the minimizer
+  if (p.p.is_virtual)
+    return f;
+#endif
+  for (int j = 0; j < 3; j++) {
+#ifdef EXTERNAL_FORCES
+    // Skip, if coordinate is fixed
+    if (p.p.ext_flag & COORD_FIXED(j))
+      continue;
+#endif
+    f[j] = p.f.f[j];
+  }
+  return f;
+}
+
+double minimization_force2(const Particle &p) {
+  auto const f = minimization_force(p).norm2();
+#ifdef ROTATION
+  return std::max(f, p.f.torque.norm2());
+#else
+  return f;
+#endif
+}
+
+void minimization_rotate(Particle &p, double gamma, double max_displacement) {
+#ifdef ROTATION
+  // Rotational increment
+  auto const dq = gamma * p.f.torque; // Vector parallel to torque
+
+  // Normalize rotation axis and compute amount of rotation
+  auto const l = dq.norm();
+  if (l > 0.0) {
+    auto const axis = dq / l;
+    auto const angle =
+        boost::algorithm::clamp(l, -max_displacement, max_displacement);
+
+    // Rotate the particle around axis dq by amount l
+    local_rotate_particle(p, axis, angle);
+  }
+#endif
+}
+
+bool minimization_converged(double f_max2) {
+  // Synchronize maximum force/torque encountered
+  namespace mpi = boost::mpi;
+  auto const f_max_global =
+      mpi::all_reduce(comm_cart, f_max2, mpi::maximum<double>());
+
+  return (sqrt(f_max_global) < params->f_max);
+}
+
 bool steepest_descent_step(const ParticleRange &particles) {
   // Maximal force encountered on node
   auto f_max = -std::numeric_limits<double>::max();
 
   // Iteration over all local particles
   for (auto &p : particles) {
-    auto f = 0.0;
+    auto const f = minimization_force(p);
 
     // For all Cartesian coordinates
     for (int j = 0; j < 3; j++) {
-#ifdef EXTERNAL_FORCES
-      // Skip, if coordinate is fixed
-      if (!(p.p.ext_flag & COORD_FIXED(j)))
-#endif
-#ifdef VIRTUAL_SITES
-        // Skip positional increments of virtual particles
-        if (!p.p.is_virtual)
-#endif
-        {
-          // Square of force on particle
-          f += Utils::sqr(p.f.f[j]);
-
-          // Positional increment, crop to maximum allowed by user
-          auto const dp = boost::algorithm::clamp(params->gamma * p.f.f[j],
-                                                  -params->max_displacement,
-                                                  params->max_displacement);
-
-          // Move particle
-          p.r.p[j] += dp;
-        }
-    }
-#ifdef ROTATION
-    {
-      // Rotational increment
-      auto const dq = params->gamma * p.f.torque; // Vector parallel to torque
-      auto const t = p.f.torque.norm2();
-
-      // Normalize rotation axis and compute amount of rotation
-      auto const l = dq.norm();
-      if (l > 0.0) {
-        auto const axis = dq / l;
-        auto const angle = boost::algorithm::clamp(l, -params->max_displacement,
-                                                   params->max_displacement);
-
-        // Rotate the particle around axis dq by amount l
-        local_rotate_particle(p, axis, angle);
-      }
-
-      f_max = std::max(f_max, t);
+      // Positional increment, crop to maximum allowed by user
+      auto const dp = boost::algorithm::clamp(params->gamma * f[j],
+                                              -params->max_displacement,
+                                              params->max_displacement);
+
+      // Move particle
+      p.r.p[j] += dp;
     }
-#endif
+
+    minimization_rotate(p, params->gamma, params->max_displacement);
+
     // Note maximum force/torque encountered
-    f_max = std::max(f_max, f);
+    f_max = std::max(f_max, minimization_force2(p));
   }
 
   set_resort_particles(Cells::RESORT_LOCAL);
 
-  // Synchronize maximum force/torque encountered
-  namespace mpi = boost::mpi;
-  auto const f_max_global =
-      mpi::all_reduce(comm_cart, f_max, mpi::maximum<double>());
+  return minimization_converged(f_max);
+}
 
-  return (sqrt(f_max_global) < params->f_max);
+bool minimize_energy_step(const ParticleRange &particles) {
+  ++n_minimization_steps;
+  switch (params->method) {
+  case MINIMIZE_FIRE:
+    return fire_step(particles, *params);
+  case MINIMIZE_LBFGS:
+    return lbfgs_step(particles, *params);
+  default:
+    return steepest_descent_step(particles);
+  }
 }
 
 void minimize_energy_init(const double f_max, const double gamma,
-                          const int max_steps, const double max_displacement) {
+                          const int max_steps, const double max_displacement,
+                          const MinimizationMethod method,
+                          const int lbfgs_memory) {
   if (!params)
     params = new MinimizeEnergyParameters;
 
@@ -112,15 +150,28 @@ void minimize_energy_init(const double f_max, const double gamma,
   params->gamma = gamma;
   params->max_steps = max_steps;
   params->max_displacement = max_displacement;
+  params->method = method;
+  params->lbfgs_memory = lbfgs_memory;
 }
 
-void minimize_energy() {
+int minimize_energy() {
   if (!params)
     params = new MinimizeEnergyParameters;
 
   MPI_Bcast(params, sizeof(MinimizeEnergyParameters), MPI_BYTE, 0, comm_cart);
   int integ_switch_old = integ_switch;
   integ_switch = INTEG_METHOD_STEEPEST_DESCENT;
+  if (params->method == MINIMIZE_FIRE)
+    fire_init(cell_structure.local_cells().particles());
+  else if (params->method == MINIMIZE_LBFGS)
+    lbfgs_init(*params);
+  n_minimization_steps = 0;
   integrate_vv(params->max_steps, -1);
+  if (params->method == MINIMIZE_FIRE)
+    fire_finalize(cell_structure.local_cells().particles());
+  else if (params->method == MINIMIZE_LBFGS)
+    lbfgs_finalize();
   integ_switch = integ_switch_old;
+
+  return n_minimization_steps;
 }
@@ -23,8 +23,21 @@
 #define __MINIMIZE_ENERGY_HPP
 
 #include "ParticleRange.hpp"
+#include "particle_data.hpp"
 
-/** Parameters for the steepest descent algorithm */
+#include <utils/Vector.hpp>
+
+/** Energy minimization algorithms */
+enum MinimizationMethod {
+  /** Steepest descent with a capped step */
+  MINIMIZE_STEEPEST_DESCENT,
+  /** Fast inertial relaxation engine, see fire.hpp */
+  MINIMIZE_FIRE,
+  /** Limited-memory BFGS, see lbfgs.hpp */
+  MINIMIZE_LBFGS
+};
+
+/** Parameters for the energy minimization algorithms */
 struct MinimizeEnergyParameters {
   /** Maximal particle force
    *
@@ -42,22 +55,29 @@ struct MinimizeEnergyParameters {
    *  in one direction.
    */
   double max_displacement;
+  /** Minimization algorithm */
+  MinimizationMethod method;
+  /** Number of correction pairs kept by L-BFGS */
+  int lbfgs_memory;
 };
 
-/** Steepest descent initializer
+/** Energy minimization initializer
  *
  *  Sets the parameters in @ref MinimizeEnergyParameters
  */
 void minimize_energy_init(double f_max, double gamma, int max_steps,
-                          double max_displacement);
+                          double max_displacement,
+                          MinimizationMethod method = MINIMIZE_STEEPEST_DESCENT,
+                          int lbfgs_memory = 5);
 
-/** Steepest descent main integration loop
+/** Energy minimization main integration loop
  *
  *  Integration stops when the maximal force is lower than the user limit
  *  @ref MinimizeEnergyParameters::f_max "f_max" or when the maximal number
  *  of steps @ref MinimizeEnergyParameters::max_steps "max_steps" is reached.
+ *  @return number of steps, including the one that detected the convergence
  */
-void minimize_energy();
+int minimize_energy();
 
 /** Steepest descent integrator
  *  @return whether the maximum force/torque encountered is below the user
@@ -65,4 +85,33 @@ void minimize_energy();
  */
 bool steepest_descent_step(const ParticleRange &particles);
 
+/** Step of the selected minimization algorithm
+ *  @return whether the maximum force/torque encountered is below the user
+ *          limit @ref MinimizeEnergyParameters::f_max "f_max".
+ */
+bool minimize_energy_step(const ParticleRange &particles);
+
+/** \name Helpers shared by the minimization algorithms */
+/*@{*/
+/** Force on a particle without the fixed coordinates and with no force on
+ *  virtual sites, i.e. the direction in which the particle may move.
+ */
+Utils::Vector3d minimization_force(const Particle &p);
+
+/** Square of the largest force or torque component that takes part in the
+ *  convergence criterion.
+ */
+double minimization_force2(const Particle &p);
+
+/** Rotate a particle around its torque as in the steepest descent scheme,
+ *  by at most @p max_displacement.
+ */
+void minimization_rotate(Particle &p, double gamma, double max_displacement);
+
+/** Check the convergence criterion on all nodes.
+ *  @param f_max2 Largest square force or torque on this node
+ */
+bool minimization_converged(double f_max2);
+/*@}*/
+
 #endif /* __MINIMIZE_ENERGY */
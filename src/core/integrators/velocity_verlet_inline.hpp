@@ -2,10 +2,15 @@
 #define INTEGRATORS_VELOCITY_VERLET_HPP
 
 #include "ParticleRange.hpp"
+#include "cells.hpp"
 #include "config.hpp"
 #include "particle_data.hpp"
 #include "rotation.hpp"
 
+#include <utils/math/sqr.hpp>
+
+#include <limits>
+
 /** Propagate the velocities and positions. Integration steps before force
  *  calculation of the Velocity Verlet integrator: <br> \f[ v(t+0.5 \Delta t) =
  *  v(t) + 0.5 \Delta t f(t)/m \f] <br> \f[ p(t+\Delta t) = p(t) + \Delta t
@@ -13,7 +18,11 @@
  */
 inline void velocity_verlet_propagate_vel_pos(const ParticleRange &particles) {
 
-  auto const skin2 = Utils::sqr(0.5 * skin);
+  /* With incremental Verlet list updates the particles are only
+   * resorted when they leave their cell, see cells_update_ghosts(). */
+  auto const skin2 = incremental_verlet_updates()
+                         ? std::numeric_limits<double>::infinity()
+                         : Utils::sqr(0.5 * skin);
   for (auto &p : particles) {
 #ifdef ROTATION
     propagate_omega_quat_particle(p);
@@ -0,0 +1,211 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** \file
+ *  Dynamic load balancing for the domain decomposition.
+ *
+ *  The corresponding header file is load_balancing.hpp.
+ */
+
+#include "load_balancing.hpp"
+#include "cells.hpp"
+#include "communication.hpp"
+#include "electrostatics_magnetostatics/coulomb.hpp"
+#include "electrostatics_magnetostatics/dipole.hpp"
+#include "grid.hpp"
+#include "grid_based_algorithms/lb_interface.hpp"
+
+#include <utils/mpi/cart_comm.hpp>
+
+#include <boost/algorithm/clamp.hpp>
+#include <boost/mpi/collectives/all_gather.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+namespace LoadBalancing {
+namespace {
+/** Fraction of the distance to the balanced cuts by which the cuts
+ *  are moved per adjustment, to damp oscillations. */
+constexpr double relaxation = 0.5;
+/** Minimal width of a slab relative to the width in the regular
+ *  decomposition, if the interaction range allows smaller ones. */
+constexpr double min_relative_width = 0.1;
+/** Changes of the cuts relative to the width in the regular
+ *  decomposition below which the cell system is not re-initialized. */
+constexpr double min_relative_change = 0.01;
+
+/** Short-range force time since the last adjustment. */
+double force_time = 0.;
+/** Integration steps since the last adjustment. */
+int steps = 0;
+
+/** The grid based methods need the regular decomposition. */
+bool domains_adjustable() {
+  if (cell_structure.type != CELL_STRUCTURE_DOMDEC)
+    return false;
+  if (lattice_switch != ActiveLB::NONE)
+    return false;
+#ifdef ELECTROSTATICS
+  if (coulomb.method != COULOMB_NONE && coulomb.method != COULOMB_DH &&
+      coulomb.method != COULOMB_RF)
+    return false;
+#endif
+#ifdef DIPOLES
+  if (dipole.method != DIPOLAR_NONE)
+    return false;
+#endif
+  return true;
+}
+
+double local_load() {
+  switch (cell_structure.load_balancing_metric) {
+  case Metric::FORCE_TIME:
+    return force_time;
+  case Metric::PARTICLES:
+  default:
+    return cells_get_n_particles();
+  }
+}
+
+/** Cuts of the current decomposition in direction @p dir. */
+std::vector<double> current_cuts(int dir) {
+  auto cuts = domain_cuts()[dir];
+  if (cuts.empty()) {
+    for (int i = 0; i <= node_grid[dir]; i++) {
+      cuts.push_back(static_cast<double>(i) / node_grid[dir]);
+    }
+  }
+
+  return cuts;
+}
+
+/** Measure the load of all nodes and move the domain boundaries. */
+void adjust_domains() {
+  std::vector<double> loads;
+  boost::mpi::all_gather(comm_cart, local_load(), loads);
+
+  auto cuts = domain_cuts();
+  bool changed = false;
+  for (int dir = 0; dir < 3; dir++) {
+    if (node_grid[dir] == 1)
+      continue;
+
+    std::vector<double> slab_loads(node_grid[dir], 0.);
+    for (int rank = 0; rank < loads.size(); rank++) {
+      auto const node_pos = Utils::Mpi::cart_coords<3>(comm_cart, rank);
+      slab_loads[node_pos[dir]] += loads[rank];
+    }
+
+    auto const regular_width = 1. / node_grid[dir];
+    auto const min_width =
+        std::max(cell_structure.min_range / box_geo.length()[dir],
+                 min_relative_width * regular_width);
+    auto const old_cuts = current_cuts(dir);
+    auto const new_cuts =
+        balanced_cuts(old_cuts, slab_loads, min_width, relaxation);
+
+    for (int i = 0; i < new_cuts.size(); i++) {
+      if (std::abs(new_cuts[i] - old_cuts[i]) >
+          min_relative_change * regular_width) {
+        cuts[dir] = new_cuts;
+        changed = true;
+        break;
+      }
+    }
+  }
+
+  if (changed) {
+    set_domain_cuts(cuts);
+    cells_re_init(CELL_STRUCTURE_CURRENT, cell_structure.min_range);
+  }
+}
+} // namespace
+
+std::vector<double> balanced_cuts(std::vector<double> const &cuts,
+                                  std::vector<double> const &loads,
+                                  double min_width, double relaxation) {
+  auto const n = static_cast<int>(loads.size());
+  assert(cuts.size() == n + 1);
+
+  auto const total_load = std::accumulate(loads.begin(), loads.end(), 0.);
+  if (total_load <= 0. or n * min_width > 1.)
+    return cuts;
+
+  auto ret = cuts;
+
+  /* Invert the cumulative load, which is linear within the slabs */
+  int slab = 0;
+  double load_below = 0.;
+  for (int i = 1; i < n; i++) {
+    auto const target = i * total_load / n;
+    while (slab < n - 1 and load_below + loads[slab] < target) {
+      load_below += loads[slab];
+      slab++;
+    }
+
+    auto const fraction =
+        (loads[slab] > 0.)
+            ? boost::algorithm::clamp((target - load_below) / loads[slab], 0.,
+                                      1.)
+            : 0.;
+    auto const balanced =
+        cuts[slab] + fraction * (cuts[slab + 1] - cuts[slab]);
+    ret[i] = cuts[i] + relaxation * (balanced - cuts[i]);
+  }
+
+  /* Enforce the minimal width, this is always possible
+   * because n * min_width <= 1. */
+  for (int i = 1; i < n; i++) {
+    ret[i] = std::max(ret[i], ret[i - 1] + min_width);
+  }
+  for (int i = n - 1; i > 0; i--) {
+    ret[i] = std::min(ret[i], ret[i + 1] - min_width);
+  }
+
+  return ret;
+}
+
+void add_force_time(double time) { force_time += time; }
+
+void integration_step() {
+  auto const interval = cell_structure.load_balancing_interval;
+  if (interval <= 0 or ++steps < interval)
+    return;
+
+  if (domains_adjustable())
+    adjust_domains();
+
+  steps = 0;
+  force_time = 0.;
+}
+
+void check_domains() {
+  auto const &cuts = domain_cuts();
+  auto const regular =
+      std::all_of(cuts.begin(), cuts.end(),
+                  [](std::vector<double> const &c) { return c.empty(); });
+  if (regular or domains_adjustable())
+    return;
+
+  set_domain_cuts({});
+  cells_re_init(CELL_STRUCTURE_CURRENT, cell_structure.min_range);
+}
+} // namespace LoadBalancing
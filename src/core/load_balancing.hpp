@@ -0,0 +1,91 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CORE_LOAD_BALANCING_HPP
+#define CORE_LOAD_BALANCING_HPP
+/** \file
+ *  Dynamic load balancing for the domain decomposition.
+ *
+ *  The node domains form a rectilinear grid: in each direction, the box
+ *  is cut into one slab per layer of the node grid, see \ref domain_cuts.
+ *  Every \ref CellStructure::load_balancing_interval integration steps,
+ *  the load of the nodes is summed up over the slabs, and the cuts are
+ *  moved such that every slab gets the same share of the load, assuming
+ *  that the load is spread evenly within a slab. All nodes of a slab
+ *  keep the same extent in the direction of the cut, so the faces of
+ *  neighboring domains still match and the ghost communication of the
+ *  domain decomposition works unchanged. After the cell system has been
+ *  re-initialized for the new domains, the particles are moved to their
+ *  new nodes by the global resort.
+ *
+ *  The grid based methods (P3M, LB, ...) assume equally sized domains,
+ *  the domains are not moved while any of them is active, and the
+ *  regular decomposition is restored when one of them is activated.
+ *
+ *  Implementation in load_balancing.cpp.
+ */
+
+#include <vector>
+
+namespace LoadBalancing {
+/** Measures of the load of a node. */
+enum class Metric {
+  /** Number of local particles. */
+  PARTICLES,
+  /** Time spent in the short-range force calculation. */
+  FORCE_TIME
+};
+
+/**
+ * @brief Move the cuts between slabs towards an even load.
+ *
+ * The load is assumed to be spread evenly within each slab, the balanced
+ * cuts are where the cumulative load reaches multiples of the average
+ * slab load.
+ *
+ * @param cuts       Boundaries of the slabs in units of the box length,
+ *                   starting with 0 and ending with 1.
+ * @param loads      Load of the slabs.
+ * @param min_width  Minimal width of a slab in units of the box length.
+ * @param relaxation Fraction of the distance to the balanced cuts by which
+ *                   the cuts are moved.
+ * @return The new cuts. If there is no load or the slabs cannot be
+ *         @p min_width wide, these are the old ones.
+ */
+std::vector<double> balanced_cuts(std::vector<double> const &cuts,
+                                  std::vector<double> const &loads,
+                                  double min_width, double relaxation);
+
+/** Add the time of a short-range force calculation on this node to the
+ *  load.
+ */
+void add_force_time(double time);
+
+/** Adjust the domains to the load if the balancing interval has passed.
+ *  Has to be called on all nodes after every integration step.
+ */
+void integration_step();
+
+/** Restore the regular decomposition if the domains may not be moved
+ *  for the active methods. Has to be called on all nodes when the
+ *  electrostatics, magnetostatics or LB method changes.
+ */
+void check_domains();
+} // namespace LoadBalancing
+
+#endif
@@ -188,11 +188,26 @@ static double recalc_maximal_cutoff(const IA_parameters &data) {
   return max_cut_current;
 }
 
+/** Whether no interaction but Lennard-Jones and WCA contributes
+ *  to the cutoff of a type pair.
+ */
+static bool is_lj_wca_only(const IA_parameters &data) {
+  auto rest = data;
+#ifdef LENNARD_JONES
+  rest.lj = LJ_Parameters{};
+#endif
+#ifdef WCA
+  rest.wca = WCA_Parameters{};
+#endif
+  return recalc_maximal_cutoff(rest) == INACTIVE_CUTOFF;
+}
+
 double recalc_maximal_cutoff_nonbonded() {
   auto max_cut_nonbonded = INACTIVE_CUTOFF;
 
   for (auto &data : ia_params) {
     data.max_cut = recalc_maximal_cutoff(data);
+    data.lj_wca_only = is_lj_wca_only(data);
     max_cut_nonbonded = std::max(max_cut_nonbonded, data.max_cut);
   }
 
@@ -212,6 +212,11 @@ struct IA_parameters {
    */
   double max_cut = INACTIVE_CUTOFF;
 
+  /** whether Lennard-Jones and WCA are the only short-ranged
+   *  interactions set for this pair of particle types.
+   */
+  bool lj_wca_only = true;
+
 #ifdef LENNARD_JONES
   LJ_Parameters lj;
 #endif
@@ -0,0 +1,166 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** \file
+ *  Cell loop of the vectorized non-bonded pair forces.
+ *
+ *  The corresponding header file is nonbonded_soa.hpp.
+ */
+
+#include "nonbonded_soa.hpp"
+
+#include "cells.hpp"
+#include "collision.hpp"
+#include "electrostatics_magnetostatics/coulomb.hpp"
+#include "electrostatics_magnetostatics/dipole.hpp"
+#include "electrostatics_magnetostatics/p3m.hpp"
+#include "integrate.hpp"
+#include "thermostat.hpp"
+
+#include <profiler/profiler.hpp>
+
+#include <algorithm>
+
+namespace SoA {
+namespace {
+PairParameterTable pair_parameters() {
+  PairParameterTable params(max_seen_particle_type);
+
+  for (int i = 0; i < max_seen_particle_type; i++)
+    for (int j = 0; j < max_seen_particle_type; j++) {
+      params(i, j) = PairParameters(*get_ia_param(i, j));
+    }
+
+  return params;
+}
+
+CoulombParameters coulomb_parameters() {
+  CoulombParameters ret;
+#ifdef P3M
+  if (coulomb.method == COULOMB_P3M or coulomb.method == COULOMB_P3M_GPU) {
+    ret.prefactor = coulomb.prefactor;
+    ret.alpha = p3m.params.alpha;
+    ret.r_cut = p3m.params.r_cut;
+  }
+#endif
+  return ret;
+}
+
+/** Pairs within the cell and with its red neighbors,
+ *  as in @ref Algorithm::link_cell.
+ */
+void add_cell_pair_forces(Cell &cell, PairParameterTable const &params,
+                          CoulombParameters const &coulomb_params) {
+  add_pair_forces(cell.m_soa, params, coulomb_params);
+
+  for (auto &neighbor : cell.neighbors().red()) {
+    add_pair_forces(cell.m_soa, neighbor->m_soa, params, coulomb_params);
+  }
+}
+
+void update(CellPList &cells) {
+#pragma omp parallel for if (cell_structure.use_threads)
+  for (int i = 0; i < cells.n; i++) {
+    cells.cell[i]->m_soa.update(*cells.cell[i]);
+  }
+}
+
+void add_forces(CellPList &cells) {
+#pragma omp parallel for if (cell_structure.use_threads)
+  for (int i = 0; i < cells.n; i++) {
+    cells.cell[i]->m_soa.add_forces(*cells.cell[i]);
+  }
+}
+} // namespace
+
+bool pair_forces_applicable(CellStructure const &cs) {
+  if (not cs.use_soa or (cs.type != CELL_STRUCTURE_DOMDEC) or
+      (cs.min_range == INACTIVE_CUTOFF))
+    return false;
+
+  if (not std::all_of(ia_params.begin(), ia_params.end(),
+                      [](IA_parameters const &ia) { return ia.lj_wca_only; }))
+    return false;
+
+#ifdef ELECTROSTATICS
+  if (coulomb.method != COULOMB_NONE and coulomb.method != COULOMB_P3M and
+      coulomb.method != COULOMB_P3M_GPU)
+    return false;
+#endif
+#ifdef DIPOLES
+  if (dipole.method != DIPOLAR_NONE)
+    return false;
+#endif
+#ifdef DPD
+  if (thermo_switch & THERMO_DPD)
+    return false;
+#endif
+#ifdef NPT
+  if (integ_switch == INTEG_METHOD_NPT_ISO)
+    return false;
+#endif
+#ifdef COLLISION_DETECTION
+  if (collision_params.mode != COLLISION_MODE_OFF)
+    return false;
+#endif
+#ifdef NO_INTRA_NB
+  return false;
+#endif
+#ifdef EXCLUSIONS
+  /* The exclusion lists are symmetric, and every pair contains
+   * a local particle, so it is enough to check those. */
+  auto const particles = local_cells.particles();
+  if (not std::all_of(particles.begin(), particles.end(),
+                      [](Particle const &p) { return p.el.empty(); }))
+    return false;
+#endif
+
+  return true;
+}
+
+void add_pair_forces(CellStructure &cs) {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+
+  auto const params = pair_parameters();
+  auto const coulomb_params = coulomb_parameters();
+
+  update(local_cells);
+  update(ghost_cells);
+
+  if (cs.use_threads) {
+    auto const &groups = cells_thread_groups();
+
+#pragma omp parallel
+    for (auto const &group : groups) {
+      auto const n_cells = static_cast<int>(group.size());
+
+#pragma omp for schedule(dynamic)
+      for (int i = 0; i < n_cells; i++) {
+        add_cell_pair_forces(*group[i], params, coulomb_params);
+      }
+    }
+  } else {
+    for (auto &cell : local_cells) {
+      add_cell_pair_forces(*cell, params, coulomb_params);
+    }
+  }
+
+  add_forces(local_cells);
+  add_forces(ghost_cells);
+}
+} // namespace SoA
@@ -0,0 +1,236 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CORE_NONBONDED_SOA_HPP
+#define CORE_NONBONDED_SOA_HPP
+/** \file
+ *  Vectorized non-bonded pair forces on the structure-of-arrays
+ *  copies of the cells (@ref ParticleSoA).
+ *
+ *  The kernels cover Lennard-Jones, WCA and the real-space part of
+ *  P3M electrostatics. The loops over the partner particles are
+ *  written branch-free, so that the compiler can vectorize them for
+ *  the instruction set it targets (e.g. AVX2 or AVX-512 with
+ *  -march=native); otherwise they run as plain scalar loops.
+ *
+ *  Implementation in \ref nonbonded_soa.cpp.
+ */
+
+#include "ParticleSoA.hpp"
+#include "nonbonded_interaction_data.hpp"
+
+#include <utils/constants.hpp>
+#include <utils/math/AS_erfc_part.hpp>
+#include <utils/math/int_pow.hpp>
+
+#include <cmath>
+#include <vector>
+
+struct CellStructure;
+
+namespace SoA {
+/** Interaction parameters of a pair of particle types. The cutoffs
+ *  are in terms of the particle distance.
+ */
+struct PairParameters {
+  double lj_eps = 0.;
+  double lj_sig = 0.;
+  double lj_offset = 0.;
+  double lj_min = 0.;
+  double lj_cut = 0.;
+  double wca_eps = 0.;
+  double wca_sig = 0.;
+  double wca_cut = INACTIVE_CUTOFF;
+
+  PairParameters() = default;
+  explicit PairParameters(IA_parameters const &ia) {
+#ifdef LENNARD_JONES
+    lj_eps = ia.lj.eps;
+    lj_sig = ia.lj.sig;
+    lj_offset = ia.lj.offset;
+    lj_min = ia.lj.min + ia.lj.offset;
+    lj_cut = ia.lj.cut + ia.lj.offset;
+#endif
+#ifdef WCA
+    wca_eps = ia.wca.eps;
+    wca_sig = ia.wca.sig;
+    wca_cut = ia.wca.cut;
+#endif
+  }
+};
+
+/** Parameters of all pairs of particle types. */
+class PairParameterTable {
+public:
+  PairParameterTable() = default;
+  explicit PairParameterTable(int n_types)
+      : m_n_types(n_types), m_data(n_types * n_types) {}
+
+  PairParameters &operator()(int i, int j) {
+    return m_data[i * m_n_types + j];
+  }
+
+  /** Parameters of type @p i with all types, indexed by type. */
+  PairParameters const *row(int i) const {
+    return m_data.data() + i * m_n_types;
+  }
+
+private:
+  int m_n_types = 0;
+  std::vector<PairParameters> m_data;
+};
+
+/** Parameters of the real-space Coulomb kernel. */
+struct CoulombParameters {
+  /** Coulomb prefactor */
+  double prefactor = 0.;
+  /** Ewald splitting parameter */
+  double alpha = 0.;
+  /** Real-space cutoff, inactive by default. */
+  double r_cut = INACTIVE_CUTOFF;
+};
+
+/**
+ * @brief Add the forces between particle @p i of @p a and the
+ *        particles [@p first, @p last) of @p b.
+ *
+ * The forces on the particles of @p b are accumulated in place,
+ * the force on particle @p i once after the loop, so @p a and @p b
+ * may be the same as long as @p i is not in the range.
+ *
+ * @param row Parameters of the type of particle @p i, see
+ *            @ref PairParameterTable::row.
+ */
+inline void add_pair_forces(ParticleSoA &a, int i, ParticleSoA &b, int first,
+                            int last, PairParameters const *row,
+                            CoulombParameters const &coulomb_params) {
+  auto const xi = a.x[i];
+  auto const yi = a.y[i];
+  auto const zi = a.z[i];
+#ifdef ELECTROSTATICS
+  auto const qi = coulomb_params.prefactor * a.q[i];
+  auto const *const q = b.q.data();
+  auto const alpha = coulomb_params.alpha;
+  auto const r_cut = coulomb_params.r_cut;
+#endif
+
+  auto const *const x = b.x.data();
+  auto const *const y = b.y.data();
+  auto const *const z = b.z.data();
+  auto const *const type = b.type.data();
+  auto *const fx = b.fx.data();
+  auto *const fy = b.fy.data();
+  auto *const fz = b.fz.data();
+
+  double fxi = 0., fyi = 0., fzi = 0.;
+
+#pragma omp simd reduction(+ : fxi, fyi, fzi)
+  for (int j = first; j < last; j++) {
+    auto const dx = xi - x[j];
+    auto const dy = yi - y[j];
+    auto const dz = zi - z[j];
+    auto const dist2 = dx * dx + dy * dy + dz * dz;
+    auto const dist = std::sqrt(dist2);
+    auto const &ia = row[type[j]];
+
+    /* Lennard-Jones, see lj_pair_force_factor() */
+    auto const r_off = dist - ia.lj_offset;
+    auto const lj_frac6 = Utils::int_pow<6>(ia.lj_sig / r_off);
+    auto const lj_fac =
+        48.0 * ia.lj_eps * lj_frac6 * (lj_frac6 - 0.5) / (r_off * dist);
+
+    /* WCA, see wca_pair_force_factor() */
+    auto const wca_frac6 = Utils::int_pow<6>(ia.wca_sig / dist);
+    auto const wca_fac =
+        48.0 * ia.wca_eps * wca_frac6 * (wca_frac6 - 0.5) / dist2;
+
+    auto fac = ((dist < ia.lj_cut) && (dist > ia.lj_min)) ? lj_fac : 0.;
+    fac += (dist < ia.wca_cut) ? wca_fac : 0.;
+
+#ifdef ELECTROSTATICS
+    /* P3M real space, see p3m_add_pair_force() */
+    auto const adist = alpha * dist;
+    auto const erfc_part_ri = Utils::AS_erfc_part(adist) / dist;
+    auto const coulomb_fac =
+        qi * q[j] * std::exp(-adist * adist) *
+        (erfc_part_ri + 2.0 * alpha * Utils::sqrt_pi_i()) / dist2;
+    fac += ((dist < r_cut) && (dist > 0.)) ? coulomb_fac : 0.;
+#endif
+
+    fxi += fac * dx;
+    fyi += fac * dy;
+    fzi += fac * dz;
+    fx[j] -= fac * dx;
+    fy[j] -= fac * dy;
+    fz[j] -= fac * dz;
+  }
+
+  a.fx[i] += fxi;
+  a.fy[i] += fyi;
+  a.fz[i] += fzi;
+}
+
+/**
+ * @brief Add the forces between all pairs of particles of @p a.
+ */
+inline void add_pair_forces(ParticleSoA &a, PairParameterTable const &params,
+                            CoulombParameters const &coulomb_params) {
+  for (int i = 0; i < a.size(); i++) {
+    add_pair_forces(a, i, a, i + 1, a.size(), params.row(a.type[i]),
+                    coulomb_params);
+  }
+}
+
+/**
+ * @brief Add the forces between all particles of @p a and all
+ *        particles of @p b.
+ */
+inline void add_pair_forces(ParticleSoA &a, ParticleSoA &b,
+                            PairParameterTable const &params,
+                            CoulombParameters const &coulomb_params) {
+  for (int i = 0; i < a.size(); i++) {
+    add_pair_forces(a, i, b, 0, b.size(), params.row(a.type[i]),
+                    coulomb_params);
+  }
+}
+
+/**
+ * @brief Whether the non-bonded pair forces can be calculated by
+ *        @ref add_pair_forces(CellStructure &).
+ *
+ * This is the case if @ref CellStructure::use_soa is set, the domain
+ * decomposition is used, Lennard-Jones and WCA are the only short-ranged
+ * interactions, electrostatics is off or P3M, and none of the features
+ * that need the full particles in the pair loop (exclusions, dipoles,
+ * DPD, NpT, collision detection) is in use.
+ */
+bool pair_forces_applicable(CellStructure const &cs);
+
+/**
+ * @brief Add the non-bonded pair forces of all particle pairs of the
+ *        local cells, also to the ghosts.
+ *
+ * The cells are copied into their @ref Cell::m_soa, the forces are
+ * calculated on the copies and added to the particles afterwards.
+ * With @ref CellStructure::use_threads the cells are distributed
+ * over the threads like in @ref short_range_loop_parallel.
+ */
+void add_pair_forces(CellStructure &cs);
+} // namespace SoA
+
+#endif
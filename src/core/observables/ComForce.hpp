@@ -19,24 +19,26 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef OBSERVABLES_ComForce_HPP
 #define OBSERVABLES_ComForce_HPP
 
+#include "ParticleReduction.hpp"
 #include "PidObservable.hpp"
 
 #include "integrate.hpp"
 
 namespace Observables {
 
-class ComForce : public PidObservable {
+class ComForce : public ParticleReduction<ComForce, PidObservable> {
 public:
-  using PidObservable::PidObservable;
+  using ParticleReduction::ParticleReduction;
   int n_values() const override { return 3; }
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
     std::vector<double> res(n_values());
-    for (int i : ids()) {
-      if (partCfg[i].p.is_virtual)
+    for (auto const p : particles) {
+      if (p->p.is_virtual)
         continue;
-      res[0] += partCfg[i].f.f[0] * partCfg[i].p.mass;
-      res[1] += partCfg[i].f.f[1] * partCfg[i].p.mass;
-      res[2] += partCfg[i].f.f[2] * partCfg[i].p.mass;
+      res[0] += p->f.f[0] * p->p.mass;
+      res[1] += p->f.f[1] * p->p.mass;
+      res[2] += p->f.f[2] * p->p.mass;
     }
     return res;
   };
@@ -19,33 +19,40 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef OBSERVABLES_COMPOSITION_HPP
 #define OBSERVABLES_COMPOSITION_HPP
 
+#include "ParticleReduction.hpp"
 #include "PidObservable.hpp"
 
 #include <vector>
 
 namespace Observables {
 
-class ComPosition : public PidObservable {
+class ComPosition : public ParticleReduction<ComPosition, PidObservable> {
 public:
-  using PidObservable::PidObservable;
+  using ParticleReduction::ParticleReduction;
   int n_values() const override { return 3; }
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
-    std::vector<double> res(n_values());
-    double total_mass = 0;
-    for (int i : ids()) {
-      if (partCfg[i].p.is_virtual)
+  /** Mass-weighted sum of the unfolded positions, and the total mass. */
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
+    std::vector<double> res(n_values() + 1);
+    for (auto const p : particles) {
+      if (p->p.is_virtual)
         continue;
-      double mass = partCfg[i].p.mass;
-      res[0] += mass * partCfg[i].r.p[0];
-      res[1] += mass * partCfg[i].r.p[1];
-      res[2] += mass * partCfg[i].r.p[2];
-      total_mass += mass;
+      double mass = p->p.mass;
+      auto const pos = unfolded_position(p->r.p, p->l.i, box_geo.length());
+      res[0] += mass * pos[0];
+      res[1] += mass * pos[1];
+      res[2] += mass * pos[2];
+      res[3] += mass;
     }
-    res[0] /= total_mass;
-    res[1] /= total_mass;
-    res[2] /= total_mass;
     return res;
-  };
+  }
+  std::vector<double> finalize(std::vector<double> sum) const {
+    auto const total_mass = sum[3];
+    sum.resize(n_values());
+    for (auto &x : sum)
+      x /= total_mass;
+    return sum;
+  }
 };
 
 } // Namespace Observables
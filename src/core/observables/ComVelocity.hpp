@@ -19,33 +19,39 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef OBSERVABLES_COMVELOCITY_HPP
 #define OBSERVABLES_COMVELOCITY_HPP
 
+#include "ParticleReduction.hpp"
 #include "PidObservable.hpp"
 
 #include <vector>
 
 namespace Observables {
 
-class ComVelocity : public PidObservable {
+class ComVelocity : public ParticleReduction<ComVelocity, PidObservable> {
 public:
-  using PidObservable::PidObservable;
+  using ParticleReduction::ParticleReduction;
   int n_values() const override { return 3; }
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
-    std::vector<double> res(n_values());
-    double total_mass = 0;
-    for (int i : ids()) {
-      if (partCfg[i].p.is_virtual)
+  /** Mass-weighted sum of the velocities, and the total mass. */
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
+    std::vector<double> res(n_values() + 1);
+    for (auto const p : particles) {
+      if (p->p.is_virtual)
         continue;
-      double mass = partCfg[i].p.mass;
-      res[0] += mass * partCfg[i].m.v[0];
-      res[1] += mass * partCfg[i].m.v[1];
-      res[2] += mass * partCfg[i].m.v[2];
-      total_mass += mass;
+      double mass = p->p.mass;
+      res[0] += mass * p->m.v[0];
+      res[1] += mass * p->m.v[1];
+      res[2] += mass * p->m.v[2];
+      res[3] += mass;
     }
-    res[0] /= total_mass;
-    res[1] /= total_mass;
-    res[2] /= total_mass;
     return res;
-  };
+  }
+  std::vector<double> finalize(std::vector<double> sum) const {
+    auto const total_mass = sum[3];
+    sum.resize(n_values());
+    for (auto &x : sum)
+      x /= total_mass;
+    return sum;
+  }
 };
 
 } // Namespace Observables
@@ -19,24 +19,26 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef OBSERVABLES_CURRENTS_HPP
 #define OBSERVABLES_CURRENTS_HPP
 
+#include "ParticleReduction.hpp"
 #include "PidObservable.hpp"
 
 #include <vector>
 
 namespace Observables {
 
-class Current : public PidObservable {
+class Current : public ParticleReduction<Current, PidObservable> {
 public:
-  using PidObservable::PidObservable;
+  using ParticleReduction::ParticleReduction;
   int n_values() const override { return 3; };
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
     std::vector<double> res(n_values());
-    for (int i : ids()) {
+    for (auto const p : particles) {
 #ifdef ELECTROSTATICS
-      double charge = partCfg[i].p.q;
-      res[0] += charge * partCfg[i].m.v[0];
-      res[1] += charge * partCfg[i].m.v[1];
-      res[2] += charge * partCfg[i].m.v[2];
+      double charge = p->p.q;
+      res[0] += charge * p->m.v[0];
+      res[1] += charge * p->m.v[1];
+      res[2] += charge * p->m.v[2];
 #endif
     };
     return res;
@@ -20,14 +20,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define OBSERVABLES_CYLINDRICALDENSITYPROFILE_HPP
 
 #include "CylindricalPidProfileObservable.hpp"
+#include "ParticleReduction.hpp"
 #include <utils/Histogram.hpp>
 #include <utils/math/coordinate_transformation.hpp>
 
 namespace Observables {
-class CylindricalDensityProfile : public CylindricalPidProfileObservable {
+class CylindricalDensityProfile
+    : public ParticleReduction<CylindricalDensityProfile,
+                               CylindricalPidProfileObservable> {
 public:
-  using CylindricalPidProfileObservable::CylindricalPidProfileObservable;
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
+  using ParticleReduction::ParticleReduction;
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
 
     std::array<size_t, 3> n_bins{{static_cast<size_t>(n_r_bins),
                                   static_cast<size_t>(n_phi_bins),
@@ -37,10 +41,10 @@ public:
          std::make_pair(min_z, max_z)}};
     Utils::CylindricalHistogram<double, 3> histogram(n_bins, 1, limits);
     std::vector<::Utils::Vector3d> folded_positions;
-    std::transform(ids().begin(), ids().end(),
-                   std::back_inserter(folded_positions), [&partCfg](int id) {
-                     return ::Utils::Vector3d(
-                         folded_position(partCfg[id].r.p, box_geo));
+    std::transform(particles.begin(), particles.end(),
+                   std::back_inserter(folded_positions),
+                   [](Particle const *p) {
+                     return ::Utils::Vector3d(folded_position(p->r.p, box_geo));
                    });
     for (auto &p : folded_positions) {
       p -= center;
@@ -20,14 +20,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define OBSERVABLES_CYLINDRICALFLUXDENSITYPROFILE_HPP
 
 #include "CylindricalPidProfileObservable.hpp"
+#include "ParticleReduction.hpp"
 #include "integrate.hpp"
 #include <utils/Histogram.hpp>
 
 namespace Observables {
-class CylindricalFluxDensityProfile : public CylindricalPidProfileObservable {
+class CylindricalFluxDensityProfile
+    : public ParticleReduction<CylindricalFluxDensityProfile,
+                               CylindricalPidProfileObservable> {
 public:
-  using CylindricalPidProfileObservable::CylindricalPidProfileObservable;
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
+  using ParticleReduction::ParticleReduction;
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
     std::array<size_t, 3> n_bins{{static_cast<size_t>(n_r_bins),
                                   static_cast<size_t>(n_phi_bins),
                                   static_cast<size_t>(n_z_bins)}};
@@ -36,22 +40,19 @@ public:
          std::make_pair(min_z, max_z)}};
     Utils::CylindricalHistogram<double, 3> histogram(n_bins, 3, limits);
     std::vector<::Utils::Vector3d> folded_positions;
-    std::transform(ids().begin(), ids().end(),
-                   std::back_inserter(folded_positions), [&partCfg](int id) {
-                     return ::Utils::Vector3d(
-                         folded_position(partCfg[id].r.p, box_geo));
+    std::transform(particles.begin(), particles.end(),
+                   std::back_inserter(folded_positions),
+                   [](Particle const *p) {
+                     return ::Utils::Vector3d(folded_position(p->r.p, box_geo));
                    });
     std::vector<::Utils::Vector3d> velocities;
-    std::transform(ids().begin(), ids().end(), std::back_inserter(velocities),
-                   [&partCfg](int id) {
-                     return ::Utils::Vector3d{{partCfg[id].m.v[0],
-                                               partCfg[id].m.v[1],
-                                               partCfg[id].m.v[2]}};
-                   });
+    std::transform(particles.begin(), particles.end(),
+                   std::back_inserter(velocities),
+                   [](Particle const *p) { return p->m.v; });
     for (auto &p : folded_positions)
       p -= center;
     // Write data to the histogram
-    for (size_t ind = 0; ind < ids().size(); ++ind) {
+    for (size_t ind = 0; ind < particles.size(); ++ind) {
       histogram.update(Utils::transform_coordinate_cartesian_to_cylinder(
                            folded_positions[ind], axis),
                        Utils::transform_vector_cartesian_to_cylinder(
@@ -29,6 +29,7 @@ namespace Observables {
 class CylindricalPidProfileObservable : public PidObservable,
                                         public CylindricalProfile {
 public:
+  CylindricalPidProfileObservable() = default;
   CylindricalPidProfileObservable(std::vector<int> const &ids,
                                   Utils::Vector3d const &center,
                                   Utils::Vector3d const &axis, int n_r_bins,
@@ -38,6 +39,11 @@ public:
       : PidObservable(ids),
         CylindricalProfile(center, axis, min_r, max_r, min_phi, max_phi, min_z,
                            max_z, n_r_bins, n_phi_bins, n_z_bins) {}
+
+  template <class Archive> void serialize(Archive &ar, long int version) {
+    PidObservable::serialize(ar, version);
+    CylindricalProfile::serialize(ar, version);
+  }
 };
 
 } // Namespace Observables
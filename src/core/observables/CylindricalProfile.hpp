@@ -26,6 +26,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 namespace Observables {
 class CylindricalProfile {
 public:
+  CylindricalProfile() = default;
   CylindricalProfile(Utils::Vector3d const &center, Utils::Vector3d const &axis,
                      double min_r, double max_r, double min_phi, double max_phi,
                      double min_z, double max_z, int n_r_bins, int n_phi_bins,
@@ -40,6 +41,12 @@ public:
   double min_z, max_z;
   // Number of bins for each coordinate.
   int n_r_bins, n_phi_bins, n_z_bins;
+
+  template <class Archive> void serialize(Archive &ar, long int) {
+    ar &center &axis;
+    ar &min_r &max_r &min_phi &max_phi &min_z &max_z;
+    ar &n_r_bins &n_phi_bins &n_z_bins;
+  }
 };
 
 } // Namespace Observables
@@ -20,13 +20,17 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define OBSERVABLES_CYLINDRICALVELOCITYPROFILE_HPP
 
 #include "CylindricalPidProfileObservable.hpp"
+#include "ParticleReduction.hpp"
 #include <utils/Histogram.hpp>
 
 namespace Observables {
-class CylindricalVelocityProfile : public CylindricalPidProfileObservable {
+class CylindricalVelocityProfile
+    : public ParticleReduction<CylindricalVelocityProfile,
+                               CylindricalPidProfileObservable> {
 public:
-  using CylindricalPidProfileObservable::CylindricalPidProfileObservable;
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
+  using ParticleReduction::ParticleReduction;
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
     std::array<size_t, 3> n_bins{{static_cast<size_t>(n_r_bins),
                                   static_cast<size_t>(n_phi_bins),
                                   static_cast<size_t>(n_z_bins)}};
@@ -35,18 +39,15 @@ public:
          std::make_pair(min_z, max_z)}};
     Utils::CylindricalHistogram<double, 3> histogram(n_bins, 3, limits);
     std::vector<::Utils::Vector3d> folded_positions;
-    std::transform(ids().begin(), ids().end(),
-                   std::back_inserter(folded_positions), [&partCfg](int id) {
-                     return ::Utils::Vector3d(
-                         folded_position(partCfg[id].r.p, box_geo));
+    std::transform(particles.begin(), particles.end(),
+                   std::back_inserter(folded_positions),
+                   [](Particle const *p) {
+                     return ::Utils::Vector3d(folded_position(p->r.p, box_geo));
                    });
     std::vector<::Utils::Vector3d> velocities;
-    std::transform(ids().begin(), ids().end(), std::back_inserter(velocities),
-                   [&partCfg](int id) {
-                     return ::Utils::Vector3d{{partCfg[id].m.v[0],
-                                               partCfg[id].m.v[1],
-                                               partCfg[id].m.v[2]}};
-                   });
+    std::transform(particles.begin(), particles.end(),
+                   std::back_inserter(velocities),
+                   [](Particle const *p) { return p->m.v; });
     for (auto &p : folded_positions)
       p -= center;
     // Write data to the histogram
@@ -56,14 +57,21 @@ public:
                        Utils::transform_vector_cartesian_to_cylinder(
                            velocities[ind], axis, folded_positions[ind]));
     }
-    auto hist_tmp = histogram.get_histogram();
-    auto tot_count = histogram.get_tot_count();
-    for (size_t ind = 0; ind < hist_tmp.size(); ++ind) {
-      if (tot_count[ind] > 0) {
-        hist_tmp[ind] /= tot_count[ind];
+    /* The counts are needed to average the summed up velocities. */
+    auto res = histogram.get_histogram();
+    auto const tot_count = histogram.get_tot_count();
+    res.insert(res.end(), tot_count.begin(), tot_count.end());
+    return res;
+  }
+  std::vector<double> finalize(std::vector<double> sum) const {
+    auto const n_bins = sum.size() / 2;
+    for (size_t ind = 0; ind < n_bins; ++ind) {
+      if (sum[n_bins + ind] > 0) {
+        sum[ind] /= sum[n_bins + ind];
       }
     }
-    return hist_tmp;
+    sum.resize(n_bins);
+    return sum;
   }
   int n_values() const override { return 3 * n_r_bins * n_phi_bins * n_z_bins; }
 };
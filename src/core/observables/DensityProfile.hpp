@@ -19,16 +19,19 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef OBSERVABLES_DENSITYPROFILE_HPP
 #define OBSERVABLES_DENSITYPROFILE_HPP
 
+#include "ParticleReduction.hpp"
 #include "PidProfileObservable.hpp"
 #include <utils/Histogram.hpp>
 #include <vector>
 
 namespace Observables {
 
-class DensityProfile : public PidProfileObservable {
+class DensityProfile
+    : public ParticleReduction<DensityProfile, PidProfileObservable> {
 public:
-  using PidProfileObservable::PidProfileObservable;
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
+  using ParticleReduction::ParticleReduction;
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
     std::array<size_t, 3> n_bins{{static_cast<size_t>(n_x_bins),
                                   static_cast<size_t>(n_y_bins),
                                   static_cast<size_t>(n_z_bins)}};
@@ -36,8 +39,8 @@ public:
         {std::make_pair(min_x, max_x), std::make_pair(min_y, max_y),
          std::make_pair(min_z, max_z)}};
     Utils::Histogram<double, 3> histogram(n_bins, 1, limits);
-    for (auto const &id : ids()) {
-      histogram.update(folded_position(partCfg[id].r.p, box_geo));
+    for (auto const p : particles) {
+      histogram.update(folded_position(p->r.p, box_geo));
     }
     histogram.normalize();
     return histogram.get_histogram();
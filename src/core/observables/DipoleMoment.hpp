@@ -19,25 +19,28 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef OBSERVABLES_DIPOLEMOMENT_HPP
 #define OBSERVABLES_DIPOLEMOMENT_HPP
 
+#include "ParticleReduction.hpp"
 #include "PidObservable.hpp"
 
 #include <vector>
 
 namespace Observables {
 
-class DipoleMoment : public PidObservable {
+class DipoleMoment : public ParticleReduction<DipoleMoment, PidObservable> {
 public:
-  using PidObservable::PidObservable;
+  using ParticleReduction::ParticleReduction;
   int n_values() const override { return 3; };
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
     std::vector<double> res(n_values(), 0.0);
-    for (int i : ids()) {
+    for (auto const p : particles) {
 #ifdef ELECTROSTATICS
-      double charge = partCfg[i].p.q;
+      double charge = p->p.q;
+      auto const pos = unfolded_position(p->r.p, p->l.i, box_geo.length());
 
-      res[0] += charge * partCfg[i].r.p[0];
-      res[1] += charge * partCfg[i].r.p[1];
-      res[2] += charge * partCfg[i].r.p[2];
+      res[0] += charge * pos[0];
+      res[1] += charge * pos[1];
+      res[2] += charge * pos[2];
 #endif // ELECTROSTATICS
     }
     return res;
@@ -19,16 +19,19 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef OBSERVABLES_FLUXDENSITYPROFILE_HPP
 #define OBSERVABLES_FLUXDENSITYPROFILE_HPP
 
+#include "ParticleReduction.hpp"
 #include "PidProfileObservable.hpp"
 
 #include <vector>
 
 namespace Observables {
-class FluxDensityProfile : public PidProfileObservable {
+class FluxDensityProfile
+    : public ParticleReduction<FluxDensityProfile, PidProfileObservable> {
 public:
-  using PidProfileObservable::PidProfileObservable;
+  using ParticleReduction::ParticleReduction;
   int n_values() const override { return 3 * n_x_bins * n_y_bins * n_z_bins; }
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
     std::array<size_t, 3> n_bins{{static_cast<size_t>(n_x_bins),
                                   static_cast<size_t>(n_y_bins),
                                   static_cast<size_t>(n_z_bins)}};
@@ -36,10 +39,9 @@ public:
         {std::make_pair(min_x, max_x), std::make_pair(min_y, max_y),
          std::make_pair(min_z, max_z)}};
     Utils::Histogram<double, 3> histogram(n_bins, 3, limits);
-    for (auto const &id : ids()) {
-      auto const ppos =
-          ::Utils::Vector3d(folded_position(partCfg[id].r.p, box_geo));
-      histogram.update(ppos, partCfg[id].m.v);
+    for (auto const p : particles) {
+      auto const ppos = ::Utils::Vector3d(folded_position(p->r.p, box_geo));
+      histogram.update(ppos, p->m.v);
     }
     histogram.normalize();
     return histogram.get_histogram();
@@ -19,17 +19,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef OBSERVABLES_FORCEDENSITYPROFILE_HPP
 #define OBSERVABLES_FORCEDENSITYPROFILE_HPP
 
+#include "ParticleReduction.hpp"
 #include "PidProfileObservable.hpp"
 
 #include <vector>
 
 namespace Observables {
 
-class ForceDensityProfile : public PidProfileObservable {
+class ForceDensityProfile
+    : public ParticleReduction<ForceDensityProfile, PidProfileObservable> {
 public:
-  using PidProfileObservable::PidProfileObservable;
+  using ParticleReduction::ParticleReduction;
   int n_values() const override { return 3 * n_x_bins * n_y_bins * n_z_bins; }
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
     std::array<size_t, 3> n_bins{{static_cast<size_t>(n_x_bins),
                                   static_cast<size_t>(n_y_bins),
                                   static_cast<size_t>(n_z_bins)}};
@@ -37,10 +40,9 @@ public:
         {std::make_pair(min_x, max_x), std::make_pair(min_y, max_y),
          std::make_pair(min_z, max_z)}};
     Utils::Histogram<double, 3> histogram(n_bins, 3, limits);
-    for (auto const &id : ids()) {
-      auto const ppos =
-          ::Utils::Vector3d(folded_position(partCfg[id].r.p, box_geo));
-      histogram.update(ppos, partCfg[id].f.f);
+    for (auto const p : particles) {
+      auto const ppos = ::Utils::Vector3d(folded_position(p->r.p, box_geo));
+      histogram.update(ppos, p->f.f);
     }
     histogram.normalize();
     return histogram.get_histogram();
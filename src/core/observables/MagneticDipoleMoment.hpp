@@ -19,23 +19,27 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef OBSERVABLES_MAGNETICDIPOLEMOMENT_HPP
 #define OBSERVABLES_MAGNETICDIPOLEMOMENT_HPP
 
+#include "ParticleReduction.hpp"
 #include "PidObservable.hpp"
 
 #include <vector>
 
 namespace Observables {
 
-class MagneticDipoleMoment : public PidObservable {
+class MagneticDipoleMoment
+    : public ParticleReduction<MagneticDipoleMoment, PidObservable> {
 public:
-  using PidObservable::PidObservable;
+  using ParticleReduction::ParticleReduction;
   int n_values() const override { return 3; };
-  std::vector<double> evaluate(PartCfg &partCfg) const override {
+  std::vector<double>
+  partial(std::vector<Particle const *> const &particles) const {
     std::vector<double> res(n_values(), 0.0);
-    for (int i : ids()) {
+    for (auto const p : particles) {
 #ifdef DIPOLES
-      res[0] += partCfg[i].calc_dip()[0];
-      res[1] += partCfg[i].calc_dip()[1];
-      res[2] += partCfg[i].calc_dip()[2];
+      auto const dip = p->calc_dip();
+      res[0] += dip[0];
+      res[1] += dip[1];
+      res[2] += dip[2];
 #endif
     }
     return res;
@@ -0,0 +1,134 @@
+/*
+  Copyright (C) 2016-2018 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OBSERVABLES_PARTICLEREDUCTION_HPP
+#define OBSERVABLES_PARTICLEREDUCTION_HPP
+
+#include "PidObservable.hpp"
+
+#include "communication.hpp"
+#include "particle_data.hpp"
+
+#include <boost/optional.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace Observables {
+namespace detail {
+/** Particles among @p ids that are owned by this node. */
+inline std::vector<Particle const *>
+local_particles_of(std::vector<int> const &ids) {
+  std::vector<Particle const *> particles;
+  for (auto const id : ids) {
+    if (id >= 0 && id < max_local_particles && local_particles[id] &&
+        !local_particles[id]->l.ghost)
+      particles.push_back(local_particles[id]);
+  }
+  return particles;
+}
+
+/** Particle ids of the observables on the nodes other than the head
+ *  node, by the key of their @ref CachedIds. */
+std::unordered_map<int, std::vector<int>> &cached_ids();
+
+/** Handle of the ids of an observable in @ref cached_ids.
+ *
+ *  The ids are only sent to the other nodes when they have changed since
+ *  the last evaluation, and are removed there with the handle. A copy of
+ *  the handle has its own entry.
+ */
+class CachedIds {
+public:
+  CachedIds();
+  CachedIds(CachedIds const &) : CachedIds() {}
+  CachedIds &operator=(CachedIds const &) {
+    m_version = boost::none;
+    return *this;
+  }
+  ~CachedIds();
+
+  /** Send @p ids to the other nodes, unless the ones of @p version
+   *  are already there. */
+  void update(std::vector<int> const &ids, unsigned version);
+  int key() const { return m_key; }
+
+private:
+  int m_key;
+  boost::optional<unsigned> m_version;
+};
+
+/** Sum the partial results of all nodes on the head node. */
+template <class Obs>
+std::vector<double> reduce_partial(Obs const &obs,
+                                   std::vector<int> const &ids) {
+  auto const local = obs.partial(local_particles_of(ids));
+  std::vector<double> global((this_node == 0) ? local.size() : 0);
+  MPI_Reduce(local.data(), global.data(), static_cast<int>(local.size()),
+             MPI_DOUBLE, MPI_SUM, 0, comm_cart);
+  return global;
+}
+
+template <class Obs> void mpi_reduce_partial_slave(int key, Obs obs) {
+  reduce_partial(obs, cached_ids().at(key));
+}
+} // namespace detail
+
+/** %Particle observable that is a sum over the particles.
+ *
+ *  @p Derived computes a partial result from any subset of its particles
+ *  in <tt>partial(std::vector<Particle const *> const &)</tt>, and can turn
+ *  the sum of the partial results into the value of the observable in
+ *  <tt>finalize(std::vector<double>)</tt>. Every node evaluates the partial
+ *  result of the particles it owns, and these are summed up on the head
+ *  node, so that the particles never have to be gathered. The ids are
+ *  kept on the nodes and only sent again when they change, so that an
+ *  evaluation only communicates the parameters of the observable.
+ *
+ *  Every @p Derived has to be serializable and its callback has to be
+ *  registered in PidObservable.cpp.
+ */
+template <class Derived, class Base> class ParticleReduction : public Base {
+public:
+  using Base::Base;
+
+  std::vector<double> finalize(std::vector<double> sum) const { return sum; }
+
+private:
+  Derived const &derived() const { return static_cast<Derived const &>(*this); }
+
+  std::vector<double> evaluate(PartCfg &partCfg) const override {
+    std::vector<Particle const *> particles;
+    for (auto const id : this->ids()) {
+      particles.push_back(&partCfg[id]);
+    }
+    return derived().finalize(derived().partial(particles));
+  }
+
+  boost::optional<std::vector<double>> evaluate_distributed() const override {
+    m_cached_ids.update(this->ids(), this->ids_version());
+    mpi_call(detail::mpi_reduce_partial_slave<Derived>, m_cached_ids.key(),
+             derived());
+    return derived().finalize(detail::reduce_partial(derived(), this->ids()));
+  }
+
+  mutable detail::CachedIds m_cached_ids;
+};
+
+} // Namespace Observables
+#endif
@@ -1,9 +1,93 @@
 #include "PidObservable.hpp"
 
+#include "ComForce.hpp"
+#include "ComPosition.hpp"
+#include "ComVelocity.hpp"
+#include "Current.hpp"
+#include "CylindricalDensityProfile.hpp"
+#include "CylindricalFluxDensityProfile.hpp"
+#include "CylindricalVelocityProfile.hpp"
+#include "DensityProfile.hpp"
+#include "DipoleMoment.hpp"
+#include "FluxDensityProfile.hpp"
+#include "ForceDensityProfile.hpp"
+#include "MagneticDipoleMoment.hpp"
+#include "ParticleReduction.hpp"
+
+#include "MpiCallbacks.hpp"
 #include "partCfg_global.hpp"
 
+#include <boost/serialization/vector.hpp>
+
 namespace Observables {
+namespace detail {
+std::unordered_map<int, std::vector<int>> &cached_ids() {
+  static std::unordered_map<int, std::vector<int>> ids;
+  return ids;
+}
+} // namespace detail
+} // namespace Observables
+
+namespace {
+void mpi_set_cached_ids_slave(int key, std::vector<int> const &ids) {
+  Observables::detail::cached_ids()[key] = ids;
+}
+
+void mpi_erase_cached_ids_slave(int key) {
+  Observables::detail::cached_ids().erase(key);
+}
+} // namespace
+
+REGISTER_CALLBACK(mpi_set_cached_ids_slave)
+REGISTER_CALLBACK(mpi_erase_cached_ids_slave)
+
+namespace Observables {
+namespace detail {
+CachedIds::CachedIds() {
+  static int next_key = 0;
+  m_key = next_key++;
+}
+
+CachedIds::~CachedIds() {
+  if (m_version)
+    mpi_call(mpi_erase_cached_ids_slave, m_key);
+}
+
+void CachedIds::update(std::vector<int> const &ids, unsigned version) {
+  if (m_version and *m_version == version)
+    return;
+
+  mpi_call(mpi_set_cached_ids_slave, m_key, ids);
+  m_version = version;
+}
+} // namespace detail
+
+namespace {
+/* Callbacks for the observables evaluated by @ref ParticleReduction. */
+#define REGISTER_PARTICLE_REDUCTION(Obs)                                       \
+  ::Communication::RegisterCallback register_reduction_##Obs(                  \
+      &detail::mpi_reduce_partial_slave<Obs>);
+
+REGISTER_PARTICLE_REDUCTION(ComForce)
+REGISTER_PARTICLE_REDUCTION(ComPosition)
+REGISTER_PARTICLE_REDUCTION(ComVelocity)
+REGISTER_PARTICLE_REDUCTION(Current)
+REGISTER_PARTICLE_REDUCTION(CylindricalDensityProfile)
+REGISTER_PARTICLE_REDUCTION(CylindricalFluxDensityProfile)
+REGISTER_PARTICLE_REDUCTION(CylindricalVelocityProfile)
+REGISTER_PARTICLE_REDUCTION(DensityProfile)
+REGISTER_PARTICLE_REDUCTION(DipoleMoment)
+REGISTER_PARTICLE_REDUCTION(FluxDensityProfile)
+REGISTER_PARTICLE_REDUCTION(ForceDensityProfile)
+REGISTER_PARTICLE_REDUCTION(MagneticDipoleMoment)
+
+#undef REGISTER_PARTICLE_REDUCTION
+} // namespace
+
 std::vector<double> PidObservable::operator()() const {
+  if (auto result = this->evaluate_distributed())
+    return std::move(*result);
+
   return this->evaluate(partCfg());
 }
 } // namespace Observables
\ No newline at end of file
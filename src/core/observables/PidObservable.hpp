@@ -25,6 +25,9 @@
 
 #include "PartCfg.hpp"
 
+#include <boost/optional.hpp>
+
+#include <utility>
 #include <vector>
 
 namespace Observables {
@@ -37,15 +40,36 @@ namespace Observables {
 class PidObservable : virtual public Observable {
   /** Identifiers of particles measured by this observable */
   std::vector<int> m_ids;
+  /** Number of changes of @ref m_ids */
+  unsigned m_ids_version = 0;
 
   virtual std::vector<double> evaluate(PartCfg &partCfg) const = 0;
 
+  /** Evaluate the observable on the particles of every node, without
+   *  gathering them on the head node. Returns nothing if the result
+   *  depends on the order of the particles, in which case
+   *  @ref evaluate is used on the gathered configuration.
+   */
+  virtual boost::optional<std::vector<double>> evaluate_distributed() const {
+    return {};
+  }
+
 public:
+  PidObservable() = default;
   explicit PidObservable(std::vector<int> ids) : m_ids(std::move(ids)) {}
   std::vector<double> operator()() const final;
 
-  std::vector<int> &ids() { return m_ids; }
   std::vector<int> const &ids() const { return m_ids; }
+  void set_ids(std::vector<int> ids) {
+    m_ids = std::move(ids);
+    ++m_ids_version;
+  }
+  /** Changes whenever the ids are set. */
+  unsigned ids_version() const { return m_ids_version; }
+
+  /** The ids are not serialized, @ref ParticleReduction keeps them on
+   *  the nodes separately. */
+  template <class Archive> void serialize(Archive &, long int) {}
 };
 
 } // Namespace Observables
@@ -31,12 +31,18 @@ namespace Observables {
 // Observable which acts on a given list of particle ids
 class PidProfileObservable : public PidObservable, public ProfileObservable {
 public:
+  PidProfileObservable() = default;
   PidProfileObservable(std::vector<int> const &ids, int n_x_bins, int n_y_bins,
                        int n_z_bins, double min_x, double min_y, double min_z,
                        double max_x, double max_y, double max_z)
       : PidObservable(ids),
         ProfileObservable(min_x, max_x, min_y, max_y, min_z, max_z, n_x_bins,
                           n_y_bins, n_z_bins) {}
+
+  template <class Archive> void serialize(Archive &ar, long int version) {
+    PidObservable::serialize(ar, version);
+    ProfileObservable::serialize(ar, version);
+  }
 };
 
 } // Namespace Observables
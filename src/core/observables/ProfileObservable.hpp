@@ -26,6 +26,7 @@ namespace Observables {
 // Observable which acts on a given list of particle ids
 class ProfileObservable : virtual public Observable {
 public:
+  ProfileObservable() = default;
   ProfileObservable(double min_x, double max_x, double min_y, double max_y,
                     double min_z, double max_z, int n_x_bins, int n_y_bins,
                     int n_z_bins)
@@ -37,6 +38,11 @@ public:
   double min_z, max_z;
   int n_x_bins, n_y_bins, n_z_bins;
   int n_values() const override { return n_x_bins * n_y_bins * n_z_bins; };
+
+  template <class Archive> void serialize(Archive &ar, long int) {
+    ar &min_x &max_x &min_y &max_y &min_z &max_z;
+    ar &n_x_bins &n_y_bins &n_z_bins;
+  }
 };
 
 } // Namespace Observables
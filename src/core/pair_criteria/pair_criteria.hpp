@@ -21,6 +21,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "energy_inline.hpp"
 #include "particle_data.hpp"
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
 
 namespace PairCriteria {
@@ -39,6 +41,11 @@ public:
     const bool res = decide(p1, p2);
     return res;
   }
+  /** @brief Distance beyond which two particles are never neighbors,
+   * infinity if there is none */
+  virtual double range() const {
+    return std::numeric_limits<double>::infinity();
+  }
   virtual ~PairCriterion() = default;
 };
 
@@ -49,9 +56,14 @@ public:
   bool decide(const Particle &p1, const Particle &p2) const override {
     return get_mi_vector(p1.r.p, p2.r.p, box_geo).norm() <= m_cut_off;
   };
+  double range() const override { return m_cut_off; }
   double get_cut_off() { return m_cut_off; }
   void set_cut_off(double c) { m_cut_off = c; }
 
+  template <class Archive> void serialize(Archive &ar, long int) {
+    ar &m_cut_off;
+  }
+
 private:
   double m_cut_off;
 };
@@ -70,9 +82,22 @@ public:
     return (calc_non_bonded_pair_energy(p1, p2, ia_params, vec21,
                                         dist_betw_part)) >= m_cut_off;
   };
+  /** The energy vanishes beyond the interaction range */
+  double range() const override {
+    if (m_cut_off <= 0.)
+      return PairCriterion::range();
+    auto max_cut_nonbonded = INACTIVE_CUTOFF;
+    for (auto const &data : ia_params)
+      max_cut_nonbonded = std::max(max_cut_nonbonded, data.max_cut);
+    return max_cut_nonbonded;
+  }
   double get_cut_off() { return m_cut_off; }
   void set_cut_off(double c) { m_cut_off = c; }
 
+  template <class Archive> void serialize(Archive &ar, long int) {
+    ar &m_cut_off;
+  }
+
 private:
   double m_cut_off;
 };
@@ -25,10 +25,13 @@ int n_rigidbonds = 0;
 
 #ifdef BOND_CONSTRAINT
 
+RigidBondSolverParameters rigid_bond_solver;
+
 #include "bonded_interactions/bonded_interaction_data.hpp"
 #include "cells.hpp"
 #include "communication.hpp"
 #include "errorhandling.hpp"
+#include "ghosts.hpp"
 #include "global.hpp"
 #include "grid.hpp"
 #include "integrate.hpp"
@@ -37,9 +40,11 @@ int n_rigidbonds = 0;
 
 #include <utils/constants.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <mpi.h>
+#include <vector>
 
 /** \name Private functions */
 /************************************************************/
@@ -74,6 +79,13 @@ void apply_vel_corr(const ParticleRange &particles);
 void revert_force(const ParticleRange &particles,
                   const ParticleRange &ghost_particles);
 
+/** Positional corrections with LINCS. Invoked from \ref correct_pos_shake()
+ */
+void correct_pos_lincs();
+
+/** Velocity corrections with LINCS. Invoked from \ref correct_vel_shake() */
+void correct_vel_lincs();
+
 /*@}*/
 
 /*Initialize old positions (particle positions at previous time step)
@@ -161,6 +173,11 @@ void app_pos_correction(const ParticleRange &particles) {
 }
 
 void correct_pos_shake(ParticleRange const &particles) {
+  if (rigid_bond_solver.solver == RIGID_BOND_LINCS) {
+    correct_pos_lincs();
+    return;
+  }
+
   cells_update_ghosts();
   int repeat_, cnt = 0;
   int repeat = 1;
@@ -275,6 +292,11 @@ void revert_force(const ParticleRange &particles,
 }
 
 void correct_vel_shake() {
+  if (rigid_bond_solver.solver == RIGID_BOND_LINCS) {
+    correct_vel_lincs();
+    return;
+  }
+
   ghost_communicator(&cell_structure.update_ghost_pos_comm);
 
   int repeat_, repeat = 1, cnt = 0;
@@ -312,6 +334,177 @@ void correct_vel_shake() {
   revert_force(particles, ghost_particles);
 }
 
+/*****************************************************************************
+ *   LINCS
+ *****************************************************************************/
+
+/* The constraint matrix is never set up: the product with
+ * S B M^-1 B^T S of the LINCS expansion is done by accumulating
+ * M^-1 B^T S x in the correction vectors of the particles, collecting
+ * it from the ghosts and sending it back, and projecting it onto the
+ * bonds again. Constraints coupled across nodes are thereby solved
+ * with two ghost communications per expansion order, and no global
+ * reduction is needed since the number of steps is fixed. */
+
+namespace {
+/** A rigid bond of a local particle, the partner can be a ghost */
+struct LincsConstraint {
+  Particle *p1;
+  Particle *p2;
+  /** bond length */
+  double d;
+  /** inverse square root of the summed inverse masses */
+  double s;
+  /** bond direction the corrections are applied along */
+  Utils::Vector3d b;
+};
+
+std::vector<LincsConstraint> lincs_constraints(const ParticleRange &particles) {
+  std::vector<LincsConstraint> constraints;
+
+  for (auto &p1 : particles) {
+    int k = 0;
+    while (k < p1.bl.n) {
+      Bonded_ia_parameters const &ia_params = bonded_ia_params[p1.bl.e[k++]];
+      if (ia_params.type == BONDED_IA_RIGID_BOND) {
+        Particle *const p2 = local_particles[p1.bl.e[k++]];
+        if (!p2) {
+          runtimeErrorMsg() << "rigid bond broken between particles "
+                            << p1.p.identity << " and " << p1.bl.e[k - 1]
+                            << " (particles not stored on the same node)";
+          continue;
+        }
+        constraints.push_back({&p1, p2, std::sqrt(ia_params.p.rigid_bond.d2),
+                               1. / std::sqrt(1. / p1.p.mass + 1. / p2->p.mass),
+                               {}});
+      } else
+        k += ia_params.num;
+    }
+  }
+
+  return constraints;
+}
+
+/** Accumulate M^-1 B^T S x in the correction vectors, complete on the
+ *  local particles.
+ */
+void lincs_scatter(std::vector<LincsConstraint> const &constraints,
+                   std::vector<double> const &x) {
+  init_correction_vector(cell_structure.local_cells().particles());
+
+  for (std::size_t i = 0; i < constraints.size(); i++) {
+    auto const &c = constraints[i];
+    auto const corr = (c.s * x[i]) * c.b;
+    c.p1->f.f += corr / c.p1->p.mass;
+    c.p2->f.f -= corr / c.p2->p.mass;
+  }
+
+  ghost_communicator(&cell_structure.collect_ghost_force_comm);
+}
+
+/** Solve (I - A) x = S (B r - d) for the constraint deviations @p rhs by
+ *  the LINCS series expansion and store the corrections
+ *  -M^-1 B^T S x in the correction vectors of the local particles.
+ */
+void lincs_correction(std::vector<LincsConstraint> const &constraints,
+                      std::vector<double> rhs) {
+  auto term = rhs;
+  for (int n = 0; n < rigid_bond_solver.expansion_order; n++) {
+    /* term <- A term = term - S B M^-1 B^T S term */
+    lincs_scatter(constraints, term);
+    /* Local ghost updates add the forces, so the ghosts start from zero */
+    for (auto &p : cell_structure.ghost_cells().particles())
+      p.f = {};
+    ghost_communicator(&cell_structure.update_ghost_pos_comm,
+                       GHOSTTRANS_FORCE);
+    for (std::size_t i = 0; i < constraints.size(); i++) {
+      auto const &c = constraints[i];
+      term[i] -= c.s * (c.b * (c.p1->f.f - c.p2->f.f));
+      rhs[i] += term[i];
+    }
+  }
+
+  for (auto &x : rhs)
+    x = -x;
+  lincs_scatter(constraints, rhs);
+}
+} // namespace
+
+void correct_pos_lincs() {
+  cells_update_ghosts();
+
+  auto particles = cell_structure.local_cells().particles();
+  auto constraints = lincs_constraints(particles);
+  for (auto &c : constraints) {
+    c.b = get_mi_vector(c.p1->r.p_old, c.p2->r.p_old, box_geo).normalize();
+  }
+
+  std::vector<double> rhs(constraints.size());
+  for (int pass = 0; pass <= rigid_bond_solver.iterations; pass++) {
+    for (std::size_t i = 0; i < constraints.size(); i++) {
+      auto const &c = constraints[i];
+      auto const r_ij = get_mi_vector(c.p1->r.p, c.p2->r.p, box_geo);
+      auto const proj = c.b * r_ij;
+      /* The projection onto the old bond direction for which the bond
+       * has its length, the later passes correct for the rotation */
+      auto const target =
+          std::sqrt(std::max(c.d * c.d - (r_ij.norm2() - proj * proj), 0.));
+      rhs[i] = c.s * (proj - target);
+    }
+    lincs_correction(constraints, rhs);
+    app_pos_correction(particles);
+    ghost_communicator(&cell_structure.update_ghost_pos_comm);
+  }
+
+  check_resort_particles();
+}
+
+void correct_vel_lincs() {
+  ghost_communicator(&cell_structure.update_ghost_pos_comm);
+
+  auto particles = cell_structure.local_cells().particles();
+  auto ghost_particles = cell_structure.ghost_cells().particles();
+
+  transfer_force_init_vel(particles, ghost_particles);
+  auto constraints = lincs_constraints(particles);
+  for (auto &c : constraints) {
+    c.b = get_mi_vector(c.p1->r.p, c.p2->r.p, box_geo).normalize();
+  }
+
+  std::vector<double> rhs(constraints.size());
+  for (int pass = 0; pass <= rigid_bond_solver.iterations; pass++) {
+    for (std::size_t i = 0; i < constraints.size(); i++) {
+      auto const &c = constraints[i];
+      rhs[i] = c.s * (c.b * (c.p1->m.v - c.p2->m.v));
+    }
+    lincs_correction(constraints, rhs);
+    apply_vel_corr(particles);
+    ghost_communicator(&cell_structure.update_ghost_pos_comm);
+  }
+
+  revert_force(particles, ghost_particles);
+}
+
+static void mpi_rigid_bond_set_solver_local(int solver, int expansion_order,
+                                            int iterations) {
+  rigid_bond_solver.solver = static_cast<RigidBondSolver>(solver);
+  rigid_bond_solver.expansion_order = expansion_order;
+  rigid_bond_solver.iterations = iterations;
+}
+
+REGISTER_CALLBACK(mpi_rigid_bond_set_solver_local)
+
+int rigid_bond_set_solver(RigidBondSolver solver, int expansion_order,
+                          int iterations) {
+  if (expansion_order < 0 || iterations < 0)
+    return ES_ERROR;
+
+  mpi_call_all(mpi_rigid_bond_set_solver_local, static_cast<int>(solver),
+               expansion_order, iterations);
+
+  return ES_OK;
+}
+
 /*****************************************************************************
  *   setting parameters
  *****************************************************************************/
@@ -24,7 +24,8 @@
 /** \file
  * RATTLE Algorithm (Rattle: A "Velocity" Version of the
  * Shake Algorithm for Molecular Dynamics Calculations, H.C Andersen, J Comp
- * Phys, 52, 24-34, 1983)
+ * Phys, 52, 24-34, 1983) and LINCS (LINCS: A linear constraint solver for
+ * molecular simulations, B. Hess et al., J Comp Chem, 18, 1463-1472, 1997)
  *
  *  For more information see \ref rattle.cpp "rattle.cpp".
  */
@@ -52,5 +53,30 @@ void correct_vel_shake();
 /** set the parameter for a rigid, aka RATTLE bond */
 int rigid_bond_set_params(int bond_type, double d, double p_tol, double v_tol);
 
+/** Algorithms for the rigid bond constraints */
+enum RigidBondSolver {
+  /** Iterative SHAKE/RATTLE, converges to the bond tolerances */
+  RIGID_BOND_SHAKE,
+  /** Matrix expansion (LINCS), fixed number of ghost communications */
+  RIGID_BOND_LINCS
+};
+
+/** Parameters of the rigid bond constraint solver */
+struct RigidBondSolverParameters {
+  RigidBondSolver solver = RIGID_BOND_SHAKE;
+  /** Order of the LINCS matrix expansion */
+  int expansion_order = 4;
+  /** Number of LINCS correction passes after the first projection */
+  int iterations = 1;
+};
+
+extern RigidBondSolverParameters rigid_bond_solver;
+
+/** Select the constraint solver for the rigid bonds on all nodes.
+ *  @return ES_OK on success, ES_ERROR if the parameters are invalid.
+ */
+int rigid_bond_set_solver(RigidBondSolver solver, int expansion_order,
+                          int iterations);
+
 #endif
 #endif
@@ -353,6 +353,36 @@ void ReactionAlgorithm::restore_properties(
   }
 }
 
+/**
+ * Returns the ids of all particles touched by a reaction attempt.
+ */
+std::vector<int> ReactionAlgorithm::get_touched_p_ids(
+    const std::vector<StoredParticleProperty> &changed_particles_properties,
+    const std::vector<int> &p_ids_created_particles,
+    const std::vector<StoredParticleProperty> &hidden_particles_properties) {
+  std::vector<int> p_ids(p_ids_created_particles);
+  for (auto const &property : changed_particles_properties)
+    p_ids.push_back(property.p_id);
+  for (auto const &property : hidden_particles_properties)
+    p_ids.push_back(property.p_id);
+  return p_ids;
+}
+
+/**
+ * Returns the current type and the charge of that type for the particles in
+ * the property list, for a later restore_properties.
+ */
+std::vector<StoredParticleProperty> ReactionAlgorithm::get_particle_properties(
+    const std::vector<StoredParticleProperty> &property_list) {
+  std::vector<StoredParticleProperty> current_properties;
+  for (auto const &property : property_list) {
+    auto const type = get_particle_data(property.p_id).p.type;
+    current_properties.push_back(
+        {property.p_id, charges_of_types[type], type});
+  }
+  return current_properties;
+}
+
 /**
  * Calculates the expression in the acceptance probability in the reaction
  * ensemble
@@ -437,18 +467,6 @@ bool ReactionAlgorithm::generic_oneway_reaction(int reaction_id) {
     return reaction_is_accepted;
   }
 
-  // calculate potential energy
-  const double E_pot_old =
-      calculate_current_potential_energy_of_system(); // only consider potential
-                                                      // energy since we assume
-                                                      // that the kinetic part
-                                                      // drops out in the
-                                                      // process of calculating
-                                                      // ensemble averages
-                                                      // (kinetic part may be
-                                                      // separated and crossed
-                                                      // out)
-
   // find reacting molecules in reactants and save their properties for later
   // recreation if step is not accepted
   // do reaction
@@ -465,16 +483,43 @@ bool ReactionAlgorithm::generic_oneway_reaction(int reaction_id) {
   make_reaction_attempt(current_reaction, changed_particles_properties,
                         p_ids_created_particles, hidden_particles_properties);
 
-  double E_pot_new;
-  if (particle_inside_exclusion_radius_touched)
-    E_pot_new = std::numeric_limits<double>::max();
-  else
-    E_pot_new = calculate_current_potential_energy_of_system();
-
   int new_state_index = -1; // save new_state_index for Wang-Landau algorithm
   int accepted_state = -1;  // for Wang-Landau algorithm
   on_attempted_reaction(new_state_index);
 
+  // only consider potential energy since we assume that the kinetic part
+  // drops out in the process of calculating ensemble averages (kinetic part
+  // may be separated and crossed out). Only the interactions of the touched
+  // particles change, so the energy difference is evaluated for them in the
+  // new state and, after switching back, in the old state, in which the
+  // created particles are hidden.
+  auto const p_ids_touched =
+      get_touched_p_ids(changed_particles_properties, p_ids_created_particles,
+                        hidden_particles_properties);
+  double E_pot_new = std::numeric_limits<double>::max();
+  double E_pot_old = 0.0;
+  if (!particle_inside_exclusion_radius_touched)
+    E_pot_new = calculate_energy_of_particles(p_ids_touched);
+
+  auto new_changed_particles_properties =
+      get_particle_properties(changed_particles_properties);
+  std::vector<StoredParticleProperty> created_particles_properties;
+  std::vector<StoredParticleProperty> hidden_created_particles_properties;
+  for (int p_id : p_ids_created_particles) {
+    auto const type = get_particle_data(p_id).p.type;
+    created_particles_properties.push_back(
+        {p_id, charges_of_types[type], type});
+    hidden_created_particles_properties.push_back(
+        {p_id, 0.0, non_interacting_type});
+  }
+  restore_properties(hidden_created_particles_properties,
+                     number_of_saved_properties);
+  restore_properties(hidden_particles_properties, number_of_saved_properties);
+  restore_properties(changed_particles_properties, number_of_saved_properties);
+
+  if (!particle_inside_exclusion_radius_touched)
+    E_pot_old = calculate_energy_of_particles(p_ids_touched);
+
   bool const only_make_configuration_changing_move = false;
   double bf = calculate_acceptance_probability(
       current_reaction, E_pot_old, E_pot_new, old_particle_numbers,
@@ -488,41 +533,28 @@ bool ReactionAlgorithm::generic_oneway_reaction(int reaction_id) {
     // accept
     accepted_state = new_state_index;
 
-    // delete hidden reactant_particles (remark: don't delete changed particles)
-    // extract ids of to be deleted particles
-    auto len_hidden_particles_properties =
-        static_cast<int>(hidden_particles_properties.size());
-    std::vector<int> to_be_deleted_hidden_ids(len_hidden_particles_properties);
-    std::vector<int> to_be_deleted_hidden_types(
-        len_hidden_particles_properties);
-    for (int i = 0; i < len_hidden_particles_properties; i++) {
-      auto p_id = static_cast<int>(hidden_particles_properties[i].p_id);
-      to_be_deleted_hidden_ids[i] = p_id;
-      to_be_deleted_hidden_types[i] = hidden_particles_properties[i].type;
-      set_particle_type(p_id,
-                        hidden_particles_properties[i]
-                            .type); // change back type otherwise the
-      // bookkeeping algorithm is not working
-    }
+    // redo the reaction on the changed and created particles
+    restore_properties(new_changed_particles_properties,
+                       number_of_saved_properties);
+    restore_properties(created_particles_properties,
+                       number_of_saved_properties);
 
-    for (int i = 0; i < len_hidden_particles_properties; i++) {
-      delete_particle(to_be_deleted_hidden_ids[i]); // delete particle
+    // delete hidden reactant_particles (remark: don't delete changed
+    // particles), their type is already the original one, otherwise the
+    // bookkeeping algorithm is not working
+    for (auto const &hidden_particle : hidden_particles_properties) {
+      delete_particle(hidden_particle.p_id);
     }
     current_reaction.accepted_moves += 1;
     reaction_is_accepted = true;
   } else {
     // reject
     accepted_state = old_state_index;
-    // reverse reaction
-    // 1) delete created product particles
+    // the old state is already restored, only the created product particles
+    // have to be deleted
     for (int p_ids_created_particle : p_ids_created_particles) {
       delete_particle(p_ids_created_particle);
     }
-    // 2) restore previously hidden reactant particles
-    restore_properties(hidden_particles_properties, number_of_saved_properties);
-    // 3) restore previously changed reactant particles
-    restore_properties(changed_particles_properties,
-                       number_of_saved_properties);
     reaction_is_accepted = false;
   }
   on_end_reaction(accepted_state);
@@ -776,8 +808,6 @@ bool ReactionAlgorithm::do_global_mc_move_for_particles_of_type(
     return got_accepted;
   }
 
-  const double E_pot_old = calculate_current_potential_energy_of_system();
-
   std::vector<double> particle_positions(3 *
                                          particle_number_of_type_to_be_changed);
   std::vector<int> p_id_s_changed_particles;
@@ -802,6 +832,10 @@ bool ReactionAlgorithm::do_global_mc_move_for_particles_of_type(
     p_id_s_changed_particles.push_back(p_id);
   }
 
+  // only the interactions of the moved particles change
+  const double E_pot_old =
+      calculate_energy_of_particles(p_id_s_changed_particles);
+
   // propose new positions
   for (int i = 0; i < particle_number_of_type_to_be_changed; i++) {
     p_id = p_id_s_changed_particles[i];
@@ -828,7 +862,7 @@ bool ReactionAlgorithm::do_global_mc_move_for_particles_of_type(
   if (particle_inside_exclusion_radius_touched)
     E_pot_new = std::numeric_limits<double>::max();
   else
-    E_pot_new = calculate_current_potential_energy_of_system();
+    E_pot_new = calculate_energy_of_particles(p_id_s_changed_particles);
 
   double beta = 1.0 / temperature;
 
@@ -1737,7 +1771,6 @@ double ConstantpHEnsemble::calculate_acceptance_probability(
 std::pair<double, double>
 WidomInsertion::measure_excess_chemical_potential(int reaction_id) {
   SingleReaction &current_reaction = reactions[reaction_id];
-  const double E_pot_old = calculate_current_potential_energy_of_system();
 
   // make reaction attempt
   std::vector<int> p_ids_created_particles;
@@ -1748,7 +1781,11 @@ WidomInsertion::measure_excess_chemical_potential(int reaction_id) {
          // need to hide the particle and recover it
   make_reaction_attempt(current_reaction, changed_particles_properties,
                         p_ids_created_particles, hidden_particles_properties);
-  const double E_pot_new = calculate_current_potential_energy_of_system();
+  // only the interactions of the touched particles change
+  auto const p_ids_touched =
+      get_touched_p_ids(changed_particles_properties, p_ids_created_particles,
+                        hidden_particles_properties);
+  const double E_pot_new = calculate_energy_of_particles(p_ids_touched);
   // reverse reaction attempt
   // reverse reaction
   // 1) delete created product particles
@@ -1759,6 +1796,7 @@ WidomInsertion::measure_excess_chemical_potential(int reaction_id) {
   restore_properties(hidden_particles_properties, number_of_saved_properties);
   // 3) restore previously changed reactant particles
   restore_properties(changed_particles_properties, number_of_saved_properties);
+  const double E_pot_old = calculate_energy_of_particles(p_ids_touched);
   std::vector<double> exponential = {
       exp(-1.0 / temperature * (E_pot_new - E_pot_old))};
   current_reaction.accumulator_exponentials(exponential);
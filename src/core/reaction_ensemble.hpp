@@ -181,6 +181,12 @@ protected:
       std::vector<StoredParticleProperty> &hidden_particles_properties);
   void restore_properties(std::vector<StoredParticleProperty> &property_list,
                           int number_of_saved_properties);
+  std::vector<int> get_touched_p_ids(
+      const std::vector<StoredParticleProperty> &changed_particles_properties,
+      const std::vector<int> &p_ids_created_particles,
+      const std::vector<StoredParticleProperty> &hidden_particles_properties);
+  std::vector<StoredParticleProperty> get_particle_properties(
+      const std::vector<StoredParticleProperty> &property_list);
 
   /**
    * @brief draws a random integer from the uniform distribution in the range
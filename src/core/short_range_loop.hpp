@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define CORE_SHORT_RANGE_HPP
 
 #include "algorithm/for_each_pair.hpp"
+#include "algorithm/for_each_pair_parallel.hpp"
 #include "cells.hpp"
 #include "grid.hpp"
 
@@ -66,36 +67,19 @@ struct EuclidianDistance {
 };
 
 /**
- * @brief Decided which distance function to use depending on the
-          cell system, and call the pair code.
-*/
-template <typename CellIterator, typename ParticleKernel, typename PairKernel,
-          typename VerletCriterion>
-void decide_distance(CellIterator first, CellIterator last,
-                     ParticleKernel &&particle_kernel, PairKernel &&pair_kernel,
-                     VerletCriterion &&verlet_criterion) {
+ * @brief Decide which distance function to use depending on the
+ *        cell system, and call @p loop with it.
+ */
+template <typename Loop> void decide_distance(Loop &&loop) {
   switch (cell_structure.type) {
   case CELL_STRUCTURE_DOMDEC:
-    Algorithm::for_each_pair(
-        first, last, std::forward<ParticleKernel>(particle_kernel),
-        std::forward<PairKernel>(pair_kernel), EuclidianDistance{},
-        std::forward<VerletCriterion>(verlet_criterion),
-        cell_structure.use_verlet_list, rebuild_verletlist);
+    loop(EuclidianDistance{});
     break;
   case CELL_STRUCTURE_NSQUARE:
-    Algorithm::for_each_pair(
-        first, last, std::forward<ParticleKernel>(particle_kernel),
-        std::forward<PairKernel>(pair_kernel), MinimalImageDistance{box_geo},
-        std::forward<VerletCriterion>(verlet_criterion),
-        cell_structure.use_verlet_list, rebuild_verletlist);
+    loop(MinimalImageDistance{box_geo});
     break;
   case CELL_STRUCTURE_LAYERED:
-    Algorithm::for_each_pair(
-        first, last, std::forward<ParticleKernel>(particle_kernel),
-        std::forward<PairKernel>(pair_kernel),
-        LayeredMinimalImageDistance{box_geo},
-        std::forward<VerletCriterion>(verlet_criterion),
-        cell_structure.use_verlet_list, rebuild_verletlist);
+    loop(LayeredMinimalImageDistance{box_geo});
     break;
   }
 }
@@ -109,6 +93,14 @@ struct True {
 };
 } // namespace detail
 
+/**
+ * @brief Run a kernel on all pairs of particles within the interaction
+ *        range and then a kernel on every local particle.
+ *
+ * The particle kernel runs after all pairs, in the same order as in
+ * @ref short_range_loop_parallel, so that the threaded loop gives the
+ * same results.
+ */
 template <class ParticleKernel, class PairKernel,
           class VerletCriterion = detail::True>
 void short_range_loop(ParticleKernel &&particle_kernel,
@@ -119,18 +111,84 @@ void short_range_loop(ParticleKernel &&particle_kernel,
   assert(get_resort_particles() == Cells::RESORT_NONE);
 
   if (cell_structure.min_range != INACTIVE_CUTOFF) {
-    auto first = boost::make_indirect_iterator(local_cells.begin());
-    auto last = boost::make_indirect_iterator(local_cells.end());
-
-    detail::decide_distance(
-        first, last, std::forward<ParticleKernel>(particle_kernel),
-        std::forward<PairKernel>(pair_kernel), verlet_criterion);
+    auto const loop = [&](auto &cells) {
+      auto first = boost::make_indirect_iterator(cells.begin());
+      auto last = boost::make_indirect_iterator(cells.end());
+
+      detail::decide_distance([&](auto const &distance_function) {
+        Algorithm::for_each_pair(first, last, [](auto &) {}, pair_kernel,
+                                 distance_function, verlet_criterion,
+                                 cell_structure.use_verlet_list,
+                                 rebuild_verletlist,
+                                 cell_structure.use_cluster_pairs);
+      });
+    };
+
+    if (cells_ghost_update_pending()) {
+      /* The interior cells do not need the ghosts, so they are
+       * done while the ghost positions are still in transit. */
+      loop(cells_interior());
+      cells_finish_ghost_update();
+      loop(cells_boundary());
+    } else {
+      loop(local_cells);
+    }
 
     rebuild_verletlist = false;
   } else {
-    for (auto &p : cell_structure.local_cells().particles()) {
-      particle_kernel(p);
-    }
+    cells_finish_ghost_update();
+  }
+
+  for (auto &p : cell_structure.local_cells().particles()) {
+    particle_kernel(p);
+  }
+}
+
+/**
+ * @brief Multi-threaded version of @ref short_range_loop.
+ *
+ * If @ref CellStructure::use_threads is set, groups of cells that do not
+ * share any particles are processed concurrently, see
+ * @ref Algorithm::color_cells. The pair kernel has to be safe to call
+ * concurrently for different pairs, state that is not stored in the
+ * particles has to be kept per thread (see @ref Threads::thread_num).
+ * The particle kernel may write to particles anywhere on the node, like
+ * the partners of bonds, which can be far outside of the cells of its
+ * group, so it is called on one thread after all pairs are done, as in
+ * @ref short_range_loop.
+ */
+template <class ParticleKernel, class PairKernel,
+          class VerletCriterion = detail::True>
+void short_range_loop_parallel(ParticleKernel &&particle_kernel,
+                               PairKernel &&pair_kernel,
+                               const VerletCriterion &verlet_criterion = {}) {
+  if (not cell_structure.use_threads or
+      cell_structure.min_range == INACTIVE_CUTOFF) {
+    short_range_loop(std::forward<ParticleKernel>(particle_kernel),
+                     std::forward<PairKernel>(pair_kernel), verlet_criterion);
+    return;
+  }
+
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+
+  assert(get_resort_particles() == Cells::RESORT_NONE);
+
+  /* The overlap with the ghost communication is not threaded */
+  cells_finish_ghost_update();
+
+  auto const &groups = cells_thread_groups();
+
+  detail::decide_distance([&](auto const &distance_function) {
+    Algorithm::for_each_pair_parallel(
+        groups, [](auto &) {}, pair_kernel, distance_function,
+        verlet_criterion, cell_structure.use_verlet_list, rebuild_verletlist,
+        cell_structure.use_cluster_pairs);
+  });
+
+  rebuild_verletlist = false;
+
+  for (auto &p : cell_structure.local_cells().particles()) {
+    particle_kernel(p);
   }
 }
 
@@ -39,6 +39,8 @@
 #include "particle_data.hpp"
 #include "pressure.hpp"
 #include "short_range_loop.hpp"
+#include "statistics_rdf.hpp"
+#include "statistics_structure_factor.hpp"
 
 #include <utils/NoOp.hpp>
 #include <utils/constants.hpp>
@@ -278,65 +280,18 @@ void calc_part_distribution(PartCfg &partCfg, int const *p1_types, int n_p1,
 void calc_rdf(PartCfg &partCfg, std::vector<int> const &p1_types,
               std::vector<int> const &p2_types, double r_min, double r_max,
               int r_bins, std::vector<double> &rdf) {
-  calc_rdf(partCfg, &p1_types[0], p1_types.size(), &p2_types[0],
-           p2_types.size(), r_min, r_max, r_bins, &rdf[0]);
+  rdf = calc_rdfs(partCfg, {{p1_types, p2_types}}, r_min, r_max, r_bins)[0];
 }
 
 void calc_rdf(PartCfg &partCfg, int const *p1_types, int n_p1,
               int const *p2_types, int n_p2, double r_min, double r_max,
               int r_bins, double *rdf) {
-  long int cnt = 0;
-  int i, t1, t2, ind;
-  bool mixed_flag = false;
-  double inv_bin_width = 0.0, bin_width = 0.0;
-  double volume, bin_volume, r_in, r_out;
-
-  if (n_p1 == n_p2) {
-    for (i = 0; i < n_p1; i++)
-      if (p1_types[i] != p2_types[i])
-        mixed_flag = true;
-  } else
-    mixed_flag = true;
-
-  bin_width = (r_max - r_min) / (double)r_bins;
-  inv_bin_width = 1.0 / bin_width;
-  for (i = 0; i < r_bins; i++)
-    rdf[i] = 0.0;
-  /* particle loop: p1_types*/
-  for (auto it = partCfg.begin(); it != partCfg.end(); ++it) {
-    for (t1 = 0; t1 < n_p1; t1++) {
-      if (it->p.type == p1_types[t1]) {
-        /* distinguish mixed and identical rdf's */
-        auto jt = mixed_flag ? partCfg.begin() : std::next(it);
-
-        /* particle loop: p2_types*/
-        for (; jt != partCfg.end(); ++jt) {
-          for (t2 = 0; t2 < n_p2; t2++) {
-            if (jt->p.type == p2_types[t2]) {
-              auto const dist = get_mi_vector(it->r.p, jt->r.p, box_geo).norm();
-              if (dist > r_min && dist < r_max) {
-                ind = (int)((dist - r_min) * inv_bin_width);
-                rdf[ind]++;
-              }
-              cnt++;
-            }
-          }
-        }
-      }
-    }
-  }
-  if (cnt == 0)
-    return;
-
-  /* normalization */
-  volume = box_geo.length()[0] * box_geo.length()[1] * box_geo.length()[2];
-  for (i = 0; i < r_bins; i++) {
-    r_in = i * bin_width + r_min;
-    r_out = r_in + bin_width;
-    bin_volume = (4.0 / 3.0) * Utils::pi() *
-                 ((r_out * r_out * r_out) - (r_in * r_in * r_in));
-    rdf[i] *= volume / (bin_volume * cnt);
-  }
+  auto const result =
+      calc_rdfs(partCfg,
+                {{std::vector<int>(p1_types, p1_types + n_p1),
+                  std::vector<int>(p2_types, p2_types + n_p2)}},
+                r_min, r_max, r_bins)[0];
+  std::copy(result.begin(), result.end(), rdf);
 }
 
 void calc_rdf_av(PartCfg &partCfg, std::vector<int> const &p1_types,
@@ -431,15 +386,6 @@ void calc_rdf_av(PartCfg &partCfg, int const *p1_types, int n_p1,
 
 std::vector<double> calc_structurefactor(PartCfg &partCfg, int const *p_types,
                                          int n_types, int order) {
-  int i, j, k, n, qi, t, order2;
-  double qr, twoPI_L, C_sum, S_sum;
-
-  order2 = order * order;
-  std::vector<double> ff;
-  ff.resize(2 * order2);
-  ff[2 * order2] = 0;
-  twoPI_L = 2 * Utils::pi() / box_geo.length()[0];
-
   if ((n_types < 0) || (n_types > max_seen_particle_type)) {
     fprintf(stderr, "WARNING: Wrong number of particle types!");
     fflush(nullptr);
@@ -449,43 +395,10 @@ std::vector<double> calc_structurefactor(PartCfg &partCfg, int const *p_types,
             "WARNING: parameter \"order\" has to be a whole positive number");
     fflush(nullptr);
     errexit();
-  } else {
-    for (qi = 0; qi < 2 * order2; qi++) {
-      ff[qi] = 0.0;
-    }
-    for (i = 0; i <= order; i++) {
-      for (j = -order; j <= order; j++) {
-        for (k = -order; k <= order; k++) {
-          n = i * i + j * j + k * k;
-          if ((n <= order2) && (n >= 1)) {
-            C_sum = S_sum = 0.0;
-            for (auto const &p : partCfg) {
-              for (t = 0; t < n_types; t++) {
-                if (p.p.type == p_types[t]) {
-                  qr = twoPI_L * (i * p.r.p[0] + j * p.r.p[1] + k * p.r.p[2]);
-                  C_sum += cos(qr);
-                  S_sum += sin(qr);
-                }
-              }
-            }
-            ff[2 * n - 2] += C_sum * C_sum + S_sum * S_sum;
-            ff[2 * n - 1]++;
-          }
-        }
-      }
-    }
-    n = 0;
-    for (auto const &p : partCfg) {
-      for (t = 0; t < n_types; t++) {
-        if (p.p.type == p_types[t])
-          n++;
-      }
-    }
-    for (qi = 0; qi < order2; qi++)
-      if (ff[2 * qi + 1] != 0)
-        ff[2 * qi] /= n * ff[2 * qi + 1];
   }
-  return ff;
+
+  return calc_structurefactor_direct(
+      std::vector<int>(p_types, p_types + n_types), order);
 }
 
 std::vector<std::vector<double>> modify_stucturefactor(int order,
@@ -114,7 +114,8 @@ void calc_part_distribution(PartCfg &, int const *p1_types, int n_p1,
  *  types given in the @p p1_types list around particles with types given
  *  in the @p p2_types list. The range is given by @p r_min and @p r_max and
  *  the distribution function is binned into @p r_bin bins, which are
- *  equidistant. The result is stored in the array @p rdf.
+ *  equidistant. The result is stored in the array @p rdf. The pairs are
+ *  found with linked cells, see @ref calc_rdfs.
  *
  *  @param partCfg  @copybrief PartCfg
  *  @param p1_types list with types of particles to find the distribution for.
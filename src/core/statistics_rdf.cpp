@@ -0,0 +1,483 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+  Copyright (C) 2002,2003,2004,2005,2006,2007,2008,2009,2010
+    Max-Planck-Institute for Polymer Research, Theory Group
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** \file
+ *  Implementation of \ref statistics_rdf.hpp.
+ */
+
+#include "statistics_rdf.hpp"
+
+#include "algorithm/link_cell.hpp"
+#include "cells.hpp"
+#include "communication.hpp"
+#include "event.hpp"
+#include "grid.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "short_range_loop.hpp"
+
+#include <utils/constants.hpp>
+#include <utils/index.hpp>
+
+#include <boost/iterator/indirect_iterator.hpp>
+#include <boost/mpi/collectives/all_gather.hpp>
+#include <boost/mpi/collectives/all_to_all.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+/** Pair distance histograms for a set of @ref RdfTypes.
+ *
+ *  The weight of a particle in a type list is the number of times its
+ *  type appears in the list. For every radial distribution function the
+ *  buffer holds the histogram, followed by the sums of the weights in the
+ *  first and the second list and the sum of the squared weights in the
+ *  first list, from which the number of pairs follows.
+ */
+class RdfAccumulator {
+public:
+  RdfAccumulator(std::vector<RdfTypes> const &types, double r_min,
+                 double r_max, int r_bins)
+      : m_r_min(r_min), m_r_max(r_max), m_r_bins(r_bins),
+        m_inv_bin_width(r_bins / (r_max - r_min)),
+        m_buffer(types.size() * (r_bins + 3)) {
+    for (auto const &t : types) {
+      m_weights.emplace_back(weights(t.first), weights(t.second));
+      m_mixed.push_back(t.first != t.second);
+    }
+  }
+
+  /** Whether particles of type @p type are part of any of the functions. */
+  bool involves(int type) const {
+    return std::any_of(m_weights.begin(), m_weights.end(),
+                       [type](auto const &w) {
+                         return weight(w.first, type) != 0. or
+                                weight(w.second, type) != 0.;
+                       });
+  }
+
+  void add_particle(int type) {
+    for (size_t i = 0; i < m_weights.size(); i++) {
+      auto const w1 = weight(m_weights[i].first, type);
+      auto const w2 = weight(m_weights[i].second, type);
+      auto sums = m_buffer.begin() + i * (m_r_bins + 3) + m_r_bins;
+      sums[0] += w1;
+      sums[1] += w2;
+      sums[2] += w1 * w1;
+    }
+  }
+
+  /** Add a pair of particles, the @p scale of all additions of the same
+   *  pair has to sum up to one. */
+  void add_pair(int type1, int type2, double dist2, double scale = 1.) {
+    if (dist2 >= m_r_max * m_r_max)
+      return;
+
+    auto const dist = std::sqrt(dist2);
+    if (dist <= m_r_min)
+      return;
+
+    auto const ind = std::min(
+        static_cast<int>((dist - m_r_min) * m_inv_bin_width), m_r_bins - 1);
+    for (size_t i = 0; i < m_weights.size(); i++) {
+      auto const &w = m_weights[i];
+      auto const pair_weight =
+          m_mixed[i] ? weight(w.first, type1) * weight(w.second, type2) +
+                           weight(w.first, type2) * weight(w.second, type1)
+                     : weight(w.first, type1) * weight(w.first, type2);
+      m_buffer[i * (m_r_bins + 3) + ind] += scale * pair_weight;
+    }
+  }
+
+  std::vector<double> const &buffer() const { return m_buffer; }
+
+  /** Normalize the histograms in @p buffer by the volume of the bins, the
+   *  number of pairs and the volume of the box.
+   */
+  std::vector<std::vector<double>>
+  normalize(std::vector<double> const &buffer) const {
+    auto const volume =
+        box_geo.length()[0] * box_geo.length()[1] * box_geo.length()[2];
+    auto const bin_width = (m_r_max - m_r_min) / m_r_bins;
+
+    std::vector<std::vector<double>> rdfs;
+    for (size_t i = 0; i < m_weights.size(); i++) {
+      auto const first = buffer.begin() + i * (m_r_bins + 3);
+      std::vector<double> rdf(first, first + m_r_bins);
+
+      auto const sum1 = first[m_r_bins];
+      auto const sum2 = first[m_r_bins + 1];
+      auto const sum1_sq = first[m_r_bins + 2];
+      auto const n_pairs =
+          m_mixed[i] ? sum1 * sum2 : 0.5 * (sum1 * sum1 - sum1_sq);
+
+      if (n_pairs > 0.) {
+        for (int j = 0; j < m_r_bins; j++) {
+          auto const r_in = j * bin_width + m_r_min;
+          auto const r_out = r_in + bin_width;
+          auto const bin_volume =
+              (4.0 / 3.0) * Utils::pi() *
+              ((r_out * r_out * r_out) - (r_in * r_in * r_in));
+          rdf[j] *= volume / (bin_volume * n_pairs);
+        }
+      }
+      rdfs.push_back(std::move(rdf));
+    }
+    return rdfs;
+  }
+
+private:
+  static std::vector<double> weights(std::vector<int> const &types) {
+    std::vector<double> w;
+    for (auto const type : types) {
+      if (type < 0)
+        continue;
+      if (type >= w.size())
+        w.resize(type + 1, 0.);
+      w[type] += 1.;
+    }
+    return w;
+  }
+
+  static double weight(std::vector<double> const &w, int type) {
+    return (type >= 0 and type < w.size()) ? w[type] : 0.;
+  }
+
+  double m_r_min, m_r_max;
+  int m_r_bins;
+  double m_inv_bin_width;
+  std::vector<std::pair<std::vector<double>, std::vector<double>>> m_weights;
+  std::vector<bool> m_mixed;
+  std::vector<double> m_buffer;
+};
+
+/** Histogram the pairs of the local cells and sum up the histograms
+ *  of all nodes on the head node.
+ */
+std::vector<double> reduce_rdf_histograms(std::vector<RdfTypes> const &types,
+                                          double r_min, double r_max,
+                                          int r_bins) {
+  on_observable_calc();
+  cells_finish_ghost_update();
+
+  RdfAccumulator acc(types, r_min, r_max, r_bins);
+  detail::decide_distance([&acc](auto const &distance_function) {
+    Algorithm::link_cell(
+        boost::make_indirect_iterator(local_cells.begin()),
+        boost::make_indirect_iterator(local_cells.end()),
+        [&acc](Particle const &p) { acc.add_particle(p.p.type); },
+        [&acc](Particle const &p1, Particle const &p2, Distance const &d) {
+          acc.add_pair(p1.p.type, p2.p.type, d.dist2);
+        },
+        distance_function);
+  });
+
+  auto const &local = acc.buffer();
+  std::vector<double> global((this_node == 0) ? local.size() : 0);
+  MPI_Reduce(local.data(), global.data(), static_cast<int>(local.size()),
+             MPI_DOUBLE, MPI_SUM, 0, comm_cart);
+  return global;
+}
+
+void mpi_reduce_rdf_histograms_slave(std::vector<RdfTypes> types,
+                                     double r_min, double r_max, int r_bins) {
+  reduce_rdf_histograms(types, r_min, r_max, r_bins);
+}
+
+/** Call @p kernel(i, j) for all pairs i < j of @p positions that can be
+ *  closer than @p r_max, which are found with cells of at least size
+ *  @p r_max in the bounding box of the positions.
+ */
+template <class Kernel>
+void for_each_close_pair(std::vector<Utils::Vector3d> const &positions,
+                         double r_max, Kernel kernel) {
+  if (positions.empty())
+    return;
+
+  auto lower = positions.front();
+  auto upper = positions.front();
+  for (auto const &pos : positions) {
+    for (int i = 0; i < 3; i++) {
+      lower[i] = std::min(lower[i], pos[i]);
+      upper[i] = std::max(upper[i], pos[i]);
+    }
+  }
+  auto const extent = upper - lower;
+
+  /* Not more cells than particles, if r_max is small */
+  auto const cell_size = std::max(
+      r_max, std::cbrt(extent[0] * extent[1] * extent[2] / positions.size()));
+  Utils::Vector3i n_cells;
+  for (int i = 0; i < 3; i++) {
+    n_cells[i] = std::max(1, static_cast<int>(extent[i] / cell_size));
+  }
+
+  auto const cell_of = [&](Utils::Vector3d const &pos) {
+    Utils::Vector3i ind;
+    for (int i = 0; i < 3; i++) {
+      auto const j = (extent[i] > 0.)
+                         ? static_cast<int>((pos[i] - lower[i]) / extent[i] *
+                                            n_cells[i])
+                         : 0;
+      ind[i] = std::min(j, n_cells[i] - 1);
+    }
+    return ind;
+  };
+
+  std::vector<std::vector<int>> cells(n_cells[0] * n_cells[1] * n_cells[2]);
+  for (int i = 0; i < positions.size(); i++) {
+    cells[Utils::get_linear_index(cell_of(positions[i]), n_cells)].push_back(i);
+  }
+
+  for (int i = 0; i < positions.size(); i++) {
+    auto const ind = cell_of(positions[i]);
+    for (int dx = -1; dx <= 1; dx++)
+      for (int dy = -1; dy <= 1; dy++)
+        for (int dz = -1; dz <= 1; dz++) {
+          Utils::Vector3i const n_ind = ind + Utils::Vector3i{dx, dy, dz};
+          if (n_ind[0] < 0 or n_ind[1] < 0 or n_ind[2] < 0 or
+              n_ind[0] >= n_cells[0] or n_ind[1] >= n_cells[1] or
+              n_ind[2] >= n_cells[2])
+            continue;
+          for (auto const j : cells[Utils::get_linear_index(n_ind, n_cells)]) {
+            if (j > i)
+              kernel(i, j);
+          }
+        }
+  }
+}
+
+/** Histogram the pairs of the local particles with each other and with
+ *  the periodic images of the particles of all nodes within @p r_max,
+ *  and sum up the histograms of all nodes on the head node.
+ *
+ *  The local particles of every node are within a bounding box, and every
+ *  node receives the images that are closer than @p r_max to the box of
+ *  the other node. A pair of a local particle and a received image is
+ *  also found by the node of the image, so it is counted half on both.
+ *  @p r_max may be at most half of the box in the periodic directions,
+ *  so that every pair has at most one image within @p r_max.
+ */
+std::vector<double> halo_rdf_histograms(std::vector<RdfTypes> const &types,
+                                        double r_min, double r_max,
+                                        int r_bins) {
+  on_observable_calc();
+
+  RdfAccumulator acc(types, r_min, r_max, r_bins);
+
+  std::vector<Utils::Vector3d> positions;
+  std::vector<int> p_types;
+  auto lower = Utils::Vector3d::broadcast(std::numeric_limits<double>::max());
+  auto upper = Utils::Vector3d::broadcast(-std::numeric_limits<double>::max());
+  for (auto const &p : local_cells.particles()) {
+    if (not acc.involves(p.p.type))
+      continue;
+    auto const pos = folded_position(p.r.p, box_geo);
+    for (int i = 0; i < 3; i++) {
+      lower[i] = std::min(lower[i], pos[i]);
+      upper[i] = std::max(upper[i], pos[i]);
+    }
+    positions.push_back(pos);
+    p_types.push_back(p.p.type);
+    acc.add_particle(p.p.type);
+  }
+  auto const n_local = positions.size();
+
+  std::vector<std::pair<Utils::Vector3d, Utils::Vector3d>> bounds;
+  boost::mpi::all_gather(comm_cart, std::make_pair(lower, upper), bounds);
+
+  auto const close_to_box = [r_max](Utils::Vector3d const &pos,
+                                    Utils::Vector3d const &box_lower,
+                                    Utils::Vector3d const &box_upper) {
+    double dist2 = 0.;
+    for (int i = 0; i < 3; i++) {
+      auto const d =
+          std::max({box_lower[i] - pos[i], 0., pos[i] - box_upper[i]});
+      dist2 += d * d;
+    }
+    return dist2 < r_max * r_max;
+  };
+
+  std::vector<Utils::Vector3d> shifts;
+  for (int dx = -1; dx <= 1; dx++)
+    for (int dy = -1; dy <= 1; dy++)
+      for (int dz = -1; dz <= 1; dz++) {
+        Utils::Vector3i const image{dx, dy, dz};
+        bool valid = true;
+        for (int i = 0; i < 3; i++) {
+          valid &= box_geo.periodic(i) or image[i] == 0;
+        }
+        if (valid)
+          shifts.push_back({dx * box_geo.length()[0],
+                            dy * box_geo.length()[1],
+                            dz * box_geo.length()[2]});
+      }
+
+  std::vector<std::vector<std::pair<Utils::Vector3d, int>>> send_buf(n_nodes),
+      recv_buf;
+  for (int i = 0; i < n_local; i++) {
+    for (auto const &shift : shifts) {
+      auto const image = positions[i] + shift;
+      for (int node = 0; node < n_nodes; node++) {
+        if (node == this_node and shift.norm2() == 0.)
+          continue;
+        if (close_to_box(image, bounds[node].first, bounds[node].second))
+          send_buf[node].emplace_back(image, p_types[i]);
+      }
+    }
+  }
+  boost::mpi::all_to_all(comm_cart, send_buf, recv_buf);
+
+  for (auto const &images : recv_buf) {
+    for (auto const &image : images) {
+      positions.push_back(image.first);
+      p_types.push_back(image.second);
+    }
+  }
+
+  for_each_close_pair(positions, r_max, [&](int i, int j) {
+    if (i >= n_local)
+      return;
+    acc.add_pair(p_types[i], p_types[j], (positions[i] - positions[j]).norm2(),
+                 (j < n_local) ? 1. : 0.5);
+  });
+
+  auto const &local = acc.buffer();
+  std::vector<double> global((this_node == 0) ? local.size() : 0);
+  MPI_Reduce(local.data(), global.data(), static_cast<int>(local.size()),
+             MPI_DOUBLE, MPI_SUM, 0, comm_cart);
+  return global;
+}
+
+void mpi_halo_rdf_histograms_slave(std::vector<RdfTypes> types, double r_min,
+                                   double r_max, int r_bins) {
+  halo_rdf_histograms(types, r_min, r_max, r_bins);
+}
+
+/** Histogram the pairs of the gathered particle configuration, which are
+ *  sorted into cells of at least size @p r_max for this.
+ */
+void gathered_rdf_histograms(PartCfg &partCfg, RdfAccumulator &acc,
+                             double r_max) {
+  std::vector<Utils::Vector3d> positions;
+  std::vector<int> types;
+  for (auto const &p : partCfg) {
+    if (not acc.involves(p.p.type))
+      continue;
+    positions.push_back(folded_position(p.r.p, box_geo));
+    types.push_back(p.p.type);
+    acc.add_particle(p.p.type);
+  }
+
+  /* Not more cells than particles, if r_max is small */
+  auto const box = box_geo.length();
+  auto const cell_size =
+      std::max(r_max, std::cbrt(box[0] * box[1] * box[2] /
+                                std::max<double>(positions.size(), 1.)));
+  Utils::Vector3i n_cells;
+  for (int i = 0; i < 3; i++) {
+    n_cells[i] = std::max(1, static_cast<int>(box[i] / cell_size));
+  }
+
+  /* Positions outside of non-periodic directions go to the boundary cells */
+  auto const cell_of = [&](Utils::Vector3d const &pos) {
+    Utils::Vector3i ind;
+    for (int i = 0; i < 3; i++) {
+      auto const j = static_cast<int>(std::floor(pos[i] / box[i] * n_cells[i]));
+      ind[i] = std::min(std::max(j, 0), n_cells[i] - 1);
+    }
+    return ind;
+  };
+
+  std::vector<std::vector<int>> cells(n_cells[0] * n_cells[1] * n_cells[2]);
+  for (int i = 0; i < positions.size(); i++) {
+    cells[Utils::get_linear_index(cell_of(positions[i]), n_cells)].push_back(i);
+  }
+
+  std::vector<int> neighbors;
+  for (int i = 0; i < positions.size(); i++) {
+    auto const ind = cell_of(positions[i]);
+
+    /* With less than three cells in a direction, a cell
+     * can be its own neighbor or a neighbor twice. */
+    neighbors.clear();
+    for (int dx = -1; dx <= 1; dx++)
+      for (int dy = -1; dy <= 1; dy++)
+        for (int dz = -1; dz <= 1; dz++) {
+          Utils::Vector3i n_ind = ind + Utils::Vector3i{dx, dy, dz};
+          bool valid = true;
+          for (int j = 0; j < 3; j++) {
+            if (box_geo.periodic(j)) {
+              n_ind[j] = (n_ind[j] + n_cells[j]) % n_cells[j];
+            } else if (n_ind[j] < 0 or n_ind[j] >= n_cells[j]) {
+              valid = false;
+            }
+          }
+          if (valid)
+            neighbors.push_back(Utils::get_linear_index(n_ind, n_cells));
+        }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                    neighbors.end());
+
+    /* Every pair is done by its particle with the smaller index */
+    for (auto const cell : neighbors) {
+      for (auto const j : cells[cell]) {
+        if (j <= i)
+          continue;
+        auto const d = get_mi_vector(positions[i], positions[j], box_geo);
+        acc.add_pair(types[i], types[j], d.norm2());
+      }
+    }
+  }
+}
+} // namespace
+
+REGISTER_CALLBACK(mpi_reduce_rdf_histograms_slave)
+REGISTER_CALLBACK(mpi_halo_rdf_histograms_slave)
+
+std::vector<std::vector<double>> calc_rdfs(PartCfg &partCfg,
+                                           std::vector<RdfTypes> const &types,
+                                           double r_min, double r_max,
+                                           int r_bins) {
+  RdfAccumulator acc(types, r_min, r_max, r_bins);
+
+  if (cells_cover_range(r_max)) {
+    mpi_call(mpi_reduce_rdf_histograms_slave, types, r_min, r_max, r_bins);
+    return acc.normalize(reduce_rdf_histograms(types, r_min, r_max, r_bins));
+  }
+
+  bool within_half_box = true;
+  for (int i = 0; i < 3; i++) {
+    if (box_geo.periodic(i) and 2. * r_max > box_geo.length()[i])
+      within_half_box = false;
+  }
+
+  if (within_half_box) {
+    mpi_call(mpi_halo_rdf_histograms_slave, types, r_min, r_max, r_bins);
+    return acc.normalize(halo_rdf_histograms(types, r_min, r_max, r_bins));
+  }
+
+  gathered_rdf_histograms(partCfg, acc, r_max);
+  return acc.normalize(acc.buffer());
+}
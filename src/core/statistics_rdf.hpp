@@ -0,0 +1,67 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+  Copyright (C) 2002,2003,2004,2005,2006,2007,2008,2009,2010
+    Max-Planck-Institute for Polymer Research, Theory Group
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef STATISTICS_RDF_H
+#define STATISTICS_RDF_H
+/** \file
+ *
+ *  Radial distribution functions of the current configuration.
+ *
+ *  The particle pairs are found with linked cells instead of a loop
+ *  over all pairs. If the cell system covers @p r_max, i.e. @p r_max does
+ *  not exceed the interaction range, every node histograms the pairs of
+ *  its cells and the histograms are summed up on the head node.
+ *  Otherwise, if @p r_max is at most half the box, every node receives
+ *  the periodic images of the particles within @p r_max of its own ones,
+ *  sorts them into cells of size @p r_max and histograms the pairs, and
+ *  the histograms are summed up on the head node. For larger @p r_max
+ *  the particles are gathered on the head node.
+ */
+
+#include "PartCfg.hpp"
+
+#include <utility>
+#include <vector>
+
+/** Pair of type lists for which a radial distribution function is
+ *  calculated, see @ref calc_rdf.
+ */
+using RdfTypes = std::pair<std::vector<int>, std::vector<int>>;
+
+/** Calculate several radial distribution functions in one pass over the
+ *  particle pairs.
+ *
+ *  Every entry of @p types defines one radial distribution function of
+ *  the particles with the types in the first list around the particles
+ *  with the types in the second list, normalized like in @ref calc_rdf.
+ *
+ *  @param partCfg  @copybrief PartCfg
+ *  @param types    Type lists of the radial distribution functions.
+ *  @param r_min    Minimal distance for the distribution.
+ *  @param r_max    Maximal distance for the distribution.
+ *  @param r_bins   Number of bins.
+ *  @return One histogram of size @p r_bins for every entry of @p types.
+ */
+std::vector<std::vector<double>> calc_rdfs(PartCfg &partCfg,
+                                           std::vector<RdfTypes> const &types,
+                                           double r_min, double r_max,
+                                           int r_bins);
+
+#endif
@@ -0,0 +1,400 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+  Copyright (C) 2002,2003,2004,2005,2006,2007,2008,2009,2010
+    Max-Planck-Institute for Polymer Research, Theory Group
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** \file
+ *  Implementation of \ref statistics_structure_factor.hpp.
+ */
+
+#include "statistics_structure_factor.hpp"
+
+#include "cells.hpp"
+#include "communication.hpp"
+#include "event.hpp"
+#include "grid.hpp"
+
+#if defined(P3M) || defined(DP3M)
+#include "electrostatics_magnetostatics/fft.hpp"
+#include "electrostatics_magnetostatics/p3m-common.hpp"
+#endif
+
+#include <utils/constants.hpp>
+#include <utils/math/sinc.hpp>
+#include <utils/math/sqr.hpp>
+
+#include <boost/mpi/collectives/all_to_all.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+/** The weight of a particle is the number of times its type appears in
+ *  @p p_types.
+ */
+std::vector<double> type_weights(std::vector<int> const &p_types) {
+  std::vector<double> w;
+  for (auto const type : p_types) {
+    if (type < 0)
+      continue;
+    if (type >= w.size())
+      w.resize(type + 1, 0.);
+    w[type] += 1.;
+  }
+  return w;
+}
+
+double weight(std::vector<double> const &w, int type) {
+  return (type >= 0 and type < w.size()) ? w[type] : 0.;
+}
+
+/** Call @p f for every wave vector (i, j, k) with 1 <= n^2 <= order^2
+ *  and i >= 0, with n^2 = i^2 + j^2 + k^2.
+ */
+template <class F> void for_each_wave_vector(int order, F f) {
+  auto const order2 = order * order;
+  for (int i = 0; i <= order; i++) {
+    for (int j = -order; j <= order; j++) {
+      for (int k = -order; k <= order; k++) {
+        auto const n2 = i * i + j * j + k * k;
+        if ((n2 <= order2) && (n2 >= 1)) {
+          f(i, j, k, n2);
+        }
+      }
+    }
+  }
+}
+
+/** Sum up the buffers of all nodes on the head node. */
+std::vector<double> reduce_on_head(std::vector<double> const &local) {
+  std::vector<double> global((this_node == 0) ? local.size() : 0);
+  MPI_Reduce(local.data(), global.data(), static_cast<int>(local.size()),
+             MPI_DOUBLE, MPI_SUM, 0, comm_cart);
+  return global;
+}
+
+/** Divide the summed up shells by the number of particles and of wave
+ *  vectors.
+ */
+std::vector<double> normalize_shells(std::vector<double> ff, double n_part) {
+  if (n_part > 0.) {
+    for (size_t qi = 0; 2 * qi < ff.size(); qi++)
+      if (ff[2 * qi + 1] != 0)
+        ff[2 * qi] /= n_part * ff[2 * qi + 1];
+  }
+  return ff;
+}
+
+/** Fourier sums of the local particles. The buffer holds the cosine and
+ *  sine sums for every wave vector, followed by the sum of the weights.
+ */
+std::vector<double> local_fourier_sums(std::vector<int> const &p_types,
+                                       int order) {
+  on_observable_calc();
+
+  auto const weights = type_weights(p_types);
+  auto const twoPI_L = 2 * Utils::pi() / box_geo.length()[0];
+
+  int n_vectors = 0;
+  for_each_wave_vector(order, [&n_vectors](int, int, int, int) {
+    n_vectors++;
+  });
+  std::vector<std::complex<double>> sums(n_vectors);
+  double n_part = 0.;
+
+  /* exp(i twoPI_L n x) for n = -order...order in every direction */
+  std::vector<std::complex<double>> phases(3 * (2 * order + 1));
+  for (auto const &p : local_cells.particles()) {
+    auto const w = weight(weights, p.p.type);
+    if (w == 0.)
+      continue;
+    n_part += w;
+
+    auto const pos = unfolded_position(p.r.p, p.l.i, box_geo.length());
+    for (int d = 0; d < 3; d++) {
+      auto e = phases.begin() + d * (2 * order + 1) + order;
+      auto const e1 = std::polar(1., twoPI_L * pos[d]);
+      e[0] = 1.;
+      for (int n = 1; n <= order; n++) {
+        e[n] = e[n - 1] * e1;
+        e[-n] = std::conj(e[n]);
+      }
+    }
+
+    auto const ex = phases.begin() + order;
+    auto const ey = ex + (2 * order + 1);
+    auto const ez = ey + (2 * order + 1);
+    auto sum = sums.begin();
+    for_each_wave_vector(order, [&](int i, int j, int k, int) {
+      *sum++ += w * ex[i] * ey[j] * ez[k];
+    });
+  }
+
+  std::vector<double> buffer;
+  buffer.reserve(2 * n_vectors + 1);
+  for (auto const &s : sums) {
+    buffer.push_back(s.real());
+    buffer.push_back(s.imag());
+  }
+  buffer.push_back(n_part);
+  return buffer;
+}
+
+void mpi_structurefactor_direct_slave(std::vector<int> p_types, int order) {
+  reduce_on_head(local_fourier_sums(p_types, order));
+}
+} // namespace
+
+REGISTER_CALLBACK(mpi_structurefactor_direct_slave)
+
+std::vector<double> calc_structurefactor_direct(std::vector<int> const &p_types,
+                                                int order) {
+  if (order < 1)
+    throw std::runtime_error("order has to be a positive number");
+
+  mpi_call(mpi_structurefactor_direct_slave, p_types, order);
+  auto const sums = reduce_on_head(local_fourier_sums(p_types, order));
+
+  std::vector<double> ff(2 * order * order, 0.);
+  auto s = sums.begin();
+  for_each_wave_vector(order, [&](int, int, int, int n2) {
+    ff[2 * n2 - 2] += s[0] * s[0] + s[1] * s[1];
+    ff[2 * n2 - 1]++;
+    s += 2;
+  });
+  return normalize_shells(std::move(ff), sums.back());
+}
+
+#if defined(P3M) || defined(DP3M)
+namespace {
+/** FFT of a cubic mesh without margins, distributed like the P3M mesh. */
+struct StructureFactorMesh {
+  fft_data_struct fft;
+  /** Mesh, the local block in real space and the local FFT mesh. */
+  double *data = nullptr;
+  int ks_pnum;
+  int mesh = 0;
+  Utils::Vector3i grid;
+  /** Dimensions and first point of the local block. */
+  int dim[3];
+  int start[3];
+  int node_pos[3];
+};
+
+/** The FFT plans are only set up again if the mesh or the node grid have
+ *  changed, because planning is expensive.
+ */
+StructureFactorMesh &structure_factor_mesh(int mesh) {
+  static StructureFactorMesh m;
+  if (m.mesh != mesh or m.grid != node_grid) {
+    int mesh_dim[3] = {mesh, mesh, mesh};
+    double mesh_off[3] = {0., 0., 0.};
+    int const margin[6] = {0, 0, 0, 0, 0, 0};
+
+    MPI_Cart_coords(comm_cart, this_node, 3, m.node_pos);
+    fft_calc_local_mesh(m.node_pos, node_grid.data(), mesh_dim, mesh_off,
+                        m.dim, m.start);
+    fft_init(&m.data, m.dim, margin, mesh_dim, mesh_off, &m.ks_pnum, m.fft,
+             node_grid, comm_cart);
+    m.mesh = mesh;
+    m.grid = node_grid;
+  }
+  return m;
+}
+
+/** Assign the local particles to the mesh. Mesh points outside of the
+ *  local block are sent to the nodes they belong to.
+ *
+ *  @return Sum of the weights of the local particles.
+ */
+double assign_particles(std::vector<int> const &p_types, int cao,
+                        StructureFactorMesh &m) {
+  auto const weights = type_weights(p_types);
+  auto const mesh = m.mesh;
+  int mesh_dim[3] = {mesh, mesh, mesh};
+  double mesh_off[3] = {0., 0., 0.};
+
+  /* node grid coordinate of the owner of every mesh point */
+  std::array<std::vector<int>, 3> owner;
+  for (int d = 0; d < 3; d++) {
+    owner[d].resize(mesh);
+    for (int p = 0; p < node_grid[d]; p++) {
+      int pos[3] = {0, 0, 0};
+      int dim[3], start[3];
+      pos[d] = p;
+      fft_calc_local_mesh(pos, node_grid.data(), mesh_dim, mesh_off, dim,
+                          start);
+      for (int i = start[d]; i < start[d] + dim[d]; i++)
+        owner[d][i] = p;
+    }
+  }
+
+  std::fill(m.data, m.data + m.dim[0] * m.dim[1] * m.dim[2], 0.);
+  std::vector<std::unordered_map<int, double>> remote(n_nodes);
+
+  auto const pos_shift = std::floor((cao - 1) / 2.0) - (cao % 2) / 2.0;
+  double n_part = 0.;
+  std::vector<double> caf(3 * cao);
+  for (auto const &p : local_cells.particles()) {
+    auto const w = weight(weights, p.p.type);
+    if (w == 0.)
+      continue;
+    n_part += w;
+
+    auto const pos = folded_position(p.r.p, box_geo);
+    int first[3];
+    for (int d = 0; d < 3; d++) {
+      auto const u = pos[d] * mesh / box_geo.length()[d] - pos_shift;
+      first[d] = static_cast<int>(std::floor(u));
+      for (int i = 0; i < cao; i++)
+        caf[d * cao + i] = p3m_caf(i, (u - first[d]) - 0.5, cao);
+    }
+
+    for (int i0 = 0; i0 < cao; i0++) {
+      for (int i1 = 0; i1 < cao; i1++) {
+        for (int i2 = 0; i2 < cao; i2++) {
+          int const i[3] = {i0, i1, i2};
+          int g[3], coords[3];
+          auto value = w;
+          bool local = true;
+          for (int d = 0; d < 3; d++) {
+            g[d] = ((first[d] + i[d]) % mesh + mesh) % mesh;
+            coords[d] = owner[d][g[d]];
+            local = local and coords[d] == m.node_pos[d];
+            value *= caf[d * cao + i[d]];
+          }
+          if (local) {
+            m.data[((g[0] - m.start[0]) * m.dim[1] + (g[1] - m.start[1])) *
+                       m.dim[2] +
+                   (g[2] - m.start[2])] += value;
+          } else {
+            int rank;
+            MPI_Cart_rank(comm_cart, coords, &rank);
+            remote[rank][(g[0] * mesh + g[1]) * mesh + g[2]] += value;
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<std::vector<std::pair<int, double>>> send_buf(n_nodes),
+      recv_buf;
+  for (int i = 0; i < n_nodes; i++) {
+    send_buf[i].assign(remote[i].begin(), remote[i].end());
+  }
+  boost::mpi::all_to_all(comm_cart, send_buf, recv_buf);
+
+  for (auto const &points : recv_buf) {
+    for (auto const &point : points) {
+      auto const g2 = point.first % mesh;
+      auto const g1 = (point.first / mesh) % mesh;
+      auto const g0 = point.first / (mesh * mesh);
+      m.data[((g0 - m.start[0]) * m.dim[1] + (g1 - m.start[1])) * m.dim[2] +
+             (g2 - m.start[2])] += point.second;
+    }
+  }
+
+  return n_part;
+}
+
+/** Squared amplitudes of the local Fourier modes, binned into shells like
+ *  in @ref calc_structurefactor and followed by the sum of the weights of
+ *  the local particles.
+ */
+std::vector<double> local_mesh_shells(std::vector<int> const &p_types,
+                                      int order, int mesh, int cao) {
+  on_observable_calc();
+
+  auto &m = structure_factor_mesh(mesh);
+  auto const n_part = assign_particles(p_types, cao, m);
+  fft_perform_forw(m.data, m.fft, comm_cart);
+
+  /* mesh frequency and inverse squared assignment function of every index */
+  std::vector<int> freq(mesh);
+  std::vector<double> inv_caf2(mesh);
+  for (int i = 0; i < mesh; i++) {
+    freq[i] = (i <= mesh / 2) ? i : i - mesh;
+    inv_caf2[i] = 1. / std::pow(Utils::sinc(freq[i] / double(mesh)), 2 * cao);
+  }
+
+  /* storage direction of the x direction of the box */
+  int kx = 0;
+  while ((kx + m.ks_pnum) % 3 != 0)
+    kx++;
+
+  auto const &plan = m.fft.plan[3];
+  auto const order2 = order * order;
+  std::vector<double> shells(2 * order2 + 1, 0.);
+  int ind = 0;
+  int j[3];
+  for (j[0] = 0; j[0] < plan.new_mesh[0]; j[0]++) {
+    for (j[1] = 0; j[1] < plan.new_mesh[1]; j[1]++) {
+      for (j[2] = 0; j[2] < plan.new_mesh[2]; j[2]++) {
+        int n2 = 0;
+        double inv_w2 = 1.;
+        for (int d = 0; d < 3; d++) {
+          auto const i = j[d] + plan.start[d];
+          n2 += freq[i] * freq[i];
+          inv_w2 *= inv_caf2[i];
+        }
+        if ((n2 <= order2) && (n2 >= 1) && freq[j[kx] + plan.start[kx]] >= 0) {
+          shells[2 * n2 - 2] +=
+              (Utils::sqr(m.data[ind]) + Utils::sqr(m.data[ind + 1])) * inv_w2;
+          shells[2 * n2 - 1]++;
+        }
+        ind += 2;
+      }
+    }
+  }
+  shells.back() = n_part;
+  return shells;
+}
+
+void mpi_structurefactor_mesh_slave(std::vector<int> p_types, int order,
+                                    int mesh, int cao) {
+  reduce_on_head(local_mesh_shells(p_types, order, mesh, cao));
+}
+} // namespace
+
+REGISTER_CALLBACK(mpi_structurefactor_mesh_slave)
+
+std::vector<double> calc_structurefactor_mesh(std::vector<int> const &p_types,
+                                              int order, int mesh, int cao) {
+  if (order < 1)
+    throw std::runtime_error("order has to be a positive number");
+  if (2 * order >= mesh)
+    throw std::runtime_error("order has to be smaller than half of the mesh");
+  if (cao < 1 or cao > 7)
+    throw std::runtime_error("cao has to be between 1 and 7");
+  auto const &box_l = box_geo.length();
+  if (box_l[1] != box_l[0] or box_l[2] != box_l[0])
+    throw std::runtime_error("the mesh method requires a cubic box");
+
+  mpi_call(mpi_structurefactor_mesh_slave, p_types, order, mesh, cao);
+  auto shells = reduce_on_head(local_mesh_shells(p_types, order, mesh, cao));
+
+  auto const n_part = shells.back();
+  shells.pop_back();
+  return normalize_shells(std::move(shells), n_part);
+}
+#endif
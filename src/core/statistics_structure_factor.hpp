@@ -0,0 +1,72 @@
+/*
+  Copyright (C) 2010-2018 The ESPResSo project
+  Copyright (C) 2002,2003,2004,2005,2006,2007,2008,2009,2010
+    Max-Planck-Institute for Polymer Research, Theory Group
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef STATISTICS_STRUCTURE_FACTOR_H
+#define STATISTICS_STRUCTURE_FACTOR_H
+/** \file
+ *
+ *  Spherically averaged structure factor of the current configuration.
+ *
+ *  Both methods work on the particles of every node, and only the
+ *  Fourier sums or the mesh are communicated, the particles are never
+ *  gathered. The results have the layout of @ref calc_structurefactor.
+ *
+ *  The direct method evaluates the Fourier sums exactly. The phase factors
+ *  of a particle are calculated from one complex exponential per direction
+ *  by recurrence, so that no trigonometric functions are evaluated in the
+ *  loop over the wave vectors.
+ *
+ *  The mesh method assigns the particles to a mesh with the P3M charge
+ *  assignment functions, transforms the mesh with the parallel 3D-FFT
+ *  and bins the squared amplitudes of the mesh modes into shells. The
+ *  smoothing of the assignment is divided out, aliasing is not corrected
+ *  for. The cost is independent of @p order, which makes it the method
+ *  of choice for large numbers of wave vectors. The mesh has the same
+ *  number of points in every direction, so it is restricted to cubic
+ *  boxes.
+ */
+
+#include "config.hpp"
+
+#include <vector>
+
+/** Calculate the structure factor exactly, see @ref calc_structurefactor.
+ *
+ *  @param p_types   types of the particles to be analyzed
+ *  @param order     the maximum wave vector length in 2PI/L
+ */
+std::vector<double> calc_structurefactor_direct(std::vector<int> const &p_types,
+                                                int order);
+
+#if defined(P3M) || defined(DP3M)
+/** Calculate the structure factor from the Fourier transformed density
+ *  on a mesh, see @ref calc_structurefactor.
+ *
+ *  @param p_types   types of the particles to be analyzed
+ *  @param order     the maximum wave vector length in 2PI/L,
+ *                   has to be smaller than half of @p mesh
+ *  @param mesh      number of mesh points per direction
+ *  @param cao       charge assignment order, from 1 to 7
+ */
+std::vector<double> calc_structurefactor_mesh(std::vector<int> const &p_types,
+                                              int order, int mesh, int cao);
+#endif
+
+#endif
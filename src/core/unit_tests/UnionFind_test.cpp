@@ -0,0 +1,69 @@
+/*
+   Copyright (C) 2019 The ESPResSo project
+
+   This file is part of ESPResSo.
+
+   ESPResSo is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ESPResSo is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE ClusterAnalysis::UnionFind test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "cluster_analysis/UnionFind.hpp"
+
+#include <utility>
+#include <vector>
+
+using ClusterAnalysis::UnionFind;
+
+BOOST_AUTO_TEST_CASE(empty) {
+  UnionFind sets;
+
+  BOOST_CHECK_EQUAL(sets.size(), 0);
+  BOOST_CHECK(not sets.contains(0));
+}
+
+BOOST_AUTO_TEST_CASE(unite) {
+  UnionFind sets;
+
+  /* {1, 3, 7, 9} and {2, 5}, the links are not in order */
+  std::vector<std::pair<int, int>> const links = {
+      {9, 7}, {5, 2}, {3, 7}, {1, 9}, {9, 3}};
+  for (auto const &link : links) {
+    sets.unite(link.first, link.second);
+  }
+
+  BOOST_CHECK_EQUAL(sets.size(), 10);
+  for (auto const id : {0, 4, 6, 8}) {
+    BOOST_CHECK(not sets.contains(id));
+  }
+  for (auto const id : {1, 3, 7, 9}) {
+    BOOST_REQUIRE(sets.contains(id));
+    BOOST_CHECK_EQUAL(sets.find(id), 1);
+  }
+  for (auto const id : {2, 5}) {
+    BOOST_REQUIRE(sets.contains(id));
+    BOOST_CHECK_EQUAL(sets.find(id), 2);
+  }
+
+  /* Joining the sets gives the smaller representative */
+  sets.unite(5, 7);
+  for (auto const id : {1, 2, 3, 5, 7, 9}) {
+    BOOST_CHECK_EQUAL(sets.find(id), 1);
+  }
+
+  sets.clear();
+  BOOST_CHECK(not sets.contains(1));
+}
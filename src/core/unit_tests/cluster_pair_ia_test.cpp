@@ -0,0 +1,147 @@
+/*
+Copyright (C) 2010-2018 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#define BOOST_TEST_MODULE cluster_pair_ia test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "Cell.hpp"
+#include "algorithm/cluster_pair_ia.hpp"
+
+/* Dummy distance */
+struct Distance {
+  bool interact;
+};
+
+/* Dummy interaction criterion */
+struct VerletCriterion {
+  bool operator()(Particle const &, Particle const &,
+                  Distance const &d) const {
+    return d.interact;
+  }
+};
+
+/* Every third pair of ids interacts */
+Distance distance(Particle const &p1, Particle const &p2) {
+  return Distance{(p1.p.identity + p2.p.identity) % 3 != 0};
+}
+
+std::vector<std::pair<int, int>> expected_pairs(int n_part) {
+  std::vector<std::pair<int, int>> ret;
+  for (int i = 0; i < n_part; i++)
+    for (int j = i + 1; j < n_part; j++) {
+      if ((i + j) % 3 != 0)
+        ret.emplace_back(i, j);
+    }
+  return ret;
+}
+
+BOOST_AUTO_TEST_CASE(cluster_pair_ia) {
+  const unsigned n_cells = 20;
+  /* Not a multiple of the cluster size */
+  const auto n_part_per_cell = 10;
+  const auto n_part = n_cells * n_part_per_cell;
+
+  std::vector<Cell> cells(n_cells);
+
+  auto id = 0;
+  for (auto &c : cells) {
+    std::vector<Cell *> neighbors;
+
+    for (auto &n : cells) {
+      if (&c < &n)
+        neighbors.push_back(&n);
+    }
+
+    c.m_neighbors = Neighbors<Cell *>(neighbors, {});
+
+    c.part = new Particle[n_part_per_cell];
+    c.n = c.max = n_part_per_cell;
+
+    for (unsigned i = 0; i < n_part_per_cell; ++i) {
+      c.part[i].p.identity = id++;
+    }
+  }
+
+  for (auto const rebuild : {true, false, true, false}) {
+    std::vector<std::pair<int, int>> pairs;
+    std::vector<unsigned> id_counts(n_part, 0u);
+
+    Algorithm::cluster_pair_ia(
+        cells.begin(), cells.end(),
+        [&id_counts](Particle const &p) { id_counts[p.p.identity]++; },
+        [&pairs](Particle const &p1, Particle const &p2, Distance const &) {
+          pairs.emplace_back(std::min(p1.p.identity, p2.p.identity),
+                             std::max(p1.p.identity, p2.p.identity));
+        },
+        distance, VerletCriterion{}, rebuild);
+
+    /* Check that the particle kernel has been executed exactly once for
+     * every particle. */
+    BOOST_CHECK(std::all_of(id_counts.begin(), id_counts.end(),
+                            [](int count) { return count == 1; }));
+
+    /* Every interacting pair is visited exactly once */
+    std::sort(pairs.begin(), pairs.end());
+    BOOST_CHECK(pairs == expected_pairs(n_part));
+  }
+
+  /* Only cluster pairs with interacting particles are stored,
+   * a cluster is given by its first id and its size. */
+  using Cluster = std::pair<int, int>;
+  auto const clusters = [n_part_per_cell](int cell) {
+    std::vector<Cluster> ret;
+    for (int i = 0; i < n_part_per_cell; i += Algorithm::cluster_size) {
+      ret.emplace_back(cell * n_part_per_cell + i,
+                       std::min(Algorithm::cluster_size, n_part_per_cell - i));
+    }
+    return ret;
+  };
+  auto const interacting = [](Cluster const &c1, Cluster const &c2) {
+    for (int a = c1.first; a < c1.first + c1.second; a++)
+      for (int b = c2.first; b < c2.first + c2.second; b++) {
+        if ((a < b) and ((a + b) % 3 != 0))
+          return 1;
+      }
+    return 0;
+  };
+
+  for (int c = 0; c < n_cells; c++) {
+    auto const own = clusters(c);
+    int n_cluster_pairs = 0;
+    for (int k = 0; k < own.size(); k++) {
+      for (int l = k; l < own.size(); l++) {
+        n_cluster_pairs += interacting(own[k], own[l]);
+      }
+      for (int neighbor = c + 1; neighbor < n_cells; neighbor++) {
+        for (auto const &cluster : clusters(neighbor)) {
+          n_cluster_pairs += interacting(own[k], cluster);
+        }
+      }
+    }
+    BOOST_CHECK_EQUAL(cells[c].m_cluster_pairs.size(), n_cluster_pairs);
+  }
+
+  for (auto &c : cells) {
+    delete[] c.part;
+  }
+}
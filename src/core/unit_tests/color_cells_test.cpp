@@ -0,0 +1,132 @@
+/*
+Copyright (C) 2010-2018 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+#define BOOST_TEST_MODULE color_cells test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "Cell.hpp"
+#include "algorithm/color_cells.hpp"
+
+/* Periodic grid of n^3 cells, every cell has its 26 surrounding
+ * cells as neighbors. */
+std::vector<Cell> make_grid(int n) {
+  std::vector<Cell> cells(n * n * n);
+
+  auto index = [n](int x, int y, int z) {
+    return ((x + n) % n) + n * (((y + n) % n) + n * ((z + n) % n));
+  };
+
+  for (int x = 0; x < n; x++)
+    for (int y = 0; y < n; y++)
+      for (int z = 0; z < n; z++) {
+        std::vector<Cell *> neighbors;
+        for (int dx = -1; dx <= 1; dx++)
+          for (int dy = -1; dy <= 1; dy++)
+            for (int dz = -1; dz <= 1; dz++) {
+              if (dx or dy or dz)
+                neighbors.push_back(&cells[index(x + dx, y + dy, z + dz)]);
+            }
+        cells[index(x, y, z)].m_neighbors = Neighbors<Cell *>(neighbors, {});
+      }
+
+  return cells;
+}
+
+std::set<Cell *> footprint(Cell *c) {
+  std::set<Cell *> ret{c};
+  for (auto &n : c->neighbors().all()) {
+    ret.insert(n);
+  }
+  return ret;
+}
+
+bool conflict(Cell *a, Cell *b) {
+  auto const fa = footprint(a);
+  auto const fb = footprint(b);
+
+  return std::any_of(fa.begin(), fa.end(),
+                     [&fb](Cell *c) { return fb.count(c) != 0; });
+}
+
+void check_groups(std::vector<Cell *> const &cells,
+                  std::vector<std::vector<Cell *>> const &groups) {
+  /* Every cell is in exactly one group */
+  std::multiset<Cell *> grouped;
+  for (auto const &g : groups) {
+    grouped.insert(g.begin(), g.end());
+  }
+  BOOST_CHECK_EQUAL(grouped.size(), cells.size());
+  for (auto const &c : cells) {
+    BOOST_CHECK_EQUAL(grouped.count(c), 1);
+  }
+
+  /* Cells in a group do not conflict */
+  for (auto const &g : groups) {
+    BOOST_CHECK(not g.empty());
+    for (auto it = g.begin(); it != g.end(); ++it)
+      for (auto jt = std::next(it); jt != g.end(); ++jt) {
+        BOOST_CHECK(not conflict(*it, *jt));
+      }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(greedy) {
+  auto cells = make_grid(6);
+  std::vector<Cell *> cell_ptrs;
+  for (auto &c : cells)
+    cell_ptrs.push_back(&c);
+
+  auto const groups =
+      Algorithm::color_cells(cell_ptrs.begin(), cell_ptrs.end(), false);
+
+  check_groups(cell_ptrs, groups);
+  /* Cells at a distance of 3 do not conflict, so 27 colors suffice. */
+  BOOST_CHECK_EQUAL(groups.size(), 27);
+}
+
+BOOST_AUTO_TEST_CASE(keep_order) {
+  auto cells = make_grid(6);
+  std::vector<Cell *> cell_ptrs;
+  for (auto &c : cells)
+    cell_ptrs.push_back(&c);
+
+  auto const groups =
+      Algorithm::color_cells(cell_ptrs.begin(), cell_ptrs.end(), true);
+
+  check_groups(cell_ptrs, groups);
+
+  std::map<Cell *, int> group_of;
+  for (int i = 0; i < groups.size(); i++) {
+    for (auto const &c : groups[i])
+      group_of[c] = i;
+  }
+
+  /* Conflicting cells are processed in the order of the range */
+  for (auto it = cell_ptrs.begin(); it != cell_ptrs.end(); ++it)
+    for (auto jt = std::next(it); jt != cell_ptrs.end(); ++jt) {
+      if (conflict(*it, *jt)) {
+        BOOST_CHECK(group_of[*it] < group_of[*jt]);
+      }
+    }
+}
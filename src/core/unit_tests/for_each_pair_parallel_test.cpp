@@ -0,0 +1,153 @@
+/*
+Copyright (C) 2010-2018 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <vector>
+
+#define BOOST_TEST_MODULE for_each_pair_parallel test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <boost/iterator/indirect_iterator.hpp>
+
+#include "Cell.hpp"
+#include "algorithm/color_cells.hpp"
+#include "algorithm/for_each_pair_parallel.hpp"
+
+/* Ring of cells, the red neighbor of a cell is the next one,
+ * the black neighbor the previous one. */
+struct Ring {
+  static constexpr int n_cells = 30;
+  static constexpr int n_part_per_cell = 7;
+
+  std::vector<Cell> cells;
+  std::vector<Cell *> cell_ptrs;
+
+  Ring() : cells(n_cells) {
+    auto id = 0;
+    for (int i = 0; i < n_cells; i++) {
+      auto &c = cells[i];
+      Cell *red[] = {&cells[(i + 1) % n_cells]};
+      Cell *black[] = {&cells[(i + n_cells - 1) % n_cells]};
+      c.m_neighbors = Neighbors<Cell *>(red, black);
+
+      c.part = new Particle[n_part_per_cell];
+      c.n = c.max = n_part_per_cell;
+      for (int j = 0; j < n_part_per_cell; ++j) {
+        c.part[j].p.identity = id++;
+      }
+
+      cell_ptrs.push_back(&c);
+    }
+  }
+
+  ~Ring() {
+    for (auto &c : cells) {
+      delete[] c.part;
+    }
+  }
+
+  std::vector<Utils::Vector3d> forces() const {
+    std::vector<Utils::Vector3d> ret;
+    for (auto const &c : cells)
+      for (int j = 0; j < c.n; j++)
+        ret.push_back(c.part[j].f.f);
+    return ret;
+  }
+};
+
+/* Order dependent floating point updates */
+struct ParticleKernel {
+  void operator()(Particle &p) const { p.f.f[1] += 1.; }
+};
+
+struct PairKernel {
+  void operator()(Particle &p1, Particle &p2, double d) const {
+    p1.f.f[0] += d;
+    p2.f.f[0] -= 0.5 * d;
+    p1.f.f[2] = 3. * p1.f.f[2] + d;
+    p2.f.f[2] = 3. * p2.f.f[2] + d;
+  }
+};
+
+struct DistanceFunction {
+  double operator()(Particle const &p1, Particle const &p2) const {
+    return 1. / (1. + p1.p.identity) + 1. / (7. + p2.p.identity);
+  }
+};
+
+struct VerletCriterion {
+  bool operator()(Particle const &, Particle const &, double) const {
+    return true;
+  }
+};
+
+void check_equal(std::vector<Utils::Vector3d> const &a,
+                 std::vector<Utils::Vector3d> const &b) {
+  BOOST_REQUIRE_EQUAL(a.size(), b.size());
+  for (int i = 0; i < a.size(); i++) {
+    for (int j = 0; j < 3; j++) {
+      BOOST_CHECK_EQUAL(a[i][j], b[i][j]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(bit_identical_to_serial) {
+  Ring serial, parallel;
+
+  for (auto const use_verlet_list : {false, true}) {
+    for (auto const rebuild : {true, false}) {
+      Algorithm::for_each_pair(
+          boost::make_indirect_iterator(serial.cell_ptrs.begin()),
+          boost::make_indirect_iterator(serial.cell_ptrs.end()),
+          ParticleKernel{}, PairKernel{}, DistanceFunction{},
+          VerletCriterion{}, use_verlet_list, rebuild);
+
+      auto const groups = Algorithm::color_cells(
+          parallel.cell_ptrs.begin(), parallel.cell_ptrs.end(), true);
+      Algorithm::for_each_pair_parallel(groups, ParticleKernel{}, PairKernel{},
+                                        DistanceFunction{}, VerletCriterion{},
+                                        use_verlet_list, rebuild);
+
+      check_equal(serial.forces(), parallel.forces());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(all_pairs) {
+  Ring ring;
+
+  auto const groups = Algorithm::color_cells(ring.cell_ptrs.begin(),
+                                             ring.cell_ptrs.end(), false);
+  /* The number of cells is a multiple of three, so three colors suffice */
+  BOOST_CHECK_EQUAL(groups.size(), 3);
+
+  Algorithm::for_each_pair_parallel(
+      groups, [](Particle &p) { p.f.f[1] += 1.; },
+      [](Particle &p1, Particle &p2, double) {
+        p1.f.f[0] += 1.;
+        p2.f.f[0] += 1.;
+      },
+      DistanceFunction{}, VerletCriterion{}, false, false);
+
+  /* Every particle interacts with all particles in its own cell and
+   * the two adjacent cells, and the particle kernel runs once. */
+  for (auto const &f : ring.forces()) {
+    BOOST_CHECK_EQUAL(f[0], 3 * Ring::n_part_per_cell - 1);
+    BOOST_CHECK_EQUAL(f[1], 1.);
+  }
+}
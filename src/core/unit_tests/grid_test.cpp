@@ -190,4 +190,39 @@ BOOST_AUTO_TEST_CASE(regular_decomposition_test) {
           BOOST_CHECK_CLOSE(lower_corner[2], local_box_l[2] * node_pos[2], eps);
         }
   }
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(rectilinear_decomposition_test) {
+  auto const eps = std::numeric_limits<double>::epsilon();
+
+  auto const box_l = Utils::Vector3d{10, 20, 30};
+  auto box = BoxGeometry();
+  box.set_length(box_l);
+  auto const node_grid = Utils::Vector3i{1, 2, 3};
+  std::array<std::vector<double>, 3> const cuts{
+      {{}, {}, {0., 0.1, 0.6, 1.}}};
+
+  Utils::Vector3i node_pos;
+  for (node_pos[0] = 0; node_pos[0] < node_grid[0]; node_pos[0]++)
+    for (node_pos[1] = 0; node_pos[1] < node_grid[1]; node_pos[1]++)
+      for (node_pos[2] = 0; node_pos[2] < node_grid[2]; node_pos[2]++) {
+        auto const regular = regular_decomposition(box, node_pos, node_grid);
+        auto const result =
+            rectilinear_decomposition(box, node_pos, node_grid, cuts);
+
+        /* Same as the regular decomposition without cuts */
+        for (int i = 0; i < 2; i++) {
+          BOOST_CHECK_EQUAL(result.my_left()[i], regular.my_left()[i]);
+          BOOST_CHECK_EQUAL(result.length()[i], regular.length()[i]);
+        }
+        for (int i = 0; i < 6; i++) {
+          BOOST_CHECK_EQUAL(result.boundary()[i], regular.boundary()[i]);
+        }
+
+        auto const &z_cuts = cuts[2];
+        BOOST_CHECK_CLOSE(result.my_left()[2], z_cuts[node_pos[2]] * box_l[2],
+                          eps);
+        BOOST_CHECK_CLOSE(result.my_right()[2],
+                          z_cuts[node_pos[2] + 1] * box_l[2], 10 * eps);
+      }
+}
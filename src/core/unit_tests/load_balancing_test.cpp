@@ -0,0 +1,91 @@
+/*
+Copyright (C) 2010-2018 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <vector>
+
+#define BOOST_TEST_MODULE load_balancing test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "load_balancing.hpp"
+
+using LoadBalancing::balanced_cuts;
+
+BOOST_AUTO_TEST_CASE(even_load) {
+  std::vector<double> const cuts{0., 0.25, 0.5, 0.75, 1.};
+
+  /* Balanced load, nothing to do */
+  BOOST_CHECK(balanced_cuts(cuts, {1., 1., 1., 1.}, 0.1, 1.) == cuts);
+  /* No load */
+  BOOST_CHECK(balanced_cuts(cuts, {0., 0., 0., 0.}, 0.1, 1.) == cuts);
+  /* Slabs cannot be wide enough */
+  BOOST_CHECK(balanced_cuts(cuts, {1., 0., 0., 0.}, 0.3, 1.) == cuts);
+}
+
+BOOST_AUTO_TEST_CASE(uneven_load) {
+  std::vector<double> const cuts{0., 0.25, 0.5, 0.75, 1.};
+  auto const eps = 1e-12;
+
+  /* All the load is in the first slab */
+  {
+    auto const result = balanced_cuts(cuts, {4., 0., 0., 0.}, 0., 1.);
+    BOOST_REQUIRE_EQUAL(result.size(), cuts.size());
+    BOOST_CHECK_EQUAL(result.front(), 0.);
+    BOOST_CHECK_CLOSE(result[1], 0.0625, eps);
+    BOOST_CHECK_CLOSE(result[2], 0.125, eps);
+    BOOST_CHECK_CLOSE(result[3], 0.1875, eps);
+    BOOST_CHECK_EQUAL(result.back(), 1.);
+  }
+
+  /* Half way with relaxation */
+  {
+    auto const result = balanced_cuts(cuts, {4., 0., 0., 0.}, 0., 0.5);
+    BOOST_CHECK_CLOSE(result[1], 0.5 * (0.25 + 0.0625), eps);
+    BOOST_CHECK_CLOSE(result[2], 0.5 * (0.5 + 0.125), eps);
+    BOOST_CHECK_CLOSE(result[3], 0.5 * (0.75 + 0.1875), eps);
+  }
+
+  /* Minimal width */
+  {
+    auto const result = balanced_cuts(cuts, {4., 0., 0., 0.}, 0.1, 1.);
+    BOOST_CHECK_CLOSE(result[1], 0.1, eps);
+    BOOST_CHECK_CLOSE(result[2], 0.2, eps);
+    BOOST_CHECK_CLOSE(result[3], 0.3, eps);
+  }
+
+  /* Load in two slabs */
+  {
+    auto const result = balanced_cuts({0., 0.5, 1.}, {3., 1.}, 0., 1.);
+    BOOST_CHECK_CLOSE(result[1], 1. / 3., eps);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ordered) {
+  std::vector<double> const cuts{0., 0.1, 0.2, 0.6, 0.9, 1.};
+  std::vector<double> const loads{0., 5., 1., 0., 7.};
+
+  for (auto const min_width : {0., 0.05, 0.2}) {
+    auto const result = balanced_cuts(cuts, loads, min_width, 0.7);
+    BOOST_REQUIRE_EQUAL(result.size(), cuts.size());
+    BOOST_CHECK_EQUAL(result.front(), 0.);
+    BOOST_CHECK_EQUAL(result.back(), 1.);
+    for (int i = 1; i < result.size(); i++) {
+      BOOST_CHECK_GE(result[i] - result[i - 1], min_width - 1e-12);
+    }
+  }
+}
@@ -0,0 +1,173 @@
+/*
+Copyright (C) 2010-2018 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cmath>
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_MODULE nonbonded_soa test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "config.hpp"
+#include "nonbonded_interactions/lj.hpp"
+#include "nonbonded_interactions/nonbonded_soa.hpp"
+#include "nonbonded_interactions/wca.hpp"
+
+#include <utils/constants.hpp>
+
+#if defined(LENNARD_JONES) && defined(WCA)
+constexpr int n_types = 2;
+
+/* Parameters of the type pair i, j */
+IA_parameters ia_parameters(int i, int j) {
+  IA_parameters ia;
+  ia.lj.eps = 1. + i + j;
+  ia.lj.sig = 0.9;
+  ia.lj.cut = 2.5;
+  ia.lj.offset = 0.1 * (i + j);
+  ia.lj.min = 0.05;
+  if (i == j) {
+    ia.wca.eps = 0.5;
+    ia.wca.sig = 1.1;
+    ia.wca.cut = 1.1 * std::pow(2., 1. / 6.);
+  }
+  return ia;
+}
+
+/* Particles at random positions in [0, 3)^3 */
+struct Particles {
+  ParticleList pl;
+
+  Particles(int n, std::mt19937 &gen) {
+    std::uniform_real_distribution<double> pos(0., 3.);
+    std::uniform_real_distribution<double> charge(-1., 1.);
+
+    pl.part = new Particle[n];
+    pl.n = pl.max = n;
+    for (int i = 0; i < n; i++) {
+      auto &p = pl.part[i];
+      p.r.p = {pos(gen), pos(gen), pos(gen)};
+      p.p.type = i % n_types;
+#ifdef ELECTROSTATICS
+      p.p.q = charge(gen);
+#endif
+    }
+  }
+
+  ~Particles() { delete[] pl.part; }
+};
+
+/* Reference force on p1 by p2 from the scalar kernels */
+Utils::Vector3d reference_force(Particle const &p1, Particle const &p2,
+                                SoA::CoulombParameters const &c) {
+  auto const ia = ia_parameters(p1.p.type, p2.p.type);
+  auto const d = p1.r.p - p2.r.p;
+  auto const dist = d.norm();
+
+  auto fac = lj_pair_force_factor(ia, dist) + wca_pair_force_factor(ia, dist);
+#ifdef ELECTROSTATICS
+  if (dist < c.r_cut) {
+    auto const adist = c.alpha * dist;
+    fac += c.prefactor * p1.p.q * p2.p.q *
+           (std::erfc(adist) / dist +
+            2. * c.alpha * Utils::sqrt_pi_i() * std::exp(-adist * adist)) /
+           (dist * dist);
+  }
+#endif
+
+  return fac * d;
+}
+
+BOOST_AUTO_TEST_CASE(scalar_reference) {
+  std::mt19937 gen(42);
+  Particles a(37, gen), b(21, gen);
+
+  SoA::PairParameterTable params(n_types);
+  for (int i = 0; i < n_types; i++)
+    for (int j = 0; j < n_types; j++) {
+      params(i, j) = SoA::PairParameters(ia_parameters(i, j));
+    }
+
+  SoA::CoulombParameters coulomb;
+  coulomb.prefactor = 2.;
+  coulomb.alpha = 1.3;
+  coulomb.r_cut = 2.;
+
+  ParticleSoA soa_a, soa_b;
+  soa_a.update(a.pl);
+  soa_b.update(b.pl);
+
+  SoA::add_pair_forces(soa_a, params, coulomb);
+  SoA::add_pair_forces(soa_a, soa_b, params, coulomb);
+
+  std::vector<Utils::Vector3d> f_a(a.pl.n), f_b(b.pl.n);
+  for (int i = 0; i < a.pl.n; i++) {
+    for (int j = i + 1; j < a.pl.n; j++) {
+      auto const f = reference_force(a.pl.part[i], a.pl.part[j], coulomb);
+      f_a[i] += f;
+      f_a[j] -= f;
+    }
+    for (int j = 0; j < b.pl.n; j++) {
+      auto const f = reference_force(a.pl.part[i], b.pl.part[j], coulomb);
+      f_a[i] += f;
+      f_b[j] -= f;
+    }
+  }
+
+  /* The erfc approximation has a relative error of about 1e-6 */
+  auto const check = [](Utils::Vector3d const &f, double fx, double fy,
+                        double fz) {
+    auto const tol = 1e-5 * (1. + f.norm());
+    BOOST_CHECK_SMALL(f[0] - fx, tol);
+    BOOST_CHECK_SMALL(f[1] - fy, tol);
+    BOOST_CHECK_SMALL(f[2] - fz, tol);
+  };
+
+  for (int i = 0; i < a.pl.n; i++) {
+    check(f_a[i], soa_a.fx[i], soa_a.fy[i], soa_a.fz[i]);
+  }
+  for (int j = 0; j < b.pl.n; j++) {
+    check(f_b[j], soa_b.fx[j], soa_b.fy[j], soa_b.fz[j]);
+  }
+
+  /* Writing back adds to the particle forces */
+  soa_b.add_forces(b.pl);
+  soa_b.add_forces(b.pl);
+  for (int j = 0; j < b.pl.n; j++) {
+    BOOST_CHECK_EQUAL(b.pl.part[j].f.f[0], 2. * soa_b.fx[j]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(update_resets_forces) {
+  std::mt19937 gen(7);
+  Particles a(5, gen);
+
+  ParticleSoA soa;
+  soa.update(a.pl);
+  soa.fx[3] = 1.;
+  soa.update(a.pl);
+
+  BOOST_CHECK_EQUAL(soa.size(), 5);
+  BOOST_CHECK_EQUAL(soa.fx[3], 0.);
+  BOOST_CHECK_EQUAL(soa.x[4], a.pl.part[4].r.p[0]);
+  BOOST_CHECK_EQUAL(soa.type[4], a.pl.part[4].p.type);
+}
+#else
+BOOST_AUTO_TEST_CASE(dummy) {}
+#endif
@@ -0,0 +1,77 @@
+/*
+Copyright (C) 2010-2018 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#define BOOST_TEST_MODULE space_filling_curve test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "algorithm/space_filling_curve.hpp"
+
+using Algorithm::hilbert_index;
+using Algorithm::morton_index;
+using Point = Utils::Vector<uint32_t, 3>;
+
+/* All points of the cube of edge length n at the origin,
+ * ordered by their index on the curve. */
+template <typename Index>
+std::vector<Point> curve_order(uint32_t n, Index &&index) {
+  std::vector<Point> ret(n * n * n, Point{n, n, n});
+  for (uint32_t x = 0; x < n; x++)
+    for (uint32_t y = 0; y < n; y++)
+      for (uint32_t z = 0; z < n; z++) {
+        Point const pos{x, y, z};
+        auto const i = index(pos);
+        BOOST_REQUIRE(i < ret.size());
+        /* Every index is taken only once */
+        BOOST_CHECK(ret[i] == (Point{n, n, n}));
+        ret[i] = pos;
+      }
+  return ret;
+}
+
+BOOST_AUTO_TEST_CASE(morton) {
+  BOOST_CHECK_EQUAL(morton_index({0, 0, 0}), 0);
+  BOOST_CHECK_EQUAL(morton_index({1, 0, 0}), 1);
+  BOOST_CHECK_EQUAL(morton_index({0, 1, 0}), 2);
+  BOOST_CHECK_EQUAL(morton_index({0, 0, 1}), 4);
+  BOOST_CHECK_EQUAL(morton_index({3, 5, 6}), 0b110101011);
+  BOOST_CHECK_EQUAL(morton_index({1023, 1023, 1023}), (1u << 30) - 1);
+
+  curve_order(8, [](Point const &p) { return morton_index(p); });
+}
+
+BOOST_AUTO_TEST_CASE(hilbert) {
+  BOOST_CHECK_EQUAL(hilbert_index({0, 0, 0}), 0);
+
+  auto const points =
+      curve_order(8, [](Point const &p) { return hilbert_index(p); });
+
+  /* Consecutive points are neighbors on the grid */
+  for (int i = 1; i < points.size(); i++) {
+    auto const &a = points[i - 1];
+    auto const &b = points[i];
+    int dist = 0;
+    for (int d = 0; d < 3; d++)
+      dist += std::abs(static_cast<int>(a[d]) - static_cast<int>(b[d]));
+    BOOST_CHECK_EQUAL(dist, 1);
+  }
+}
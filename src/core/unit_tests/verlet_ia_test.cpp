@@ -151,3 +151,73 @@ BOOST_AUTO_TEST_CASE(verlet_ia) {
     delete[] c.part;
   }
 }
+
+BOOST_AUTO_TEST_CASE(rebuild_single_cell) {
+  const unsigned n_cells = 10;
+  const auto n_part_per_cell = 5;
+
+  std::vector<Cell> cells(n_cells);
+
+  auto id = 0;
+  for (auto &c : cells) {
+    std::vector<Cell *> neighbors;
+
+    for (auto &n : cells) {
+      if (&c < &n)
+        neighbors.push_back(&n);
+    }
+
+    c.m_neighbors = Neighbors<Cell *>(neighbors, {});
+
+    c.part = new Particle[n_part_per_cell];
+    c.n = c.max = n_part_per_cell;
+
+    for (unsigned i = 0; i < n_part_per_cell; ++i) {
+      c.part[i].p.identity = id++;
+    }
+  }
+
+  std::vector<std::pair<int, int>> pairs;
+  auto const run = [&](bool interact, bool rebuild) {
+    pairs.clear();
+    Algorithm::verlet_ia(
+        cells.begin(), cells.end(), [](Particle const &) {},
+        [&pairs](Particle const &p1, Particle const &p2, Distance const &) {
+          pairs.emplace_back(p1.p.identity, p2.p.identity);
+        },
+        [interact](Particle const &, Particle const &) {
+          return Distance{interact};
+        },
+        VerletCriterion{}, rebuild);
+  };
+
+  /* Build empty lists */
+  run(false, true);
+  BOOST_CHECK(pairs.empty());
+
+  /* Only the flagged cell finds its pairs, which are all pairs
+   * with a particle of this cell as first partner. */
+  auto const flagged = 6;
+  cells[flagged].m_rebuild_verlet_list = true;
+  run(true, false);
+  BOOST_CHECK(not cells[flagged].m_rebuild_verlet_list);
+
+  auto const first_id = flagged * n_part_per_cell;
+  auto const n_local = n_part_per_cell * (n_part_per_cell - 1) / 2;
+  auto const n_neighbor =
+      n_part_per_cell * n_part_per_cell * (n_cells - flagged - 1);
+  BOOST_CHECK_EQUAL(pairs.size(), n_local + n_neighbor);
+  BOOST_CHECK(std::all_of(pairs.begin(), pairs.end(), [=](auto const &pair) {
+    return (pair.first >= first_id) and
+           (pair.first < first_id + n_part_per_cell);
+  }));
+
+  /* The other lists are kept until the next rebuild */
+  auto const n_pairs = pairs.size();
+  run(false, false);
+  BOOST_CHECK_EQUAL(pairs.size(), n_pairs);
+
+  for (auto &c : cells) {
+    delete[] c.part;
+  }
+}
@@ -19,12 +19,15 @@
 
 # For C-extern Analysis
 
+include "myconfig.pxi"
+
 cimport numpy as np
 from espressomd.utils cimport *
 from .utils cimport Vector9d
 from libcpp.string cimport string  # import std::string as string
 from libcpp.vector cimport vector  # import std::vector as vector
 from libcpp.map cimport map  # import std::map as map
+from libcpp.pair cimport pair
 
 cdef extern from "<array>" namespace "std" nogil:
     cdef cppclass array4 "std::array<double, 4>":
@@ -110,6 +113,16 @@ cdef extern from "statistics_chain.hpp":
     array4 calc_rg(PartCfg & ) except +
     array2 calc_rh(PartCfg & )
 
+cdef extern from "statistics_rdf.hpp":
+    vector[vector[double]] calc_rdfs(
+        PartCfg & , vector[pair[vector[int], vector[int]]] types,
+        double r_min, double r_max, int r_bins)
+
+cdef extern from "statistics_structure_factor.hpp":
+    vector[double] calc_structurefactor_direct(vector[int] p_types, int order) except +
+    IF P3M == 1 or DP3M == 1:
+        vector[double] calc_structurefactor_mesh(vector[int] p_types, int order, int mesh, int cao) except +
+
 cdef extern from "pressure.hpp":
     cdef Observable_stat total_pressure
     cdef Observable_stat_non_bonded total_pressure_non_bonded
@@ -123,6 +136,7 @@ cdef extern from "energy.hpp":
     cdef void master_energy_calc()
     cdef void init_energies(Observable_stat * stat)
     double calculate_current_potential_energy_of_system()
+    double calculate_energy_of_particles(const vector[int] & ids)
 
 cdef extern from "dpd.hpp":
     Vector9d dpd_stress()
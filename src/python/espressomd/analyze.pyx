@@ -722,6 +722,35 @@ class Analysis:
 
         return e
 
+    def energy_of_particles(self, ids):
+        """Calculate the potential energy of the interactions that involve
+        the given particles.
+
+        This covers the pair and bonded interactions with at least one of the
+        particles in ``ids`` and their constraint energies. Long-range
+        energies are always included for the whole system. The difference
+        of two calls before and after a change of these particles is the
+        change of the total potential energy. Particles in ``ids`` that do
+        not exist are ignored.
+
+        Parameters
+        ----------
+        ids : array_like of :obj:`int`
+            Ids of the particles.
+
+        Returns
+        -------
+        :obj:`float`
+            The potential energy.
+
+        """
+        cdef vector[int] c_ids
+        for id in ids:
+            if not is_valid_type(id, int):
+                raise ValueError("Particle ids have to be integers")
+            c_ids.push_back(id)
+        return analyze.calculate_energy_of_particles(c_ids)
+
     def calc_re(self, chain_start=None, number_of_chains=None,
                 chain_length=None):
         """
@@ -843,13 +872,17 @@ class Analysis:
     # Structure factor
     #
 
-    def structure_factor(self, sf_types=None, sf_order=None):
+    def structure_factor(self, sf_types=None, sf_order=None, method="direct",
+                         mesh=None, cao=5):
         """
         Calculate the structure factor for given types.  Returns the
         spherically averaged structure factor of particles specified in
         `types`.  The structure factor is calculated for all possible wave
-        vectors q up to `order` Do not choose parameter `order` too large
-        because the number of calculations grows as `order` to the third power.
+        vectors q up to `order`. With ``method="direct"``, the Fourier sums
+        are evaluated exactly and the cost grows as `order` to the third
+        power. With ``method="fft"``, the particles are assigned to a mesh
+        which is Fourier transformed, and the cost does not depend on
+        `order`.
 
         Parameters
         ----------
@@ -858,6 +891,17 @@ class Analysis:
             should be considered.
         sf_order : :obj:`int`
             Specifies the maximum wavevector.
+        method : :obj:`str`
+            How the Fourier sums are calculated, ``'direct'`` or ``'fft'``.
+            ``'fft'`` requires the feature ``P3M`` or ``DP3M`` and a
+            cubic box.
+        mesh : :obj:`int`, optional
+            Number of mesh points per direction for ``method="fft"``, has to
+            be larger than ``2 * sf_order``. Defaults to the smallest power
+            of two larger than ``4 * sf_order``.
+        cao : :obj:`int`
+            Charge assignment order of the mesh for ``method="fft"``,
+            from 1 to 7.
 
         Returns
         -------
@@ -872,10 +916,24 @@ class Analysis:
         check_type_or_throw_except(
             sf_order, 1, int, "sf_order has to be an int!")
 
-        p_types = create_int_list_from_python_object(sf_types)
-
-        sf = analyze.calc_structurefactor(analyze.partCfg(), p_types.e,
-                                          p_types.n, sf_order)
+        cdef vector[double] sf
+        if method == "direct":
+            sf = analyze.calc_structurefactor_direct(sf_types, sf_order)
+        elif method == "fft":
+            IF P3M == 1 or DP3M == 1:
+                if mesh is None:
+                    mesh = 2**int(np.ceil(np.log2(4 * sf_order + 1)))
+                check_type_or_throw_except(
+                    mesh, 1, int, "mesh has to be an int!")
+                check_type_or_throw_except(
+                    cao, 1, int, "cao has to be an int!")
+                sf = analyze.calc_structurefactor_mesh(
+                    sf_types, sf_order, mesh, cao)
+            ELSE:
+                raise Exception(
+                    "method 'fft' requires the feature P3M or DP3M")
+        else:
+            raise ValueError("method has to be 'direct' or 'fft'")
 
         return np.transpose(analyze.modify_stucturefactor(sf_order, sf.data()))
 
@@ -962,6 +1020,63 @@ class Analysis:
 
         return np.array([r, rdf])
 
+    def rdf_matrix(self, types=None, r_min=0.0, r_max=None, r_bins=100):
+        """
+        Calculate the radial distribution functions between all pairs of
+        the given particle types in one pass over the particle pairs.
+        Every function is normalized like the ones from :meth:`rdf`.
+
+        Parameters
+        ----------
+        types : list of :obj:`int`
+            :attr:`~espressomd.particle_data.ParticleHandle.type` of the
+            particles.
+        r_min : :obj:`float`
+            Minimal distance to consider.
+        r_max : :obj:`float`
+            Maximal distance to consider
+        r_bins : :obj:`int`
+            Number of bins.
+
+        Returns
+        -------
+        :obj:`tuple`
+            The midpoints of the bins, and an array of shape
+            ``(len(types), len(types), r_bins)`` where ``[i, j]`` is the
+            rdf of the particles of type ``types[i]`` around the particles
+            of type ``types[j]``.
+
+        """
+
+        if (types is None) or (not hasattr(types, '__iter__')):
+            raise ValueError("types has to be a list!")
+        if r_max is None:
+            r_max = min_box_l / 2.0
+
+        cdef vector[pair[vector[int], vector[int]]] type_pairs
+        cdef pair[vector[int], vector[int]] type_pair
+        for i, type_i in enumerate(types):
+            for type_j in types[i:]:
+                type_pair.first = [type_i]
+                type_pair.second = [type_j]
+                type_pairs.push_back(type_pair)
+
+        rdfs = analyze.calc_rdfs(analyze.partCfg(), type_pairs,
+                                 r_min, r_max, r_bins)
+
+        n_types = len(types)
+        g = np.empty((n_types, n_types, r_bins))
+        k = 0
+        for i in range(n_types):
+            for j in range(i, n_types):
+                g[i, j] = g[j, i] = rdfs[k]
+                k += 1
+
+        bin_width = (r_max - r_min) / r_bins
+        r = r_min + bin_width * (np.arange(r_bins) + 0.5)
+
+        return r, g
+
     #
     # distribution
     #
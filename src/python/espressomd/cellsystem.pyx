@@ -24,11 +24,41 @@ import numpy as np
 from espressomd.utils cimport handle_errors
 from espressomd.utils import is_valid_type
 
+_space_filling_curves = {"none": SFC_NONE,
+                         "morton": SFC_MORTON,
+                         "hilbert": SFC_HILBERT}
+
+
+def _space_filling_curve_name():
+    for name, curve in _space_filling_curves.items():
+        if curve == cell_structure.space_filling_curve:
+            return name
+
+
+_load_balancing_metrics = {"particles": LB_METRIC_PARTICLES,
+                           "force_time": LB_METRIC_FORCE_TIME}
+
+
+def _load_balancing_metric_name():
+    for name, metric in _load_balancing_metrics.items():
+        if metric == cell_structure.load_balancing_metric:
+            return name
+
+
 cdef class CellSystem:
     def set_domain_decomposition(self, use_verlet_lists=True,
                                  fully_connected=[False,
                                                   False,
-                                                  False]):
+                                                  False],
+                                 use_threads=False,
+                                 deterministic_threads=True,
+                                 use_soa=False,
+                                 use_cluster_pairs=False,
+                                 space_filling_curve="none",
+                                 incremental_verlet_lists=False,
+                                 overlap_ghost_comm=False,
+                                 load_balancing_interval=0,
+                                 load_balancing_metric="particles"):
         """
         Activates domain decomposition cell system.
 
@@ -37,10 +67,67 @@ cdef class CellSystem:
         use_verlet_lists : :obj:`bool`, optional
             Activates or deactivates the usage of Verlet lists
             in the algorithm.
+        use_threads : :obj:`bool`, optional
+            Distributes the short-range force and energy calculation,
+            the P3M charge assignment and force interpolation and the
+            CPU lattice-Boltzmann update over the OpenMP threads of each
+            MPI rank.
+        deterministic_threads : :obj:`bool`, optional
+            Keeps the order of the serial force calculation when using
+            threads, so that the forces are bit-identical to a run
+            without threads. The energies are then calculated without
+            threads. Disabling this allows more concurrency.
+        use_soa : :obj:`bool`, optional
+            Calculates the non-bonded forces with the vectorized
+            kernels on packed copies of the cells, if only
+            Lennard-Jones, WCA and P3M are used.
+        use_cluster_pairs : :obj:`bool`, optional
+            Stores the Verlet lists as lists of pairs of particle
+            clusters, which needs less memory. Only used together
+            with ``use_verlet_lists``.
+        space_filling_curve : :obj:`str`, optional
+            Orders the cells and the particles within the cells along
+            a space-filling curve (``"morton"`` or ``"hilbert"``) to
+            improve the memory locality, default is ``"none"``.
+        incremental_verlet_lists : :obj:`bool`, optional
+            Rebuilds only the Verlet lists of cells in which particles
+            moved more than a quarter of the skin, and resorts the
+            particles only once one of them left its cell.
+        overlap_ghost_comm : :obj:`bool`, optional
+            Calculates the short-range forces of the cells that have no
+            ghost cells as neighbors while the ghost positions are
+            communicated during the integration.
+        load_balancing_interval : :obj:`int`, optional
+            Moves the boundaries of the node domains every that many
+            integration steps such that all nodes get the same load.
+            The default of 0 keeps the regular decomposition.
+        load_balancing_metric : :obj:`str`, optional
+            Load that is balanced, either the number of particles
+            (``"particles"``, the default) or the time spent in the
+            short-range force calculation (``"force_time"``).
 
         """
 
         cell_structure.use_verlet_list = use_verlet_lists
+        cell_structure.use_threads = use_threads
+        cell_structure.deterministic_threads = deterministic_threads
+        cell_structure.use_soa = use_soa
+        cell_structure.use_cluster_pairs = use_cluster_pairs
+        if space_filling_curve not in _space_filling_curves:
+            raise ValueError("space_filling_curve has to be one of {}".format(
+                ", ".join(_space_filling_curves)))
+        cell_structure.space_filling_curve = _space_filling_curves[
+            space_filling_curve]
+        cell_structure.incremental_verlet_list = incremental_verlet_lists
+        cell_structure.overlap_ghost_comm = overlap_ghost_comm
+        if load_balancing_interval < 0:
+            raise ValueError("load_balancing_interval has to be >= 0")
+        if load_balancing_metric not in _load_balancing_metrics:
+            raise ValueError("load_balancing_metric has to be one of {}".format(
+                ", ".join(_load_balancing_metrics)))
+        cell_structure.load_balancing_interval = load_balancing_interval
+        cell_structure.load_balancing_metric = _load_balancing_metrics[
+            load_balancing_metric]
         dd.fully_connected = fully_connected
         # grid.h::node_grid
         mpi_bcast_cell_structure(CELL_STRUCTURE_DOMDEC)
@@ -113,7 +200,16 @@ cdef class CellSystem:
         return True
 
     def get_state(self):
-        s = {"use_verlet_list": cell_structure.use_verlet_list}
+        s = {"use_verlet_list": cell_structure.use_verlet_list,
+             "use_cluster_pairs": cell_structure.use_cluster_pairs,
+             "space_filling_curve": _space_filling_curve_name(),
+             "incremental_verlet_list": cell_structure.incremental_verlet_list,
+             "overlap_ghost_comm": cell_structure.overlap_ghost_comm,
+             "load_balancing_interval": cell_structure.load_balancing_interval,
+             "load_balancing_metric": _load_balancing_metric_name(),
+             "use_threads": cell_structure.use_threads,
+             "deterministic_threads": cell_structure.deterministic_threads,
+             "use_soa": cell_structure.use_soa}
 
         if cell_structure.type == CELL_STRUCTURE_LAYERED:
             s["type"] = "layered"
@@ -140,7 +236,16 @@ cdef class CellSystem:
         return s
 
     def __getstate__(self):
-        s = {"use_verlet_list": cell_structure.use_verlet_list}
+        s = {"use_verlet_list": cell_structure.use_verlet_list,
+             "use_cluster_pairs": cell_structure.use_cluster_pairs,
+             "space_filling_curve": _space_filling_curve_name(),
+             "incremental_verlet_list": cell_structure.incremental_verlet_list,
+             "overlap_ghost_comm": cell_structure.overlap_ghost_comm,
+             "load_balancing_interval": cell_structure.load_balancing_interval,
+             "load_balancing_metric": _load_balancing_metric_name(),
+             "use_threads": cell_structure.use_threads,
+             "deterministic_threads": cell_structure.deterministic_threads,
+             "use_soa": cell_structure.use_soa}
 
         if cell_structure.type == CELL_STRUCTURE_LAYERED:
             s["type"] = "layered"
@@ -168,7 +273,21 @@ cdef class CellSystem:
                         n_layers=d['n_layers'], use_verlet_lists=use_verlet_lists)
                 elif d[key] == "domain_decomposition":
                     self.set_domain_decomposition(
-                        use_verlet_lists=use_verlet_lists)
+                        use_verlet_lists=use_verlet_lists,
+                        use_threads=d.get("use_threads", False),
+                        deterministic_threads=d.get(
+                            "deterministic_threads", True),
+                        use_soa=d.get("use_soa", False),
+                        use_cluster_pairs=d.get("use_cluster_pairs", False),
+                        space_filling_curve=d.get(
+                            "space_filling_curve", "none"),
+                        incremental_verlet_lists=d.get(
+                            "incremental_verlet_list", False),
+                        overlap_ghost_comm=d.get("overlap_ghost_comm", False),
+                        load_balancing_interval=d.get(
+                            "load_balancing_interval", 0),
+                        load_balancing_metric=d.get(
+                            "load_balancing_metric", "particles"))
                 elif d[key] == "nsquare":
                     self.set_n_square(use_verlet_lists=use_verlet_lists)
         self.skin = d['skin']
@@ -89,6 +89,9 @@ class ClusterStructure(ScriptInterfaceHelper):
         """
         Runs the cluster analysis, considering all pairs of particles in the system
 
+        If the range of the pair criterion is covered by the cell system,
+        the neighbors are found in parallel with the cell system.
+
         """
         return self.call_method("run_for_all_pairs")
 
@@ -92,6 +92,7 @@ IF ELECTROSTATICS:
             void p3m_set_tune_params(double r_cut, int mesh[3], int cao, double alpha, double accuracy, int n_interpol)
             int p3m_set_mesh_offset(double x, double y, double z)
             int p3m_set_eps(double eps)
+            int p3m_set_overlap_fft_comm(bint overlap)
             int p3m_set_ninterpol(int n)
             int p3m_adaptive_tune(char ** log)
 
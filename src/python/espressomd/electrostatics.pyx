@@ -225,6 +225,9 @@ IF P3M == 1:
         check_neutrality : :obj:`bool`, optional
             Raise a warning if the system is not electrically neutral when
             set to ``True`` (default).
+        overlap_fft_comm : :obj:`bool`, optional
+            Overlap the communication of the parallel FFT with the FFTs
+            of the mesh slabs that are already complete. Defaults to False.
 
         """
 
@@ -283,7 +286,8 @@ IF P3M == 1:
 
         def valid_keys(self):
             return ["mesh", "cao", "accuracy", "epsilon", "alpha", "r_cut",
-                    "prefactor", "tune", "check_neutrality", "inter"]
+                    "prefactor", "tune", "check_neutrality", "inter",
+                    "overlap_fft_comm"]
 
         def required_keys(self):
             return ["prefactor", "accuracy"]
@@ -298,7 +302,8 @@ IF P3M == 1:
                     "epsilon": 0.0,
                     "mesh_off": [-1, -1, -1],
                     "tune": True,
-                    "check_neutrality": True}
+                    "check_neutrality": True,
+                    "overlap_fft_comm": False}
 
         def _get_params_from_es_core(self):
             params = {}
@@ -322,9 +327,12 @@ IF P3M == 1:
             # Sets ninterpol, bcast
             p3m_set_ninterpol(self._params["inter"])
             python_p3m_set_mesh_offset(self._params["mesh_off"])
+            # Sets FFT communication mode, bcast
+            p3m_set_overlap_fft_comm(self._params["overlap_fft_comm"])
 
         def _tune(self):
             set_prefactor(self._params["prefactor"])
+            p3m_set_overlap_fft_comm(self._params["overlap_fft_comm"])
             python_p3m_set_tune_params(self._params["r_cut"],
                                        self._params["mesh"],
                                        self._params["cao"],
@@ -98,10 +98,32 @@ cdef extern from "dpd.hpp":
     extern int dpd_twf
 
 
+cdef extern from "algorithm/space_filling_curve.hpp":
+    cdef enum SpaceFillingCurve "Algorithm::SpaceFillingCurve":
+        pass
+    cdef SpaceFillingCurve SFC_NONE "Algorithm::SpaceFillingCurve::NONE"
+    cdef SpaceFillingCurve SFC_MORTON "Algorithm::SpaceFillingCurve::MORTON"
+    cdef SpaceFillingCurve SFC_HILBERT "Algorithm::SpaceFillingCurve::HILBERT"
+
+cdef extern from "load_balancing.hpp":
+    cdef enum LoadBalancingMetric "LoadBalancing::Metric":
+        pass
+    cdef LoadBalancingMetric LB_METRIC_PARTICLES "LoadBalancing::Metric::PARTICLES"
+    cdef LoadBalancingMetric LB_METRIC_FORCE_TIME "LoadBalancing::Metric::FORCE_TIME"
+
 cdef extern from "cells.hpp":
     ctypedef struct CellStructure:
         int type
         bool use_verlet_list
+        bool use_cluster_pairs
+        SpaceFillingCurve space_filling_curve
+        bool incremental_verlet_list
+        bool overlap_ghost_comm
+        int load_balancing_interval
+        LoadBalancingMetric load_balancing_metric
+        bool use_threads
+        bool deterministic_threads
+        bool use_soa
 
     CellStructure cell_structure
 
@@ -34,6 +34,12 @@ IF NPT:
     cdef extern from "integrate.hpp" nogil:
         cdef int integrate_set_npt_isotropic(double ext_pressure, double piston, int xdir, int ydir, int zdir, int cubic_box)
 
+IF BOND_CONSTRAINT:
+    cdef extern from "rattle.hpp":
+        cdef enum RigidBondSolver:
+            RIGID_BOND_SHAKE, RIGID_BOND_LINCS
+        int rigid_bond_set_solver(RigidBondSolver solver, int expansion_order, int iterations)
+
 cdef inline int _integrate(int nSteps, cbool recalc_forces, int reuse_forces):
     with nogil:
         return python_integrate(nSteps, recalc_forces, reuse_forces)
@@ -56,6 +62,8 @@ cdef extern from "errorhandling.hpp" namespace "ErrorHandling":
 
 cdef extern from "integrators/steepest_descent.hpp":
     void minimize_energy_init(const double f_max, const double gamma, const int max_steps, const double max_displacement)
+cdef extern from "integrators/respa.hpp":
+    int integrate_set_respa(int long_range_steps, int short_range_steps)
 cdef extern from "communication.hpp":
     int mpi_minimize_energy()
 
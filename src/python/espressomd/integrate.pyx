@@ -33,17 +33,23 @@ cdef class Integrator:
     cdef str _method
     cdef object _steepest_descent_params
     cdef object _isotropic_npt_params
+    cdef object _respa_params
+    cdef object _rigid_bond_solver_params
 
     def __init__(self):
         self._method = "VV"
         self._steepest_descent_params = {}
         self._isotropic_npt_params = {}
+        self._respa_params = {}
+        self._rigid_bond_solver_params = {}
 
     def __getstate__(self):
         state = {}
         state['_method'] = self._method
         state['_steepest_descent_params'] = self._steepest_descent_params
         state['_isotropic_npt_params'] = self._isotropic_npt_params
+        state['_respa_params'] = self._respa_params
+        state['_rigid_bond_solver_params'] = self._rigid_bond_solver_params
         return state
 
     def __setstate__(self, state):
@@ -56,6 +62,10 @@ cdef class Integrator:
             npt_params = state['_isotropic_npt_params']
             self.set_isotropic_npt(npt_params['ext_pressure'], npt_params[
                                    'piston'], direction=npt_params['direction'], cubic_box=npt_params['cubic_box'])
+        elif self._method == "RESPA":
+            self.set_respa(**state['_respa_params'])
+        if state.get('_rigid_bond_solver_params'):
+            self.set_rigid_bond_solver(**state['_rigid_bond_solver_params'])
 
     def run(self, steps=1, recalc_forces=False, reuse_forces=False):
         """
@@ -71,7 +81,7 @@ cdef class Integrator:
             Reuse the forces from previous time step.
 
         """
-        if self._method == "VV" or self._method == "NVT" or self._method == "NPT":
+        if self._method in ("VV", "NVT", "NPT", "RESPA"):
             check_type_or_throw_except(
                 steps, 1, int, "Integrate requires a positive integer for the number of steps")
             check_type_or_throw_except(
@@ -119,6 +129,7 @@ cdef class Integrator:
 
         """
         self._method = "VV"
+        integrate_set_nvt()
 
     def set_nvt(self):
         """
@@ -163,3 +174,70 @@ cdef class Integrator:
                     "Encountered errors setting up the NPT integrator")
         ELSE:
             raise Exception("NPT not compiled in.")
+
+    def set_respa(self, long_range_steps, short_range_steps=1):
+        """
+        Set the integration method to the multiple time step Velocity
+        Verlet integrator (r-RESPA).
+
+        The long-range (k-space) forces are only calculated every
+        ``long_range_steps`` time steps and applied as an impulse. With
+        ``short_range_steps`` > 1, the non-bonded short-range forces are
+        only calculated every ``short_range_steps`` steps as well, such
+        that the bonded forces are integrated with a smaller inner step.
+
+        Parameters
+        ----------
+        long_range_steps : :obj:`int`
+            Number of time steps between two long-range force calculations.
+        short_range_steps : :obj:`int`, optional
+            Number of time steps between two non-bonded short-range force
+            calculations. ``long_range_steps`` has to be a multiple of it.
+
+        """
+        check_type_or_throw_except(
+            long_range_steps, 1, int, "RESPA parameter long_range_steps must be an int")
+        check_type_or_throw_except(
+            short_range_steps, 1, int, "RESPA parameter short_range_steps must be an int")
+        if integrate_set_respa(long_range_steps, short_range_steps):
+            handle_errors("Encountered errors setting up the RESPA integrator")
+        self._method = "RESPA"
+        self._respa_params['long_range_steps'] = long_range_steps
+        self._respa_params['short_range_steps'] = short_range_steps
+
+    def set_rigid_bond_solver(self, solver="SHAKE", expansion_order=4,
+                              iterations=1):
+        """
+        Set the algorithm that keeps the length of the rigid bonds
+        (:class:`espressomd.interactions.RigidBond`) constant.
+
+        Parameters
+        ----------
+        solver : :obj:`str`
+            ``SHAKE`` iterates until the bond tolerances are reached,
+            ``LINCS`` uses a fixed number of steps of a matrix expansion,
+            which needs no global communication.
+        expansion_order : :obj:`int`, optional
+            Order of the LINCS matrix expansion.
+        iterations : :obj:`int`, optional
+            Number of LINCS correction passes after the first projection.
+
+        """
+        IF BOND_CONSTRAINT:
+            solvers = {"SHAKE": RIGID_BOND_SHAKE, "LINCS": RIGID_BOND_LINCS}
+            if solver not in solvers:
+                raise ValueError(
+                    "solver has to be one of " + ", ".join(solvers))
+            check_type_or_throw_except(
+                expansion_order, 1, int, "expansion_order must be an int")
+            check_type_or_throw_except(
+                iterations, 1, int, "iterations must be an int")
+            if rigid_bond_set_solver(solvers[solver], expansion_order,
+                                     iterations):
+                raise ValueError(
+                    "expansion_order and iterations must not be negative")
+            self._rigid_bond_solver_params = {
+                'solver': solver, 'expansion_order': expansion_order,
+                'iterations': iterations}
+        ELSE:
+            raise Exception("BOND_CONSTRAINT not compiled in.")
@@ -59,6 +59,7 @@ cdef extern from "grid_based_algorithms/lb_interface.hpp":
     double lb_lbfluid_get_gamma_odd() except +
     void lb_lbfluid_set_gamma_even(double c_gamma_even) except +
     double lb_lbfluid_get_gamma_even() except +
+    void lb_lbfluid_set_in_place_streaming(bool in_place) except +
     void lb_lbfluid_set_ext_force_density(const Vector3d forcedensity) except +
     const Vector3d lb_lbfluid_get_ext_force_density() except +
     void lb_lbfluid_set_bulk_viscosity(double c_bulk_visc) except +
@@ -85,6 +86,9 @@ cdef extern from "grid_based_algorithms/lb_interface.hpp":
     const Vector19d lb_lbnode_get_pop(const Vector3i & ind) except +
     void lb_lbnode_set_pop(const Vector3i & ind, const Vector19d & populations) except +
     int lb_lbnode_get_boundary(const Vector3i & ind) except +
+    vector[double] lb_lbnode_get_density_slice(const Vector3i & lower, const Vector3i & upper) except +
+    vector[double] lb_lbnode_get_velocity_slice(const Vector3i & lower, const Vector3i & upper) except +
+    vector[double] lb_lbnode_get_pop_slice(const Vector3i & lower, const Vector3i & upper) except +
     stdint.uint64_t lb_lbfluid_get_rng_state() except +
     void lb_lbfluid_set_rng_state(stdint.uint64_t) except +
     void lb_lbfluid_set_kT(double) except +
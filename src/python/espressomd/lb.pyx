@@ -23,6 +23,7 @@ import itertools
 import numpy as np
 cimport numpy as np
 from libc cimport stdint
+from libc.string cimport memcpy
 from .actors cimport Actor
 from . cimport cuda_init
 from . import cuda_init
@@ -55,6 +56,8 @@ cdef class HydrodynamicInteraction(Actor):
     def __getitem__(self, key):
         if isinstance(key, (tuple, list, np.ndarray)):
             if len(key) == 3:
+                if any(isinstance(k, slice) for k in key):
+                    return LBFluidSlice(key, self.shape)
                 return LBFluidRoutines(np.array(key))
         else:
             raise Exception(
@@ -311,11 +314,31 @@ cdef class LBFluid(HydrodynamicInteraction):
     """
     Initialize the lattice-Boltzmann method for hydrodynamic flow using the CPU.
 
+    Parameters
+    ----------
+    in_place_streaming : :obj:`bool`, optional
+        Stream the populations in place in a single array, which halves
+        the memory of the fluid at the cost of a second sweep over the
+        lattice. Defaults to False.
+
     """
 
+    def valid_keys(self):
+        return super().valid_keys() + ("in_place_streaming",)
+
+    def default_params(self):
+        params = super().default_params()
+        params["in_place_streaming"] = False
+        return params
+
     def _set_lattice_switch(self):
         lb_lbfluid_set_lattice_switch(CPU)
 
+    def _set_params_in_es_core(self):
+        # has to be set before agrid, which allocates the lattice
+        lb_lbfluid_set_in_place_streaming(self._params["in_place_streaming"])
+        super()._set_params_in_es_core()
+
     def _activate_method(self):
         self.validate_params()
         self._set_lattice_switch()
@@ -462,3 +485,83 @@ cdef class LBFluidRoutines:
 
         def __set__(self, value):
             raise NotImplementedError
+
+
+cdef _slice_to_array(vector[double] & values, shape):
+    cdef np.ndarray array = np.empty(shape)
+    if values.size() > 0:
+        memcpy(np.PyArray_DATA(array), values.data(),
+               values.size() * sizeof(double))
+    return array
+
+
+cdef class LBFluidSlice:
+    """
+    Properties of a box of lattice nodes, e.g. ``lbf[:, 2:5, 0]``.
+
+    The values of all nodes are fetched in a single collective call and
+    returned as arrays with one axis per sliced dimension, followed by the
+    components of the property.
+
+    """
+    cdef Vector3i lower
+    cdef Vector3i upper
+    cdef object selection
+
+    def __init__(self, key, shape):
+        selection = []
+        for i in range(3):
+            if isinstance(key[i], slice):
+                indices = range(*key[i].indices(shape[i]))
+                if len(indices) == 0:
+                    self.lower[i] = self.upper[i] = 0
+                    selection.append(slice(0, 0))
+                    continue
+                self.lower[i] = min(indices[0], indices[-1])
+                self.upper[i] = max(indices[0], indices[-1]) + 1
+                selection.append(
+                    slice(indices[0] - self.lower[i], None, indices.step))
+            else:
+                utils.check_type_or_throw_except(
+                    key[i], 1, int, "LB node indices have to be integers or slices.")
+                if not 0 <= key[i] < shape[i]:
+                    raise ValueError("LB node index out of bounds")
+                self.lower[i] = key[i]
+                self.upper[i] = key[i] + 1
+                selection.append(0)
+        self.selection = tuple(selection)
+
+    cdef _fetch(self, vector[double] & values, n_values):
+        shape = [self.upper[i] - self.lower[i] for i in range(3)]
+        if n_values > 1:
+            shape.append(n_values)
+        return _slice_to_array(values, shape)[self.selection]
+
+    property velocity:
+        def __get__(self):
+            cdef double lattice_speed = lb_lbfluid_get_agrid() / lb_lbfluid_get_tau()
+            cdef vector[double] values = lb_lbnode_get_velocity_slice(
+                self.lower, self.upper)
+            return array_locked(self._fetch(values, 3) * lattice_speed)
+
+        def __set__(self, value):
+            raise NotImplementedError
+
+    property density:
+        def __get__(self):
+            cdef double agrid = lb_lbfluid_get_agrid()
+            cdef vector[double] values = lb_lbnode_get_density_slice(
+                self.lower, self.upper)
+            return array_locked(self._fetch(values, 1) / agrid**3)
+
+        def __set__(self, value):
+            raise NotImplementedError
+
+    property population:
+        def __get__(self):
+            cdef vector[double] values = lb_lbnode_get_pop_slice(
+                self.lower, self.upper)
+            return array_locked(self._fetch(values, 19))
+
+        def __set__(self, value):
+            raise NotImplementedError
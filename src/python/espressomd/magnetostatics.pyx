@@ -87,6 +87,9 @@ IF DP3M == 1:
         tune : :obj:`bool`, optional
             Activate/deactivate the tuning method on activation
             (default is True, i.e., activated).
+        overlap_fft_comm : :obj:`bool`, optional
+            Overlap the communication of the parallel FFT with the FFTs
+            of the mesh slabs that are already complete (default is False).
 
         """
 
@@ -140,7 +143,8 @@ IF DP3M == 1:
         def valid_keys(self):
             return ["prefactor", "alpha_L", "r_cut_iL", "mesh", "mesh_off",
                     "cao", "inter", "accuracy", "epsilon", "cao_cut", "a", "ai",
-                    "alpha", "r_cut", "inter2", "cao3", "additional_mesh", "tune"]
+                    "alpha", "r_cut", "inter2", "cao3", "additional_mesh", "tune",
+                    "overlap_fft_comm"]
 
         def required_keys(self):
             return ["accuracy", ]
@@ -153,7 +157,8 @@ IF DP3M == 1:
                     "mesh": -1,
                     "epsilon": 0.0,
                     "mesh_off": [-1, -1, -1],
-                    "tune": True}
+                    "tune": True,
+                    "overlap_fft_comm": False}
 
         def _get_params_from_es_core(self):
             params = {}
@@ -166,6 +171,7 @@ IF DP3M == 1:
             self.set_magnetostatics_prefactor()
             dp3m_set_eps(self._params["epsilon"])
             dp3m_set_ninterpol(self._params["inter"])
+            dp3m_set_overlap_fft_comm(self._params["overlap_fft_comm"])
             self.python_dp3m_set_mesh_offset(self._params["mesh_off"])
             self.python_dp3m_set_params(
                 self._params["r_cut"], self._params["mesh"],
@@ -174,6 +180,7 @@ IF DP3M == 1:
         def _tune(self):
             self.set_magnetostatics_prefactor()
             dp3m_set_eps(self._params["epsilon"])
+            dp3m_set_overlap_fft_comm(self._params["overlap_fft_comm"])
             self.python_dp3m_set_tune_params(
                 self._params["r_cut"], self._params["mesh"],
                 self._params["cao"], -1., self._params["accuracy"], self._params["inter"])
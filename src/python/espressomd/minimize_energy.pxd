@@ -23,7 +23,9 @@ cimport numpy as np
 from espressomd.utils cimport *
 
 cdef extern from "integrators/steepest_descent.hpp":
-    cdef void minimize_energy_init(const double f_max, const double gamma, const int max_steps, const double max_displacement)
+    cdef enum MinimizationMethod:
+        MINIMIZE_STEEPEST_DESCENT, MINIMIZE_FIRE, MINIMIZE_LBFGS
+    cdef void minimize_energy_init(const double f_max, const double gamma, const int max_steps, const double max_displacement, MinimizationMethod method, int lbfgs_memory)
 
 cdef extern from "communication.hpp":
     cdef int mpi_minimize_energy()
@@ -20,16 +20,23 @@
 from . cimport minimize_energy
 from espressomd.utils import is_valid_type
 
+_methods = {"steepest_descent": MINIMIZE_STEEPEST_DESCENT,
+            "fire": MINIMIZE_FIRE, "lbfgs": MINIMIZE_LBFGS}
+
 cdef class MinimizeEnergy:
     """
-    Steepest descent algorithm for energy minimization.
+    Energy minimization.
 
-    Particles located at :math:`\\vec{r}_i` at integration step :math:`i` and
-    experiencing a potential :math:`\mathcal{H}(\\vec{r}_i)` are displaced
-    according to the equation:
+    With the default steepest descent algorithm, particles located at
+    :math:`\\vec{r}_i` at integration step :math:`i` and experiencing a
+    potential :math:`\mathcal{H}(\\vec{r}_i)` are displaced according to
+    the equation:
 
     :math:`\\vec{r}_{i+1} = \\vec{r}_i - \\gamma\\nabla\mathcal{H}(\\vec{r}_i)`
 
+    The FIRE and L-BFGS algorithms usually need far fewer force evaluations
+    to converge, see :ref:`Steepest descent`.
+
     Parameters
     ----------
     f_max : :obj:`float`
@@ -44,6 +51,12 @@ cdef class MinimizeEnergy:
     max_displacement : :obj:`float`
         Maximal allowed displacement per step. Typical values for a LJ liquid
         are in the range of 0.1% to 10% of the particle sigma.
+    method : :obj:`str`, optional
+        Minimization algorithm, one of ``"steepest_descent"`` (default),
+        ``"fire"`` and ``"lbfgs"``.
+    lbfgs_memory : :obj:`int`, optional
+        Number of previous steps used by L-BFGS to approximate the
+        Hessian (default 5).
 
     """
     cdef object _params
@@ -52,7 +65,8 @@ cdef class MinimizeEnergy:
         return self._params
 
     def __setstate__(self, params):
-        self._params = params
+        self._params = self.default_params()
+        self._params.update(params)
 
     def __init__(self, *args, **kwargs):
         if len(args) == 0:
@@ -66,7 +80,8 @@ cdef class MinimizeEnergy:
                 raise ValueError(
                     "At least the following keys have to be given as keyword arguments: " + self.required_keys().__str__())
 
-        self._params = kwargs
+        self._params = self.default_params()
+        self._params.update(kwargs)
         self.validate_params()
 
     def init(self, *args, **kwargs):
@@ -75,7 +90,8 @@ cdef class MinimizeEnergy:
                 raise ValueError(
                     "At least the following keys have to be given as keyword arguments: " + self.required_keys().__str__())
 
-        self._params = kwargs
+        self._params = self.default_params()
+        self._params.update(kwargs)
         self.validate_params()
 
     def default_params(self):
@@ -84,6 +100,8 @@ cdef class MinimizeEnergy:
         para["gamma"] = 0.0
         para["max_steps"] = 0
         para["max_displacement"] = 0.0
+        para["method"] = "steepest_descent"
+        para["lbfgs_memory"] = 5
         return para
 
     def required_keys(self):
@@ -103,13 +121,28 @@ cdef class MinimizeEnergy:
         if self._params["max_displacement"] < 0:
             raise ValueError(
                 "max_displacement has to be a positive floating point number")
+        if self._params["method"] not in _methods:
+            raise ValueError(
+                "method has to be one of " + ", ".join(_methods))
+        if self._params["lbfgs_memory"] < 1 or not is_valid_type(
+                self._params["lbfgs_memory"], int):
+            raise ValueError(
+                "lbfgs_memory has to be a positive integer")
 
     def minimize(self):
         """
         Perform energy minimization sweep.
 
+        Returns
+        -------
+        :obj:`int`
+            Number of steps, which is less than ``max_steps`` if the
+            minimization converged.
+
         """
         minimize_energy_init(self._params["f_max"], self._params["gamma"],
                              self._params["max_steps"],
-                             self._params["max_displacement"])
-        mpi_minimize_energy()
+                             self._params["max_displacement"],
+                             _methods[self._params["method"]],
+                             self._params["lbfgs_memory"])
+        return mpi_minimize_energy()
@@ -19,3 +19,4 @@ IF P3M == 1 or DP3M == 1:
             int    inter2
             int    cao3
             double additional_mesh[3]
+            bint   overlap_fft_comm
@@ -45,8 +45,8 @@ public:
     this->add_parameters({
         {"ids",
          [this](const Variant &v) {
-           cylindrical_pid_profile_observable()->ids() =
-               get_value<std::vector<int>>(v);
+           cylindrical_pid_profile_observable()->set_ids(
+               get_value<std::vector<int>>(v));
          },
          [this]() { return cylindrical_pid_profile_observable()->ids(); }},
         {"center",
@@ -49,8 +49,8 @@ public:
   PidObservable() {
     this->add_parameters({{"ids",
                            [this](Variant const &v) {
-                             m_observable->ids() =
-                                 get_value<std::vector<int>>(v);
+                             m_observable->set_ids(
+                                 get_value<std::vector<int>>(v));
                            },
                            [this]() { return m_observable->ids(); }}});
   }
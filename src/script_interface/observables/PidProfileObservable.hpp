@@ -41,7 +41,7 @@ public:
     this->add_parameters(
         {{"ids",
           [this](const Variant &v) {
-            pid_profile_observable()->ids() = get_value<std::vector<int>>(v);
+            pid_profile_observable()->set_ids(get_value<std::vector<int>>(v));
           },
           [this]() { return pid_profile_observable()->ids(); }},
          {"n_x_bins",
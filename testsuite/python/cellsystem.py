@@ -37,6 +37,16 @@ class CellSystem(ut.TestCase):
         self.assertEqual(
             [s['use_verlet_list'], s['type']], [1, "domain_decomposition"])
 
+    def test_space_filling_curve(self):
+        for curve in ["morton", "hilbert", "none"]:
+            self.system.cell_system.set_domain_decomposition(
+                space_filling_curve=curve)
+            s = self.system.cell_system.get_state()
+            self.assertEqual(s['space_filling_curve'], curve)
+        with self.assertRaises(ValueError):
+            self.system.cell_system.set_domain_decomposition(
+                space_filling_curve="peano")
+
     def test_node_grid(self):
         self.system.cell_system.set_domain_decomposition()
         n_nodes = self.system.cell_system.get_state()['n_nodes']
@@ -185,6 +185,40 @@ class ClusterAnalysis(ut.TestCase):
             self.es.part[0]), self.cs.cluster_ids()[0])
         self.assertEqual(self.cs.cid_for_particle(1), self.cs.cluster_ids()[0])
 
+    def test_cell_system(self):
+        # The particles of the other tests are put back afterwards
+        particles = [(p.id, p.pos, p.bonds) for p in self.es.part]
+        min_global_cut = self.es.min_global_cut
+        try:
+            self.es.part.clear()
+            self.es.part.add(pos=np.random.random((300, 3)) * self.es.box_l)
+            self.cs.pair_criterion = DistanceCriterion(cut_off=0.1)
+
+            def partition():
+                return sorted(c[1].particle_ids() for c in self.cs.clusters)
+
+            # The cells do not cover the cut off, the pairs are found on the
+            # head node
+            self.es.min_global_cut = 0.
+            self.cs.run_for_all_pairs()
+            clusters_gathered = partition()
+
+            # The cells of the nodes cover the cut off
+            self.es.min_global_cut = 0.1
+            self.cs.run_for_all_pairs()
+            clusters_cells = partition()
+
+            self.assertGreater(len(clusters_gathered), 1)
+            self.assertEqual(clusters_cells, clusters_gathered)
+            for cluster in clusters_cells:
+                self.assertEqual(self.cs.cid_for_particle(cluster[0]),
+                                 cluster[0])
+        finally:
+            self.es.min_global_cut = min_global_cut
+            self.es.part.clear()
+            for pid, pos, bonds in particles:
+                self.es.part.add(id=pid, pos=pos, bonds=bonds)
+
 
 if __name__ == "__main__":
     ut.main()
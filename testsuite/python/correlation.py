@@ -59,6 +59,31 @@ class CorrelatorTest(ut.TestCase):
             self.assertAlmostEqual(corr[i, 3], 4 * t * t, places=3)
             self.assertAlmostEqual(corr[i, 4], 9 * t * t, places=3)
 
+    def test_tensor_product(self):
+        s = self.system
+        s.part.clear()
+        s.time_step = 0.01
+        s.thermostat.turn_off()
+        s.part.add(id=0, pos=(1, 2, 3), v=(0, 0, 0))
+        s.part.add(id=1, pos=(4, 5, 6), v=(0, 0, 0))
+
+        O1 = espressomd.observables.ParticlePositions(ids=(0,))
+        O2 = espressomd.observables.ParticlePositions(ids=(0, 1))
+        C = espressomd.accumulators.Correlator(
+            obs1=O1, obs2=O2, tau_lin=10, tau_max=1.0, delta_N=1,
+            corr_operation="tensor_product")
+
+        s.auto_update_accumulators.add(C)
+        s.integrator.run(200)
+        s.auto_update_accumulators.remove(C)
+
+        corr = C.result()
+        expected = np.outer(s.part[0].pos, np.append(s.part[0].pos,
+                                                     s.part[1].pos)).flatten()
+        for i in range(corr.shape[0]):
+            if corr[i, 1] > 0:
+                np.testing.assert_allclose(corr[i, 2:], expected)
+
 
 if __name__ == "__main__":
     ut.main()
@@ -132,6 +132,39 @@ class CoulombCloudWall(ut.TestCase):
         self.S.integrator.run(0)
         self.compare("p3m", energy=True, prefactor=3)
 
+    @utx.skipIfMissingFeatures(["P3M"])
+    def test_p3m_threads(self):
+        """
+        This checks P3M with the charge assignment and force
+        interpolation distributed over threads.
+
+        """
+
+        self.S.cell_system.set_domain_decomposition(use_threads=True)
+        self.S.actors.add(
+            espressomd.electrostatics.P3M(
+                prefactor=3, r_cut=1.001, accuracy=1e-3,
+                mesh=64, cao=7, alpha=2.70746, tune=False))
+        self.S.integrator.run(0)
+        self.compare("p3m_threads", energy=True, prefactor=3)
+        self.S.cell_system.set_domain_decomposition()
+
+    @utx.skipIfMissingFeatures(["P3M"])
+    def test_p3m_overlap_fft_comm(self):
+        """
+        This checks P3M with the FFT communication overlapped with
+        the FFTs.
+
+        """
+
+        self.S.actors.add(
+            espressomd.electrostatics.P3M(
+                prefactor=3, r_cut=1.001, accuracy=1e-3,
+                mesh=64, cao=7, alpha=2.70746, tune=False,
+                overlap_fft_comm=True))
+        self.S.integrator.run(0)
+        self.compare("p3m_overlap_fft_comm", energy=True, prefactor=3)
+
     @utx.skipIfMissingGPU()
     def test_p3m_gpu(self):
         self.S.actors.add(
@@ -0,0 +1,188 @@
+#
+# Copyright (C) 2013-2018 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+import espressomd
+import espressomd.constraints
+import espressomd.electrostatics
+import espressomd.interactions
+import espressomd.shapes
+import numpy as np
+import unittest as ut
+import unittest_decorators as utx
+
+
+@utx.skipIfMissingFeatures(["LENNARD_JONES", "ELECTROSTATICS"])
+class EnergyOfParticlesTest(ut.TestCase):
+
+    """Check that the change of the energy of a set of particles is the
+    change of the total potential energy for displacements, insertions,
+    deletions and type changes. The small box has at most two cells per
+    direction, so that the ghosts contain several periodic images of the
+    same particle.
+    """
+
+    system = espressomd.System(box_l=[10.0, 10.0, 10.0])
+    system.time_step = 0.01
+    system.cell_system.skin = 0.3
+    np.random.seed(42)
+
+    n_pairs = 6
+    harmonic = espressomd.interactions.HarmonicBond(k=5.0, r_0=0.8)
+    system.bonded_inter.add(harmonic)
+
+    def setUp(self):
+        for t1 in range(3):
+            for t2 in range(t1, 3):
+                self.system.non_bonded_inter[t1, t2].lennard_jones.set_params(
+                    epsilon=1.0 + 0.5 * (t1 + t2), sigma=0.5, cutoff=1.5,
+                    shift="auto")
+
+    def tearDown(self):
+        self.system.part.clear()
+        self.system.actors.clear()
+        self.system.constraints.clear()
+
+    def random_position(self, positions):
+        """Random position in the box with some distance to the wall at z=0
+        and to the other particles."""
+        box_l = self.system.box_l
+        while True:
+            pos = np.random.random(3) * box_l
+            if pos[2] < 0.6:
+                continue
+            d = [np.linalg.norm(
+                (pos - p) - box_l * np.round((pos - p) / box_l))
+                for p in positions]
+            if not d or min(d) > 0.6:
+                return pos
+
+    def setup_system(self, box_l):
+        self.system.box_l = 3 * [box_l]
+        self.system.cell_system.set_domain_decomposition()
+
+        positions = []
+        for i in range(self.n_pairs):
+            pos = self.random_position(positions)
+            positions.append(pos)
+            # the partner is in the box, but maybe across the boundary
+            partner = pos + 0.8 * np.array([1., 0., 0.])
+            partner[0] = partner[0] % box_l
+            positions.append(partner)
+            q = (-1)**i
+            self.system.part.add(id=2 * i, pos=pos, type=i % 2, q=q)
+            self.system.part.add(id=2 * i + 1, pos=partner, type=(i + 1) % 2,
+                                 q=-q)
+            self.system.part[2 * i].add_bond((self.harmonic, 2 * i + 1))
+
+        wall = espressomd.shapes.Wall(normal=[0, 0, 1], dist=0)
+        self.system.constraints.add(
+            espressomd.constraints.ShapeBasedConstraint(
+                shape=wall, particle_type=2))
+
+    def potential_energy(self):
+        energy = self.system.analysis.energy()
+        return energy["total"] - energy["kinetic"]
+
+    def check_change(self, ids, change):
+        e_particles_before = self.system.analysis.energy_of_particles(ids)
+        e_total_before = self.potential_energy()
+        change()
+        e_particles_after = self.system.analysis.energy_of_particles(ids)
+        e_total_after = self.potential_energy()
+        self.assertAlmostEqual(
+            e_particles_after - e_particles_before,
+            e_total_after - e_total_before,
+            delta=1e-9 * max(1., abs(e_total_before)))
+
+    def check_moves(self):
+        system = self.system
+        box_l = system.box_l
+        # the bond of the first pair crosses the box boundary afterwards and
+        # the third pair is moved close to the wall
+        shift = [box_l[0] - 0.3 - system.part[0].pos[0], 0., 0.]
+
+        def displace():
+            for i in [0, 1]:
+                system.part[i].pos = system.part[i].pos + shift
+            for i in [4, 5]:
+                system.part[i].pos = system.part[i].pos * [1., 1., 0.] + \
+                    [0., 0., 0.8]
+        self.check_change([0, 1, 4], displace)
+
+        new_id = 2 * self.n_pairs
+        new_pos = self.random_position(system.part[:].pos)
+
+        def insert():
+            system.part.add(id=new_id, pos=new_pos, type=1, q=1.)
+            system.part[new_id].add_bond((self.harmonic, 3))
+        self.check_change([new_id, 3], insert)
+
+        def delete():
+            system.part[2].remove()
+        self.check_change([2], delete)
+
+        def change_type():
+            system.part[5].type = 0
+            system.part[5].q = -system.part[5].q
+            system.part[6].type = 1
+        self.check_change([5, 6], change_type)
+
+    def check_boxes(self, actor):
+        # at most two cells per direction and several of them
+        for box_l in [4.0, 10.0]:
+            self.setup_system(box_l)
+            self.system.actors.add(actor())
+            self.check_moves()
+            self.tearDown()
+
+    def test_debye_hueckel(self):
+        self.check_boxes(lambda: espressomd.electrostatics.DH(
+            prefactor=1.0, kappa=1.0, r_cut=1.5))
+
+    def test_after_integration(self):
+        """The particles move without a resort during the integration, so
+        that they are not in the cells of their positions afterwards."""
+        system = self.system
+        self.setup_system(4.0)
+        system.actors.add(espressomd.electrostatics.DH(
+            prefactor=1.0, kappa=1.0, r_cut=1.5))
+        box_l = system.box_l[0]
+
+        # the first pair crosses the periodic face at x=0
+        system.part[0].pos = [box_l - 0.02, 2.0, 2.0]
+        system.part[1].pos = [0.78, 2.0, 2.0]
+        system.part[:].v = [0., 0., 0.]
+        system.part[0].v = [1., 0., 0.]
+        system.part[1].v = [1., 0., 0.]
+        system.integrator.run(0)
+        system.integrator.run(10)
+
+        def displace():
+            system.part[0].pos = system.part[0].pos + [0., 0.1, 0.]
+            system.part[6].pos = system.part[6].pos + [0., 0., 0.1]
+        self.check_change([0, 6], displace)
+
+    @utx.skipIfMissingFeatures(["P3M"])
+    def test_p3m(self):
+        self.check_boxes(lambda: espressomd.electrostatics.P3M(
+            prefactor=1.0, accuracy=1e-3, mesh=16, cao=5, r_cut=1.5,
+            alpha=2.0, tune=False, check_neutrality=False))
+
+
+if __name__ == "__main__":
+    ut.main()
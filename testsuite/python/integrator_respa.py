@@ -0,0 +1,97 @@
+#
+# Copyright (C) 2019 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+import espressomd
+from espressomd import electrostatics
+from espressomd.interactions import HarmonicBond
+
+
+@utx.skipIfMissingFeatures(["ELECTROSTATICS", "P3M", "LENNARD_JONES"])
+class RespaIntegrator(ut.TestCase):
+
+    """Compares the multiple time step integrator against Velocity Verlet
+       for a salt melt with bonded pairs."""
+    system = espressomd.System(box_l=[10.0, 10.0, 10.0])
+    system.time_step = 0.005
+    system.cell_system.skin = 0.4
+
+    def setUp(self):
+        np.random.seed(42)
+        grid = np.array([(x, y, z) for x in range(4) for y in range(4)
+                         for z in range(4)], dtype=float)
+        pos = 2.5 * grid + 0.2 * np.random.random(grid.shape)
+        q = np.array([(-1)**int(sum(g)) for g in grid])
+        v = np.random.normal(size=grid.shape)
+        self.system.part.add(pos=pos, q=q, v=v)
+
+        self.system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1, sigma=1, cutoff=2**(1. / 6.), shift="auto")
+        self.bond = HarmonicBond(k=20., r_0=2.5)
+        self.system.bonded_inter.add(self.bond)
+        for i in range(0, len(self.system.part), 2):
+            self.system.part[i].add_bond((self.bond, i + 1))
+
+        self.system.actors.add(electrostatics.P3M(
+            prefactor=1.0, accuracy=1e-4, mesh=[16, 16, 16], cao=5,
+            r_cut=2.5, alpha=1.2, tune=False))
+
+    def tearDown(self):
+        self.system.actors.clear()
+        self.system.part.clear()
+        self.system.integrator.set_vv()
+
+    def energy_deviation(self, steps):
+        energies = []
+        for _ in range(steps):
+            self.system.integrator.run(5)
+            energies.append(self.system.analysis.energy()["total"])
+        return np.max(np.abs(np.array(energies) - energies[0]))
+
+    def test_vv_limit(self):
+        self.system.integrator.set_vv()
+        self.system.integrator.run(40)
+        pos_vv = np.copy(self.system.part[:].pos)
+        self.system.part.clear()
+        self.system.actors.clear()
+        self.setUp()
+        self.system.integrator.set_respa(long_range_steps=1)
+        self.system.integrator.run(40)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].pos), pos_vv, atol=1e-10)
+
+    def test_energy_conservation(self):
+        kinetic = self.system.analysis.energy()["kinetic"]
+        self.system.integrator.set_respa(long_range_steps=4)
+        self.assertLess(self.energy_deviation(40), 0.01 * kinetic)
+        self.system.integrator.set_respa(
+            long_range_steps=4, short_range_steps=2)
+        self.assertLess(self.energy_deviation(40), 0.01 * kinetic)
+
+    def test_invalid_parameters(self):
+        with self.assertRaises(Exception):
+            self.system.integrator.set_respa(long_range_steps=3,
+                                             short_range_steps=2)
+        with self.assertRaises(Exception):
+            self.system.integrator.set_respa(long_range_steps=0)
+
+
+if __name__ == "__main__":
+    ut.main()
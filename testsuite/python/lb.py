@@ -272,6 +272,38 @@ class TestLB:
             ext_force_density,
             atol=1e-4)
 
+    def test_lb_node_slices(self):
+        self.lbf = self.lb_class(
+            kT=1.0,
+            seed=3,
+            visc=self.params['viscosity'],
+            dens=self.params['dens'],
+            agrid=self.params['agrid'],
+            tau=self.system.time_step,
+            ext_force_density=[0, 0, 0])
+        self.system.actors.add(self.lbf)
+        self.system.integrator.run(5)
+
+        for key in [(slice(None), 1, 2), (3, slice(2, 9, 3), slice(None)),
+                    (slice(None, None, -4), slice(1, 3), 0)]:
+            nodes = np.array(list(itertools.product(
+                *[np.arange(self.lbf.shape[i])[k] if isinstance(k, slice)
+                  else [k] for i, k in enumerate(key)])))
+            shape = [len(np.arange(self.lbf.shape[i])[k])
+                     for i, k in enumerate(key) if isinstance(k, slice)]
+            density = [self.lbf[n].density for n in nodes]
+            velocity = [self.lbf[n].velocity for n in nodes]
+            population = [self.lbf[n].population for n in nodes]
+            np.testing.assert_allclose(
+                np.copy(self.lbf[key].density),
+                np.reshape(density, shape), rtol=1e-10)
+            np.testing.assert_allclose(
+                np.copy(self.lbf[key].velocity),
+                np.reshape(velocity, shape + [3]), rtol=1e-10)
+            np.testing.assert_allclose(
+                np.copy(self.lbf[key].population),
+                np.reshape(population, shape + [19]), rtol=1e-10)
+
     def test_parameter_change_without_seed(self):
         self.lbf = self.lb_class(
             visc=self.params['viscosity'],
@@ -429,6 +461,81 @@ class TestLBCPU(TestLB, ut.TestCase):
         self.lb_class = espressomd.lb.LBFluid
         self.params.update({"mom_prec": 1E-9, "mass_prec_per_node": 5E-8})
 
+    def test_threads(self):
+        """
+        Check that the fluid update gives the same results with the
+        lattice rows distributed over threads.
+
+        """
+        def node_velocities(use_threads):
+            self.system.cell_system.set_domain_decomposition(
+                use_threads=use_threads)
+            lbf = self.lb_class(
+                visc=self.params['viscosity'],
+                dens=self.params['dens'],
+                agrid=self.params['agrid'],
+                tau=self.system.time_step,
+                kT=self.params['temp'], seed=42)
+            self.system.actors.add(lbf)
+            self.system.integrator.run(10)
+            velocities = np.array([np.copy(n.velocity) for n in lbf.nodes()])
+            self.system.actors.clear()
+            return velocities
+
+        np.testing.assert_array_equal(
+            node_velocities(True), node_velocities(False))
+        self.system.cell_system.set_domain_decomposition()
+
+    def test_in_place_streaming(self):
+        """
+        Check that streaming in a single population array gives the
+        same results as streaming into a second one.
+
+        """
+        def node_velocities(in_place_streaming):
+            lbf = self.lb_class(
+                visc=self.params['viscosity'],
+                dens=self.params['dens'],
+                agrid=self.params['agrid'],
+                tau=self.system.time_step,
+                kT=self.params['temp'], seed=42,
+                in_place_streaming=in_place_streaming)
+            self.system.actors.add(lbf)
+            self.system.integrator.run(10)
+            velocities = np.array([np.copy(n.velocity) for n in lbf.nodes()])
+            self.system.actors.clear()
+            return velocities
+
+        np.testing.assert_array_equal(
+            node_velocities(True), node_velocities(False))
+
+    def test_in_place_streaming_switch(self):
+        """
+        Check that the streaming can be switched on an active fluid.
+
+        """
+        def node_velocities(in_place_streaming, switch):
+            lbf = self.lb_class(
+                visc=self.params['viscosity'],
+                dens=self.params['dens'],
+                agrid=self.params['agrid'],
+                tau=self.system.time_step,
+                ext_force_density=[0.01, 0., 0.],
+                in_place_streaming=in_place_streaming)
+            self.system.actors.add(lbf)
+            if switch:
+                self.system.integrator.run(10)
+                lbf.set_params(in_place_streaming=not in_place_streaming)
+            self.system.integrator.run(10)
+            velocities = np.array([np.copy(n.velocity) for n in lbf.nodes()])
+            self.system.actors.clear()
+            return velocities
+
+        for in_place_streaming in [True, False]:
+            np.testing.assert_array_equal(
+                node_velocities(in_place_streaming, True),
+                node_velocities(not in_place_streaming, False))
+
 
 @utx.skipIfMissingGPU()
 class TestLBGPU(TestLB, ut.TestCase):
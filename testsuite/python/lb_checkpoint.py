@@ -0,0 +1,75 @@
+# Copyright (C) 2010-2019 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import os
+import unittest as ut
+import numpy as np
+
+import espressomd
+import espressomd.lb
+
+"""
+Save and load the populations of a CPU LB fluid, which is distributed
+over all ranks of the test, and compare them to the ones at the time of
+saving. The binary checkpoint has to reproduce them bit by bit.
+
+"""
+
+LB_PARAMS = {'agrid': 0.5,
+             'dens': 0.9,
+             'visc': 1.2,
+             'tau': 0.05,
+             'kT': 0.8,
+             'seed': 17,
+             'ext_force_density': [0.1, -0.2, 0.3]}
+
+
+class LBCheckpointTest(ut.TestCase):
+    system = espressomd.System(box_l=[6.0, 4.0, 5.0])
+    system.time_step = 0.05
+    system.cell_system.skin = 0.1
+    filename = "lb_checkpoint_test.cpt"
+
+    def setUp(self):
+        self.lbf = espressomd.lb.LBFluid(**LB_PARAMS)
+        self.system.actors.add(self.lbf)
+        self.system.integrator.run(20)
+
+    def tearDown(self):
+        self.system.actors.clear()
+        if os.path.exists(self.filename):
+            os.remove(self.filename)
+
+    def save_and_load(self, binary):
+        saved = np.copy(self.lbf[:, :, :].population)
+        self.lbf.save_checkpoint(self.filename, binary)
+        self.system.integrator.run(10)
+        self.assertFalse(np.array_equal(self.lbf[:, :, :].population, saved))
+        self.lbf.load_checkpoint(self.filename, binary)
+        return saved, np.copy(self.lbf[:, :, :].population)
+
+    def test_binary(self):
+        saved, loaded = self.save_and_load(binary=True)
+        np.testing.assert_array_equal(loaded, saved)
+
+    def test_ascii(self):
+        saved, loaded = self.save_and_load(binary=False)
+        # the text format has 16 decimal places
+        np.testing.assert_allclose(loaded, saved, rtol=0., atol=1e-15)
+
+
+if __name__ == "__main__":
+    ut.main()
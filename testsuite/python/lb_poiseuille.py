@@ -133,6 +133,15 @@ class LBCPUPoiseuille(ut.TestCase, LBPoiseuilleCommon):
         self.lbf = espressomd.lb.LBFluid(**LB_PARAMS)
 
 
+@utx.skipIfMissingFeatures(['LB_BOUNDARIES', 'EXTERNAL_FORCES'])
+class LBCPUPoiseuilleInPlace(ut.TestCase, LBPoiseuilleCommon):
+
+    """Test for the CPU implementation of the LB with in-place streaming."""
+
+    def setUp(self):
+        self.lbf = espressomd.lb.LBFluid(in_place_streaming=True, **LB_PARAMS)
+
+
 @utx.skipIfMissingGPU()
 @utx.skipIfMissingFeatures(['LB_BOUNDARIES_GPU', 'EXTERNAL_FORCES'])
 class LBGPUPoiseuille(ut.TestCase, LBPoiseuilleCommon):
@@ -0,0 +1,101 @@
+# Copyright (C) 2010-2019 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+
+import espressomd
+import espressomd.lb
+import espressomd.lbboundaries
+import espressomd.shapes
+
+"""
+Check that the nodes covered by boundaries do not change the fluid.
+
+A channel with porous obstacles is bounded by walls of one node. The fluid
+on the other side of the walls is updated like the fluid in the channel,
+as all nodes were before the boundary nodes were skipped. The result in
+the channel has to be bit-identical to the one of a system in which all
+of the region outside of the channel is covered by boundaries, which
+are not visited in the collision, the streaming and the bounce-back.
+
+"""
+
+AGRID = 0.5
+LB_PARAMS = {'agrid': AGRID,
+             'dens': 1.0,
+             'visc': 1.5,
+             'tau': 0.1,
+             'ext_force_density': [0.1, 0.02, 0.0]}
+# node indices of the channel along z, the walls are the nodes next to it
+CHANNEL = slice(3, 9)
+
+
+@utx.skipIfMissingFeatures(["LB_BOUNDARIES"])
+class LBPorousTest(ut.TestCase):
+    system = espressomd.System(box_l=[6.0, 6.0, 6.0])
+    system.time_step = 0.1
+    system.cell_system.skin = 0.4 * AGRID
+
+    obstacles = [
+        espressomd.shapes.Sphere(center=[1.5, 1.5, 3.0], radius=0.8,
+                                 direction=1),
+        espressomd.shapes.Sphere(center=[4.2, 4.0, 2.8], radius=0.6,
+                                 direction=1),
+        espressomd.shapes.Cylinder(center=[3.0, 1.0, 3.0], axis=[0, 0, 1],
+                                   radius=0.4, length=1.6, direction=1)]
+
+    def slab(self, z_min, z_max):
+        return espressomd.shapes.Rhomboid(
+            corner=[0, 0, z_min], a=[self.system.box_l[0], 0, 0],
+            b=[0, self.system.box_l[1], 0], c=[0, 0, z_max - z_min],
+            direction=1)
+
+    def tearDown(self):
+        self.system.lbboundaries.clear()
+        self.system.actors.clear()
+
+    def run_channel(self, walls):
+        self.system.lbboundaries.clear()
+        self.system.actors.clear()
+        lbf = espressomd.lb.LBFluid(**LB_PARAMS)
+        self.system.actors.add(lbf)
+        for shape in self.obstacles + walls:
+            self.system.lbboundaries.add(
+                espressomd.lbboundaries.LBBoundary(shape=shape))
+
+        self.system.integrator.run(50)
+        return (np.copy(lbf[:, :, CHANNEL].population),
+                np.copy(lbf[:, :, CHANNEL].velocity))
+
+    def test_covered_nodes(self):
+        box_z = self.system.box_l[2]
+        # walls of one node at z = 1.25 and z = 4.75
+        thin = [self.slab(1.0, 1.5), self.slab(4.5, 5.0)]
+        # everything outside of the channel
+        thick = [self.slab(0.0, 1.5), self.slab(4.5, box_z)]
+
+        pop_thin, v_thin = self.run_channel(thin)
+        pop_thick, v_thick = self.run_channel(thick)
+
+        self.assertGreater(np.max(np.abs(v_thin)), 0.)
+        np.testing.assert_array_equal(pop_thin, pop_thick)
+        np.testing.assert_array_equal(v_thin, v_thick)
+
+
+if __name__ == "__main__":
+    ut.main()
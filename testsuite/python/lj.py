@@ -80,6 +80,83 @@ class LennardJonesTest(ut.TestCase):
         self.system.integrator.run(recalc_forces=True, steps=0)
         self.check()
 
+    def test_dd_cluster_pairs(self):
+        self.system.cell_system.set_domain_decomposition(
+            use_verlet_lists=True, use_cluster_pairs=True)
+        # Build cluster-pair lists and calc ia
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        self.check()
+
+        # Calc is from cluster-pair lists
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        self.check()
+
+    def test_dd_space_filling_curve(self):
+        for curve in ["morton", "hilbert"]:
+            self.system.cell_system.set_domain_decomposition(
+                use_verlet_lists=True, space_filling_curve=curve)
+            self.system.integrator.run(recalc_forces=True, steps=0)
+            self.check()
+
+    def trajectory(self, **dd_params):
+        """Positions after 200 steps from the reference configuration."""
+        self.system.time_step = 0.001
+        self.system.part[:].v = [0., 0., 0.]
+        self.system.cell_system.set_domain_decomposition(**dd_params)
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        self.check()
+
+        self.system.integrator.run(200)
+        return numpy.copy(self.system.part[:].pos)
+
+    def test_dd_incremental_verlet_lists(self):
+        reference = self.trajectory(use_verlet_lists=True)
+        self.setUp()
+        trajectory = self.trajectory(
+            use_verlet_lists=True, incremental_verlet_lists=True)
+        numpy.testing.assert_allclose(trajectory, reference, atol=1e-7)
+
+    def test_dd_overlap_ghost_comm(self):
+        reference = self.trajectory(use_verlet_lists=True)
+        for incremental in [False, True]:
+            self.setUp()
+            trajectory = self.trajectory(
+                use_verlet_lists=True, incremental_verlet_lists=incremental,
+                overlap_ghost_comm=True)
+            numpy.testing.assert_allclose(trajectory, reference, atol=1e-7)
+
+    def test_dd_threads(self):
+        for deterministic in [True, False]:
+            self.system.cell_system.set_domain_decomposition(
+                use_verlet_lists=True, use_threads=True,
+                deterministic_threads=deterministic)
+            # Build VL and calc ia
+            self.system.integrator.run(recalc_forces=True, steps=0)
+            self.check()
+
+            # Calc is from VLs
+            self.system.integrator.run(recalc_forces=True, steps=0)
+            self.check()
+
+    def test_dd_threads_bit_identical(self):
+        self.system.cell_system.set_domain_decomposition(use_verlet_lists=True)
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        f_serial = numpy.copy(self.system.part[:].f)
+        e_serial = self.system.analysis.energy()["total"]
+
+        self.system.cell_system.set_domain_decomposition(
+            use_verlet_lists=True, use_threads=True)
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        numpy.testing.assert_array_equal(self.system.part[:].f, f_serial)
+        self.assertEqual(self.system.analysis.energy()["total"], e_serial)
+
+    def test_dd_soa(self):
+        for use_threads in [False, True]:
+            self.system.cell_system.set_domain_decomposition(
+                use_soa=True, use_threads=use_threads)
+            self.system.integrator.run(recalc_forces=True, steps=0)
+            self.check()
+
 
 if __name__ == '__main__':
     ut.main()
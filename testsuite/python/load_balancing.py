@@ -0,0 +1,90 @@
+#
+# Copyright (C) 2013-2018 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+import unittest as ut
+import espressomd
+import numpy as np
+
+
+class LoadBalancing(ut.TestCase):
+    system = espressomd.System(box_l=[20.0, 10.0, 10.0])
+    system.cell_system.skin = 0.4
+    system.time_step = 0.01
+    n_part = 400
+
+    def setUp(self):
+        np.random.seed(42)
+        pos = np.random.random((self.n_part, 3)) * self.system.box_l
+        # Put all particles into the first quarter in x
+        pos[:, 0] *= 0.25
+        self.system.part.add(pos=pos)
+
+    def tearDown(self):
+        self.system.part.clear()
+        self.system.cell_system.set_domain_decomposition()
+
+    def test_state(self):
+        self.system.cell_system.set_domain_decomposition(
+            load_balancing_interval=10, load_balancing_metric="force_time")
+        s = self.system.cell_system.get_state()
+        self.assertEqual(s['load_balancing_interval'], 10)
+        self.assertEqual(s['load_balancing_metric'], "force_time")
+        with self.assertRaises(ValueError):
+            self.system.cell_system.set_domain_decomposition(
+                load_balancing_metric="pair_count")
+        with self.assertRaises(ValueError):
+            self.system.cell_system.set_domain_decomposition(
+                load_balancing_interval=-1)
+
+    def test_particles(self):
+        n_nodes = self.system.cell_system.get_state()['n_nodes']
+        if n_nodes == 1:
+            return
+
+        self.system.cell_system.node_grid = [n_nodes, 1, 1]
+        self.system.cell_system.set_domain_decomposition(
+            load_balancing_interval=1, load_balancing_metric="particles")
+        pos = np.copy(self.system.part[:].pos)
+
+        # Without load balancing, the first node has all the particles
+        self.system.integrator.run(20)
+
+        counts = self.system.cell_system.resort()
+        self.assertEqual(sum(counts), self.n_part)
+        self.assertLessEqual(max(counts), 1.5 * self.n_part / n_nodes)
+        np.testing.assert_allclose(np.copy(self.system.part[:].pos), pos)
+
+    def test_force_time(self):
+        n_nodes = self.system.cell_system.get_state()['n_nodes']
+        if n_nodes == 1:
+            return
+
+        self.system.cell_system.node_grid = [n_nodes, 1, 1]
+        self.system.cell_system.set_domain_decomposition(
+            load_balancing_interval=5, load_balancing_metric="force_time")
+        pos = np.copy(self.system.part[:].pos)
+
+        self.system.integrator.run(20)
+
+        counts = self.system.cell_system.resort()
+        self.assertEqual(sum(counts), self.n_part)
+        np.testing.assert_allclose(np.copy(self.system.part[:].pos), pos)
+
+
+if __name__ == "__main__":
+    ut.main()
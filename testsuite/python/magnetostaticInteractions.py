@@ -17,6 +17,7 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
 import unittest as ut
+import numpy as np
 import espressomd
 from espressomd import magnetostatics
 from tests_common import generate_test_for_class
@@ -40,6 +41,61 @@ class MagnetostaticsInteractionsTests(ut.TestCase):
                  mesh_off=[0.5, 0.5, 0.5], r_cut=2.4, mesh=[8, 8, 8],
                  cao=1, alpha=12, accuracy=0.01, tune=False))
 
+    @ut.skipIf(not espressomd.has_features(["DP3M"]),
+               "Features not available, skipping test!")
+    def test_DP3M_threads(self):
+        np.random.seed(42)
+        self.system.part.add(
+            pos=np.random.random((100, 3)) * self.system.box_l,
+            dip=np.random.random((100, 3)) - 0.5)
+        self.system.actors.add(magnetostatics.DipolarP3M(
+            prefactor=1.0, epsilon=0.0, r_cut=2.4, mesh=[16, 16, 16],
+            cao=5, alpha=1.2, accuracy=0.01, tune=False))
+
+        self.system.integrator.run(0, recalc_forces=True)
+        f_serial = np.copy(self.system.part[:].f)
+        t_serial = np.copy(self.system.part[:].torque_lab)
+
+        self.system.cell_system.set_domain_decomposition(use_threads=True)
+        self.system.integrator.run(0, recalc_forces=True)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].f), f_serial, rtol=1e-10, atol=1e-10)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].torque_lab), t_serial, rtol=1e-10,
+            atol=1e-10)
+
+        self.system.cell_system.set_domain_decomposition()
+        self.system.actors.clear()
+        self.system.part.clear()
+
+    @ut.skipIf(not espressomd.has_features(["DP3M"]),
+               "Features not available, skipping test!")
+    def test_DP3M_overlap_fft_comm(self):
+        np.random.seed(42)
+        self.system.part.add(
+            pos=np.random.random((100, 3)) * self.system.box_l,
+            dip=np.random.random((100, 3)) - 0.5)
+        p3m_params = dict(prefactor=1.0, epsilon=0.0, r_cut=2.4,
+                          mesh=[16, 16, 16], cao=5, alpha=1.2, accuracy=0.01,
+                          tune=False)
+        self.system.actors.add(magnetostatics.DipolarP3M(**p3m_params))
+        self.system.integrator.run(0, recalc_forces=True)
+        f_ref = np.copy(self.system.part[:].f)
+        t_ref = np.copy(self.system.part[:].torque_lab)
+
+        self.system.actors.clear()
+        self.system.actors.add(magnetostatics.DipolarP3M(
+            overlap_fft_comm=True, **p3m_params))
+        self.system.integrator.run(0, recalc_forces=True)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].f), f_ref, rtol=1e-10, atol=1e-10)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].torque_lab), t_ref, rtol=1e-10,
+            atol=1e-10)
+
+        self.system.actors.clear()
+        self.system.part.clear()
+
     if espressomd.has_features(["DIPOLAR_DIRECT_SUM"]):
         test_DdsCpu = generate_test_for_class(
             system, magnetostatics.DipolarDirectSumCpu, dict(prefactor=3.4))
@@ -40,6 +40,9 @@ class test_minimize_energy(ut.TestCase):
     lj_sig = 1.0
     lj_cut = 1.12246
 
+    # convergence criterion of FIRE and L-BFGS
+    f_max = 1e-10
+
     def setUp(self):
         self.system.box_l = 3 * [self.box_l]
         self.system.cell_system.skin = 0.4
@@ -55,7 +58,7 @@ class test_minimize_energy(ut.TestCase):
         self.system.part.clear()
         self.system.integrator.set_vv()
 
-    def test_relaxation(self):
+    def check_relaxation(self, minimize, f_max=0.):
         for i in range(self.n_part):
             p = self.system.part.add(
                 id=i, pos=np.random.random(3) * self.system.box_l)
@@ -67,21 +70,80 @@ class test_minimize_energy(ut.TestCase):
         self.assertNotAlmostEqual(
             self.system.analysis.energy()["total"], 0, places=10)
 
-        self.system.integrator.set_steepest_descent(
-            f_max=0.0, gamma=0.1, max_displacement=0.05)
-
-        self.system.integrator.run(500)
+        minimize()
 
         self.system.constraints.clear()
 
         # Check
         self.assertAlmostEqual(
             self.system.analysis.energy()["total"], 0, places=10)
-        np.testing.assert_allclose(np.copy(self.system.part[:].f), 0.)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].f), 0., atol=f_max)
         if self.test_rotation:
             np.testing.assert_allclose(np.copy(self.system.part[:].dip), 
                                        np.hstack((-np.ones((self.n_part, 1)), np.zeros((self.n_part, 1)), np.zeros((self.n_part, 1)))), atol=1E-9)
 
+    def test_relaxation(self):
+        def minimize():
+            self.system.integrator.set_steepest_descent(
+                f_max=0.0, gamma=0.1, max_displacement=0.05)
+            self.system.integrator.run(500)
+
+        self.check_relaxation(minimize)
+
+    def minimize_with(self, method):
+        def minimize():
+            max_steps = 2000
+            self.system.minimize_energy.init(
+                f_max=self.f_max, gamma=0.1, max_steps=max_steps,
+                max_displacement=0.05, method=method)
+            self.assertLess(self.system.minimize_energy.minimize(), max_steps)
+
+        return minimize
+
+    def test_relaxation_fire(self):
+        self.check_relaxation(self.minimize_with("fire"), self.f_max)
+        np.testing.assert_allclose(np.copy(self.system.part[:].v), 0.)
+
+    def test_relaxation_lbfgs(self):
+        self.check_relaxation(self.minimize_with("lbfgs"), self.f_max)
+
+    def test_convergence(self):
+        """FIRE and L-BFGS relax a Lennard-Jones liquid with attraction in
+        clearly fewer steps than steepest descent, which is slowed down by
+        the soft collective modes."""
+        box_l = 8.0
+        self.system.box_l = 3 * [box_l]
+        self.system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=self.lj_eps, sigma=self.lj_sig, cutoff=1.5, shift="auto")
+        positions = np.random.random((int(0.6 * box_l**3), 3)) * box_l
+        f_max = 0.1
+        max_steps = 5000
+
+        steps = {}
+        for method in ["steepest_descent", "fire", "lbfgs"]:
+            self.system.part.clear()
+            self.system.part.add(pos=positions)
+            self.system.minimize_energy.init(
+                f_max=f_max, gamma=0.01, max_steps=max_steps,
+                max_displacement=0.05, method=method)
+            steps[method] = self.system.minimize_energy.minimize()
+
+        for method in ["fire", "lbfgs"]:
+            self.assertLess(steps[method], steps["steepest_descent"] / 3)
+        self.assertLess(
+            np.max(np.linalg.norm(self.system.part[:].f, axis=1)), f_max)
+
+    def test_invalid_method(self):
+        with self.assertRaises(ValueError):
+            self.system.minimize_energy.init(
+                f_max=0.0, gamma=0.1, max_steps=1, max_displacement=0.05,
+                method="newton")
+        with self.assertRaises(ValueError):
+            self.system.minimize_energy.init(
+                f_max=0.0, gamma=0.1, max_steps=1, max_displacement=0.05,
+                method="lbfgs", lbfgs_memory=0)
+
     def test_rescaling(self):
         self.system.part.add(pos=[5., 5., 4.9], type=0)
         self.system.part.add(pos=[5., 5., 5.1], type=0)
@@ -162,6 +162,43 @@ class Observables(ut.TestCase):
         np.testing.assert_array_almost_equal(
             obs_data, part_data, err_msg="Data did not agree for observable 'DipoleMoment'", decimal=9)
 
+    def test_distributed_reduction(self):
+        """The density profile is reduced from the partial profiles of the
+        nodes, which keep the ids between the evaluations. Compare it with
+        the histogram of the gathered particles after the ids have changed
+        and after the particles have moved to other nodes."""
+        system = self.system
+        kwargs = dict(n_x_bins=4, n_y_bins=5, n_z_bins=2, min_x=0.0,
+                      max_x=10.0, min_y=0.0, max_y=10.0, min_z=0.0,
+                      max_z=10.0)
+        bin_volume = 10.0**3 / (4 * 5 * 2)
+
+        def check(observable, ids):
+            pos = np.mod(system.part[ids].pos, 10.0)
+            hist = np.histogramdd(pos, bins=(4, 5, 2),
+                                  range=3 * [(0.0, 10.0)])[0]
+            np.testing.assert_array_almost_equal(
+                observable.calculate(), hist.flatten() / bin_volume,
+                decimal=9)
+
+        ids = list(range(0, self.N_PART, 3))
+        observable = espressomd.observables.DensityProfile(ids=ids, **kwargs)
+        check(observable, ids)
+
+        other = espressomd.observables.DensityProfile(
+            ids=range(self.N_PART), **kwargs)
+        check(other, range(self.N_PART))
+        del other
+
+        ids = list(range(1, self.N_PART, 2))
+        observable.ids = ids
+        check(observable, ids)
+
+        positions = system.part[:].pos
+        system.part[:].pos = random((self.N_PART, 3)) * 10
+        check(observable, ids)
+        system.part[:].pos = positions
+
 
 if __name__ == "__main__":
     ut.main()
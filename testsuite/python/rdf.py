@@ -18,6 +18,7 @@
 #
 
 import unittest as ut
+import unittest_decorators as utx
 import espressomd
 import numpy as np
 
@@ -115,6 +116,83 @@ class RdfTest(ut.TestCase):
 
         self.assertTrue(np.allclose(rdf[1], rdf_av[1]))
 
+    @utx.skipIfMissingFeatures("LENNARD_JONES")
+    def test_cell_system(self):
+        s = self.s
+
+        for i in range(300):
+            s.part.add(id=i, pos=s.box_l * np.random.random(3), type=(i % 3))
+
+        r_bins = 20
+        r_min = 0.0
+        r_max = 2.0
+        rdf_kwargs = dict(rdf_type='rdf', type_list_a=[0, 2], type_list_b=[1],
+                          r_min=r_min, r_max=r_max, r_bins=r_bins)
+
+        # Without interactions the nodes exchange the periodic images
+        rdf_images = s.analysis.rdf(**rdf_kwargs)
+
+        # The cells of the nodes cover r_max
+        s.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=0., sigma=1., cutoff=r_max, shift=0.)
+        rdf_cells = s.analysis.rdf(**rdf_kwargs)
+        s.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=0., sigma=0., cutoff=0., shift=0.)
+
+        self.assertTrue(np.allclose(rdf_cells, rdf_images))
+
+    def test_distributed(self):
+        s = self.s
+        s.box_l = [10., 8., 6.]
+
+        for i in range(300):
+            s.part.add(id=i, pos=s.box_l * np.random.random(3), type=(i % 3))
+
+        def reference(r_min, r_max, r_bins):
+            pos = s.part[:].pos_folded
+            types = s.part[:].type
+            w_a = np.isin(types, [0, 2]).astype(float)
+            w_b = (types == 1).astype(float)
+            d = pos[:, np.newaxis, :] - pos[np.newaxis, :, :]
+            d -= s.box_l * np.round(d / s.box_l)
+            dist = np.linalg.norm(d, axis=2)
+            i, j = np.triu_indices(len(pos), k=1)
+            weights = w_a[i] * w_b[j] + w_a[j] * w_b[i]
+            hist, edges = np.histogram(dist[i, j], bins=r_bins,
+                                       range=(r_min, r_max), weights=weights)
+            bin_volumes = 4. / 3. * np.pi * (edges[1:]**3 - edges[:-1]**3)
+            return hist * np.prod(s.box_l) / (
+                bin_volumes * np.sum(w_a) * np.sum(w_b))
+
+        # the nodes exchange the periodic images within r_max, or the
+        # particles are gathered for r_max beyond half the box
+        for r_max in [2.0, 2.9, 4.5]:
+            rdf = s.analysis.rdf(rdf_type='rdf', type_list_a=[0, 2],
+                                 type_list_b=[1], r_min=0.5, r_max=r_max,
+                                 r_bins=20)
+            np.testing.assert_allclose(rdf[1], reference(0.5, r_max, 20),
+                                       rtol=1e-10, atol=1e-10)
+
+    def test_matrix(self):
+        s = self.s
+
+        for i in range(200):
+            s.part.add(id=i, pos=s.box_l * np.random.random(3), type=(i % 3))
+
+        r_bins = 50
+        r_min = 0.0
+        r_max = 0.49 * s.box_l[0]
+        r, g = s.analysis.rdf_matrix(types=[0, 1, 2], r_min=r_min,
+                                     r_max=r_max, r_bins=r_bins)
+
+        for i in range(3):
+            for j in range(3):
+                rdf = s.analysis.rdf(rdf_type='rdf', type_list_a=[i],
+                                     type_list_b=[j], r_min=r_min,
+                                     r_max=r_max, r_bins=r_bins)
+                self.assertTrue(np.allclose(rdf[0], r))
+                self.assertTrue(np.allclose(rdf[1], g[i, j]))
+
 
 if __name__ == "__main__":
     ut.main()
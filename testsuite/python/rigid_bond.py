@@ -25,12 +25,17 @@ from espressomd.interactions import RigidBond
 
 @utx.skipIfMissingFeatures("BOND_CONSTRAINT")
 class RigidBondTest(ut.TestCase):
+    s = espressomd.System(box_l=[1.0, 1.0, 1.0])
+    s.seed = s.cell_system.get_state()['n_nodes'] * [1234]
 
-    def test(self):
+    def tearDown(self):
+        self.s.part.clear()
+        self.s.integrator.set_rigid_bond_solver("SHAKE")
+
+    def check_chain(self):
         target_acc = 1E-3
         tol = 1.2 * target_acc
-        s = espressomd.System(box_l=[1.0, 1.0, 1.0])
-        s.seed = s.cell_system.get_state()['n_nodes'] * [1234]
+        s = self.s
         s.box_l = [10, 10, 10]
         s.cell_system.skin = 0.4
         s.time_step = 0.01
@@ -51,6 +56,14 @@ class RigidBondTest(ut.TestCase):
             vel_proj = np.dot(s.part[i].v - s.part[i - 1].v, v_d) / d
             self.assertLess(vel_proj, tol)
 
+    def test(self):
+        self.check_chain()
+
+    def test_lincs(self):
+        self.s.integrator.set_rigid_bond_solver(
+            "LINCS", expansion_order=8, iterations=2)
+        self.check_chain()
+
 
 if __name__ == "__main__":
     ut.main()
@@ -0,0 +1,97 @@
+#
+# Copyright (C) 2013-2018 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+import espressomd
+import espressomd.interactions
+import numpy as np
+import unittest as ut
+import unittest_decorators as utx
+
+
+@utx.skipIfMissingFeatures(["LENNARD_JONES"])
+class ShortRangeThreadsTest(ut.TestCase):
+
+    """Compare the forces of the threaded short-range loop to the serial
+    ones for chains with pair, angle and dihedral bonds, which cross the
+    periodic boundaries. The partners of the bonds are in cells that are
+    processed by other threads.
+    """
+
+    system = espressomd.System(box_l=[8.0, 8.0, 8.0])
+    system.time_step = 0.01
+    system.cell_system.skin = 0.4
+    np.random.seed(42)
+
+    def setUp(self):
+        self.system.part.clear()
+        self.system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1.0, sigma=0.5, cutoff=0.5 * 2**(1. / 6.), shift="auto")
+
+        harmonic = espressomd.interactions.HarmonicBond(k=10.0, r_0=1.0)
+        angle = espressomd.interactions.AngleHarmonic(bend=5.0, phi0=np.pi)
+        dihedral = espressomd.interactions.Dihedral(
+            bend=1.0, mult=3, phase=0.0)
+        for bond in [harmonic, angle, dihedral]:
+            self.system.bonded_inter.add(bond)
+
+        # biased random walks, which wrap around the box several times
+        n_chains = 20
+        n_monomers = 40
+        for c in range(n_chains):
+            pos = np.random.random(3) * self.system.box_l
+            ids = []
+            for m in range(n_monomers):
+                step = np.random.normal(0, 0.5, 3)
+                step[c % 3] += 1.
+                pos = pos + 0.9 * step / np.linalg.norm(step)
+                ids.append(c * n_monomers + m)
+                self.system.part.add(id=ids[-1], pos=pos)
+            for i in range(1, n_monomers):
+                self.system.part[ids[i]].add_bond((harmonic, ids[i - 1]))
+            for i in range(1, n_monomers - 1):
+                self.system.part[ids[i]].add_bond(
+                    (angle, ids[i - 1], ids[i + 1]))
+            for i in range(1, n_monomers - 2):
+                self.system.part[ids[i]].add_bond(
+                    (dihedral, ids[i - 1], ids[i + 1], ids[i + 2]))
+
+    def tearDown(self):
+        self.system.part.clear()
+        self.system.cell_system.set_domain_decomposition()
+
+    def forces(self, **kwargs):
+        self.system.cell_system.set_domain_decomposition(**kwargs)
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        return np.copy(self.system.part[:].f)
+
+    def test_bonds_across_boundary(self):
+        for verlet in [True, False]:
+            f_serial = self.forces(use_verlet_lists=verlet)
+            atol = 1e-10 * np.max(np.abs(f_serial))
+
+            f = self.forces(use_verlet_lists=verlet, use_threads=True,
+                            deterministic_threads=True)
+            np.testing.assert_array_equal(f, f_serial)
+
+            f = self.forces(use_verlet_lists=verlet, use_threads=True,
+                            deterministic_threads=False)
+            np.testing.assert_allclose(f, f_serial, rtol=1e-10, atol=atol)
+
+
+if __name__ == "__main__":
+    ut.main()
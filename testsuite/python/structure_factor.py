@@ -0,0 +1,86 @@
+#
+# Copyright (C) 2017-2018 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+import unittest as ut
+import unittest_decorators as utx
+import espressomd
+import numpy as np
+
+
+class StructureFactorTest(ut.TestCase):
+    s = espressomd.System(box_l=[1.0, 1.0, 1.0])
+    s.seed = s.cell_system.get_state()['n_nodes'] * [1234]
+    box_l = 10.
+    order = 5
+
+    @classmethod
+    def setUpClass(cls):
+        np.random.seed(42)
+        cls.s.box_l = 3 * [cls.box_l]
+        cls.s.part.add(pos=np.random.random((100, 3)) * cls.box_l,
+                       type=100 * [0])
+        cls.s.part.add(pos=np.random.random((50, 3)) * cls.box_l,
+                       type=50 * [1])
+
+    def reference(self, types):
+        pos = np.concatenate([self.s.part.select(type=t).pos for t in types])
+        sf = {}
+        r = range(-self.order, self.order + 1)
+        for n in np.array(np.meshgrid(r, r, r)).T.reshape(-1, 3):
+            n2 = np.dot(n, n)
+            if n[0] < 0 or not 1 <= n2 <= self.order**2:
+                continue
+            q = 2. * np.pi / self.box_l * n
+            s = np.abs(np.sum(np.exp(1j * np.dot(pos, q))))**2 / len(pos)
+            sf.setdefault(n2, []).append(s)
+        n2 = sorted(sf.keys())
+        return np.array([2. * np.pi / self.box_l * np.sqrt(n2),
+                         [np.mean(sf[k]) for k in n2]])
+
+    def test_direct(self):
+        for types in ([0], [1], [0, 1]):
+            sf = self.s.analysis.structure_factor(
+                sf_types=types, sf_order=self.order)
+            np.testing.assert_allclose(sf, self.reference(types), rtol=1e-8)
+
+    @utx.skipIfMissingFeatures("P3M")
+    def test_fft(self):
+        for types in ([0], [0, 1]):
+            sf_direct = self.s.analysis.structure_factor(
+                sf_types=types, sf_order=self.order)
+            sf_fft = self.s.analysis.structure_factor(
+                sf_types=types, sf_order=self.order, method="fft", mesh=32,
+                cao=5)
+            np.testing.assert_allclose(sf_fft, sf_direct, rtol=1e-2)
+
+        with self.assertRaises(Exception):
+            self.s.analysis.structure_factor(
+                sf_types=[0], sf_order=self.order, method="fft", mesh=8)
+
+        self.s.box_l = [self.box_l, self.box_l, 2. * self.box_l]
+        try:
+            with self.assertRaises(Exception):
+                self.s.analysis.structure_factor(
+                    sf_types=[0], sf_order=self.order, method="fft", mesh=32)
+        finally:
+            self.s.box_l = 3 * [self.box_l]
+
+
+if __name__ == "__main__":
+    ut.main()